@@ -0,0 +1,210 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+/* Writes and reads per journal_mode / synchronous / mmap_size profile, see browser_db_profiles.
+  * A scratch file with the history schema and 5000 rows is made per profile.
+  * Each write is one visit in its own transaction (update, or insert when the address is new),
+  * each read is a history page of 30 rows plus the top 8 by frecency.
+  *    db-profile-benchmark [scratch file path]
+  */
+
+extern "C" {
+#include "db-util.h"
+}
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define DB_PROFILE_BENCHMARK_PATH	"/var/tmp/db-profile-benchmark.db"
+#define DB_PROFILE_BENCHMARK_ROW_COUNT	5000
+#define DB_PROFILE_BENCHMARK_WRITE_COUNT	400
+#define DB_PROFILE_BENCHMARK_READ_COUNT	2000
+
+struct db_profile {
+	const char *journal_mode;
+	const char *synchronous;
+	const char *mmap_size;
+};
+
+static const db_profile db_profiles[] = {
+	{"persist", "full", "0"},
+	{"wal", "normal", "0"},
+	{"wal", "normal", "4194304"},
+	{"wal", "full", "0"},
+};
+
+static double _get_time(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static bool _execute(sqlite3 *db_descriptor, const std::string &query)
+{
+	char *error_message = NULL;
+	if (sqlite3_exec(db_descriptor, query.c_str(), NULL, NULL, &error_message) != SQLITE_OK) {
+		fprintf(stderr, "[%s] failed [%s]\n", query.c_str(), error_message);
+		sqlite3_free(error_message);
+		return false;
+	}
+
+	return true;
+}
+
+static void _remove_files(const std::string &path)
+{
+	unlink(path.c_str());
+	unlink((path + "-wal").c_str());
+	unlink((path + "-shm").c_str());
+	unlink((path + "-journal").c_str());
+}
+
+static bool _fill(sqlite3 *db_descriptor)
+{
+	if (!_execute(db_descriptor, "create table history(id INTEGER PRIMARY KEY AUTOINCREMENT, address, title,"
+					" counter INTEGER, visitdate DATETIME, favicon BLOB, favicon_length INTEGER,"
+					" favicon_w INTEGER, favicon_h INTEGER, frecency real)")
+	    || !_execute(db_descriptor, "create unique index idx_history_on_address on history(address)")
+	    || !_execute(db_descriptor, "create index idx_history_on_frecency on history(frecency desc)")
+	    || !_execute(db_descriptor, "create index idx_history_on_visitdate_id on history(visitdate desc, id desc)")
+	    || !_execute(db_descriptor, "begin"))
+		return false;
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	if (sqlite3_prepare_v2(db_descriptor, "insert into history (address, title, counter, visitdate, frecency)"
+				" values(?, 'title', 1, datetime('now', '-' || ? || ' minutes'), ?)", -1, &sqlite3_stmt, NULL) != SQLITE_OK)
+		return false;
+
+	for (int i = 0 ; i < DB_PROFILE_BENCHMARK_ROW_COUNT ; i++) {
+		char url[64];
+		snprintf(url, sizeof(url), "http://site%d.example.com/page", i);
+		sqlite3_bind_text(sqlite3_stmt, 1, url, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_int(sqlite3_stmt, 2, i);
+		sqlite3_bind_double(sqlite3_stmt, 3, rand() % 1000);
+		sqlite3_step(sqlite3_stmt);
+		sqlite3_reset(sqlite3_stmt);
+	}
+	sqlite3_finalize(sqlite3_stmt);
+
+	return _execute(db_descriptor, "commit");
+}
+
+static double _write(sqlite3 *db_descriptor)
+{
+	sqlite3_stmt *update_stmt = NULL;
+	sqlite3_stmt *insert_stmt = NULL;
+	sqlite3_prepare_v2(db_descriptor, "update history set counter=counter+1, title='t', visitdate=DATETIME('now'),"
+				" frecency=frecency+1 where address=?", -1, &update_stmt, NULL);
+	sqlite3_prepare_v2(db_descriptor, "insert into history (address, title, counter, visitdate, frecency)"
+				" values (?, 't', 1, DATETIME('now'), 1)", -1, &insert_stmt, NULL);
+
+	double start = _get_time();
+	for (int i = 0 ; i < DB_PROFILE_BENCHMARK_WRITE_COUNT ; i++) {
+		/* Every other visit is to a new address. */
+		char url[64];
+		snprintf(url, sizeof(url), "http://site%d.example.com/page", (i % 2) ? i : 100000 + i);
+
+		_execute(db_descriptor, "begin immediate");
+		sqlite3_bind_text(update_stmt, 1, url, -1, SQLITE_TRANSIENT);
+		sqlite3_step(update_stmt);
+		sqlite3_reset(update_stmt);
+		if (!sqlite3_changes(db_descriptor)) {
+			sqlite3_bind_text(insert_stmt, 1, url, -1, SQLITE_TRANSIENT);
+			sqlite3_step(insert_stmt);
+			sqlite3_reset(insert_stmt);
+		}
+		_execute(db_descriptor, "commit");
+	}
+	double duration = _get_time() - start;
+
+	sqlite3_finalize(update_stmt);
+	sqlite3_finalize(insert_stmt);
+
+	return duration;
+}
+
+static double _read(sqlite3 *db_descriptor)
+{
+	sqlite3_stmt *page_stmt = NULL;
+	sqlite3_stmt *top_stmt = NULL;
+	sqlite3_prepare_v2(db_descriptor, "select id, address, title, visitdate from history"
+				" where (visitdate < ? or (visitdate = ? and id < ?)) order by visitdate desc, id desc limit 30",
+				-1, &page_stmt, NULL);
+	sqlite3_prepare_v2(db_descriptor, "select address, title from history order by frecency desc limit 8",
+				-1, &top_stmt, NULL);
+
+	double start = _get_time();
+	for (int i = 0 ; i < DB_PROFILE_BENCHMARK_READ_COUNT ; i++) {
+		sqlite3_bind_text(page_stmt, 1, "9999", -1, NULL);
+		sqlite3_bind_text(page_stmt, 2, "9999", -1, NULL);
+		sqlite3_bind_int(page_stmt, 3, 1 << 30);
+		while (sqlite3_step(page_stmt) == SQLITE_ROW)
+			;
+		sqlite3_reset(page_stmt);
+		while (sqlite3_step(top_stmt) == SQLITE_ROW)
+			;
+		sqlite3_reset(top_stmt);
+	}
+	double duration = _get_time() - start;
+
+	sqlite3_finalize(page_stmt);
+	sqlite3_finalize(top_stmt);
+
+	return duration;
+}
+
+int main(int argc, char **argv)
+{
+	std::string path = (argc > 1) ? argv[1] : DB_PROFILE_BENCHMARK_PATH;
+
+	for (unsigned int i = 0 ; i < sizeof(db_profiles) / sizeof(db_profiles[0]) ; i++) {
+		const db_profile &profile = db_profiles[i];
+		_remove_files(path);
+
+		sqlite3 *db_descriptor = NULL;
+		if (sqlite3_open(path.c_str(), &db_descriptor) != SQLITE_OK) {
+			fprintf(stderr, "can not open %s\n", path.c_str());
+			return 1;
+		}
+
+		if (!_execute(db_descriptor, std::string("pragma journal_mode=") + profile.journal_mode)
+		    || !_execute(db_descriptor, std::string("pragma synchronous=") + profile.synchronous)
+		    || !_execute(db_descriptor, std::string("pragma mmap_size=") + profile.mmap_size)
+		    || !_fill(db_descriptor)) {
+			sqlite3_close(db_descriptor);
+			_remove_files(path);
+			return 1;
+		}
+
+		double write_time = _write(db_descriptor);
+		double read_time = _read(db_descriptor);
+		printf("%-8s %-7s mmap=%-8s writes/s %8.0f  read (page + top 8) %6.1f us\n",
+			profile.journal_mode, profile.synchronous, profile.mmap_size,
+			DB_PROFILE_BENCHMARK_WRITE_COUNT / write_time, read_time / DB_PROFILE_BENCHMARK_READ_COUNT * 1000000);
+
+		sqlite3_close(db_descriptor);
+	}
+
+	_remove_files(path);
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+/* Visits per second written by Browser_History_DB::flush_visits() into a full history table,
+  * with one flush per visit as on a load finished followed by a pause of the browser.
+  * "new" visits insert an address and evict the oldest one, "revisits" update a row in place.
+  * The history file is copied aside first and put back at the end,
+  * run it while the browser is not running :
+  *    history-write-benchmark [visit count]
+  */
+
+#include "browser-history-db.h"
+
+#include <Ecore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define HISTORY_WRITE_BENCHMARK_BACKUP_PATH	BROWSER_HISTORY_DB_PATH".benchmark"
+#define HISTORY_WRITE_BENCHMARK_VISIT_COUNT	3000
+
+static double _get_time(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static Eina_Bool _copy_file(const char *from, const char *to)
+{
+	FILE *source = fopen(from, "rb");
+	if (!source)
+		return EINA_FALSE;
+
+	FILE *target = fopen(to, "wb");
+	if (!target) {
+		fclose(source);
+		return EINA_FALSE;
+	}
+
+	char buffer[4096];
+	size_t length = 0;
+	Eina_Bool result = EINA_TRUE;
+	while ((length = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+		if (fwrite(buffer, 1, length, target) != length) {
+			result = EINA_FALSE;
+			break;
+		}
+	}
+
+	fclose(source);
+	if (fclose(target))
+		result = EINA_FALSE;
+
+	return result;
+}
+
+static void _remove_wal_files(void)
+{
+	unlink(BROWSER_HISTORY_DB_PATH"-wal");
+	unlink(BROWSER_HISTORY_DB_PATH"-shm");
+	unlink(BROWSER_HISTORY_DB_PATH"-journal");
+}
+
+int main(int argc, char **argv)
+{
+	int visit_count = HISTORY_WRITE_BENCHMARK_VISIT_COUNT;
+	if (argc > 1)
+		visit_count = atoi(argv[1]);
+	if (visit_count <= 0) {
+		fprintf(stderr, "usage: %s [visit count]\n", argv[0]);
+		return 1;
+	}
+
+	if (!_copy_file(BROWSER_HISTORY_DB_PATH, HISTORY_WRITE_BENCHMARK_BACKUP_PATH)) {
+		fprintf(stderr, "can not copy %s\n", BROWSER_HISTORY_DB_PATH);
+		return 1;
+	}
+
+	ecore_init();
+
+	Browser_History_DB history_db;
+	char url[64];
+
+	/* Fill the table up to BROWSER_HISTORY_COUNT_LIMIT, so that every new address evicts one. */
+	for (int i = 0 ; i < BROWSER_HISTORY_COUNT_LIMIT ; i++) {
+		snprintf(url, sizeof(url), "http://seed.example.com/%d", i);
+		history_db.save_history(url, "seed", NULL);
+	}
+	Browser_History_DB::flush_visits();
+
+	double start = _get_time();
+	for (int i = 0 ; i < visit_count ; i++) {
+		snprintf(url, sizeof(url), "http://new.example.com/%d", i);
+		history_db.save_history(url, "new", NULL);
+		Browser_History_DB::flush_visits();
+	}
+	double new_visit_time = _get_time() - start;
+
+	start = _get_time();
+	for (int i = 0 ; i < visit_count ; i++) {
+		snprintf(url, sizeof(url), "http://new.example.com/%d", visit_count - 1 - (i % 500));
+		history_db.save_history(url, "again", NULL);
+		Browser_History_DB::flush_visits();
+	}
+	double revisit_time = _get_time() - start;
+
+	printf("new visits/s %.0f\n", visit_count / new_visit_time);
+	printf("revisits/s   %.0f\n", visit_count / revisit_time);
+
+	Browser_DB_Executor::destroy_instance();
+	Browser_DB_Connection::close_all_connections();
+	ecore_shutdown();
+
+	_remove_wal_files();
+	if (!_copy_file(HISTORY_WRITE_BENCHMARK_BACKUP_PATH, BROWSER_HISTORY_DB_PATH)) {
+		fprintf(stderr, "can not restore %s from %s\n", BROWSER_HISTORY_DB_PATH, HISTORY_WRITE_BENCHMARK_BACKUP_PATH);
+		return 1;
+	}
+	unlink(HISTORY_WRITE_BENCHMARK_BACKUP_PATH);
+
+	return 0;
+}
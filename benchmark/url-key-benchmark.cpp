@@ -0,0 +1,140 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+/* Time per address of br_url_canonicalize() and br_url_key() over a corpus of addresses,
+  * and the number of key collisions, that is distinct canonical forms sharing a key.
+  * The corpus has one address per line, e.g. exported from a history or a crawl.
+  * Without a file the addresses are generated, with the variants which have one key :
+  *    url-key-benchmark [corpus file]
+  */
+
+#include "browser-url-key.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define URL_KEY_BENCHMARK_GENERATED_COUNT	200000
+#define URL_KEY_BENCHMARK_ROUND_COUNT	5
+
+static double _get_time(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static Eina_Bool _read_corpus(const char *path, std::vector<std::string> &urls)
+{
+	FILE *file = fopen(path, "r");
+	if (!file)
+		return EINA_FALSE;
+
+	char line[4096];
+	while (fgets(line, sizeof(line), file)) {
+		size_t length = strcspn(line, "\r\n");
+		if (length > 0)
+			urls.push_back(std::string(line, length));
+	}
+
+	fclose(file);
+	return EINA_TRUE;
+}
+
+static void _generate_corpus(std::vector<std::string> &urls)
+{
+	static const char *formats[] = {
+		"http://www.site%d.example.com/",
+		"https://WWW.Site%d.example.com",
+		"www.site%d.example.com/#top",
+		"http://site%d.example.com:80/news/article.html?id=42",
+		"https://m.site%d.example.com/search?q=a%%2fb&page=2#results",
+	};
+	const int format_count = sizeof(formats) / sizeof(formats[0]);
+
+	char url[128];
+	for (int i = 0 ; i < URL_KEY_BENCHMARK_GENERATED_COUNT ; i++) {
+		snprintf(url, sizeof(url), formats[i % format_count], i / format_count);
+		urls.push_back(url);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<std::string> urls;
+	if (argc > 1) {
+		if (!_read_corpus(argv[1], urls)) {
+			fprintf(stderr, "can not read %s\n", argv[1]);
+			return 1;
+		}
+	} else
+		_generate_corpus(urls);
+
+	if (urls.empty()) {
+		fprintf(stderr, "usage: %s [corpus file]\n", argv[0]);
+		return 1;
+	}
+
+	/* The sum is printed so that the calls are not optimized away. */
+	sqlite3_int64 key_sum = 0;
+	double start = _get_time();
+	for (int round = 0 ; round < URL_KEY_BENCHMARK_ROUND_COUNT ; round++) {
+		for (size_t i = 0 ; i < urls.size() ; i++)
+			key_sum += br_url_key(urls[i].c_str());
+	}
+	double key_time = _get_time() - start;
+
+	char canonical[4096];
+	size_t length_sum = 0;
+	start = _get_time();
+	for (int round = 0 ; round < URL_KEY_BENCHMARK_ROUND_COUNT ; round++) {
+		for (size_t i = 0 ; i < urls.size() ; i++)
+			length_sum += br_url_canonicalize(urls[i].c_str(), canonical, sizeof(canonical));
+	}
+	double canonicalize_time = _get_time() - start;
+
+	std::set<std::string> canonical_forms;
+	std::map<sqlite3_int64, std::string> keys;
+	int collision_count = 0;
+	for (size_t i = 0 ; i < urls.size() ; i++) {
+		br_url_canonicalize(urls[i].c_str(), canonical, sizeof(canonical));
+		if (!canonical_forms.insert(canonical).second)
+			continue;
+
+		std::pair<std::map<sqlite3_int64, std::string>::iterator, bool> inserted
+			= keys.insert(std::make_pair(br_url_key(urls[i].c_str()), std::string(canonical)));
+		if (!inserted.second) {
+			collision_count++;
+			printf("collision \"%s\" \"%s\"\n", inserted.first->second.c_str(), canonical);
+		}
+	}
+
+	double call_count = (double)urls.size() * URL_KEY_BENCHMARK_ROUND_COUNT;
+	printf("addresses            %lu\n", (unsigned long)urls.size());
+	printf("canonical forms      %lu\n", (unsigned long)canonical_forms.size());
+	printf("distinct keys        %lu\n", (unsigned long)keys.size());
+	printf("collisions           %d\n", collision_count);
+	printf("key ns/address       %.0f (%llx)\n", key_time * 1000000000.0 / call_count, (unsigned long long)key_sum);
+	printf("canonical ns/address %.0f (%lu)\n", canonicalize_time * 1000000000.0 / call_count, (unsigned long)length_sum);
+
+	return 0;
+}
@@ -343,63 +343,20 @@ Eina_Bool Browser_Add_To_Bookmark_View::_modify_bookmark_item(const char *title,
 	if (!ret)
 		return EINA_FALSE;
 
-	Browser_Bookmark_DB::bookmark_item *item = NULL;
-
-	Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
-	Elm_Object_Item *bookmark_edit_it = bookmark_view->m_current_genlist_item_to_edit;
-	item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(bookmark_edit_it);
-
-	item->title = title;
-	item->url = url;
-	elm_object_item_data_set(bookmark_edit_it, item);
-
-	if (m_current_folder_id != m_folder_id_to_save) {
-		if (m_folder_id_to_save == BROWSER_BOOKMARK_MAIN_FOLDER_ID) {
-			/* If the bookmark item in sub folder is moved to main folder,
-			  * remove it from sub folder and append it to main folder. */
-			for(int i = 0 ; i < bookmark_view->m_sub_folder_list.size() ; i++) {
-				if (bookmark_view->m_sub_folder_list[i] == item) {
-					bookmark_view->m_sub_folder_list.erase(bookmark_view->m_sub_folder_list.begin() + i);
-					break;
-				}
-			}
-
-			/* If the bookmark is empty page, destroy the empty layout to show the bookmark list. */
-			if (bookmark_view->m_main_folder_list.size() == 0)
-				bookmark_view->_show_empty_content_layout(EINA_TRUE);
-			else
-				bookmark_view->_show_empty_content_layout(EINA_FALSE);
-		} else if (m_current_folder_id == BROWSER_BOOKMARK_MAIN_FOLDER_ID) {
-			/* Move one bookmark item from main folder to sub folder. */
-			for(int i = 0 ; i < bookmark_view->m_main_folder_list.size() ; i++) {
-				if (bookmark_view->m_main_folder_list[i] == item) {
-					delete bookmark_view->m_main_folder_list[i];
-					bookmark_view->m_main_folder_list.erase(bookmark_view->m_main_folder_list.begin() + i);
-					break;
-				}
-			}
-		} else {
-			/* If the bookmark item in sub folder is moved to another sub folder,
-			  * just remove the item from the genlist and delete the malloced item.*/
-			for(int i = 0 ; i < bookmark_view->m_sub_folder_list.size() ; i++) {
-				if (bookmark_view->m_sub_folder_list[i] == item) {
-					delete item;
-					bookmark_view->m_sub_folder_list.erase(bookmark_view->m_sub_folder_list.begin() + i);
-					break;
-				}
-			}
-		}
-
-		elm_object_item_del(bookmark_edit_it);
-	}
-
+	/* The bookmark view reloads the changed folders. */
 	return EINA_TRUE;
 }
 
 Eina_Bool Browser_Add_To_Bookmark_View::_save_bookmark_item(const char *title, const char *url)
 {
 	BROWSER_LOGD("[%s]", __func__);
-	return m_data_manager->get_bookmark_db()->save_bookmark(m_folder_id_to_save, title, url);
+	if (!m_data_manager->get_bookmark_db()->save_bookmark(m_folder_id_to_save, title, url))
+		return EINA_FALSE;
+
+	if (!m_data_manager->get_browser_view()->save_bookmark_favicon(url))
+		BROWSER_LOGD("no favicon for [%s]", url);
+
+	return EINA_TRUE;
 }
 
 void Browser_Add_To_Bookmark_View::__done_button_clicked_cb(void *data, Evas_Object *obj, void *eventInfo)
@@ -472,12 +429,8 @@ void Browser_Add_To_Bookmark_View::_done_button_clicked(const char *title, const
 #endif
 						m_data_manager->get_browser_view()->show_notify_popup(BR_STRING_SAVED, 3);
 				} else {
-					int added_bookmark_id = -1;
-					bookmark_db->get_bookmark_id_by_title_url(m_folder_id_to_save, title,
-								url, &added_bookmark_id);
-					BROWSER_LOGD("added_bookmark_id=%d", added_bookmark_id);
-						/* History view -> slide one item -> add to bookmark, then done. */
-					m_data_manager->get_bookmark_view()->return_to_bookmark_view(added_bookmark_id);
+					/* History view -> slide one item -> add to bookmark, then done. */
+					m_data_manager->get_bookmark_view()->return_to_bookmark_view();
 
 					m_data_manager->get_browser_view()->show_notify_popup(BR_STRING_SAVED, 3, EINA_TRUE);
 				}
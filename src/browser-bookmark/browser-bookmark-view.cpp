@@ -61,6 +61,11 @@ Browser_Bookmark_View::Browser_Bookmark_View(void)
 	,m_navi_it(NULL)
 	,m_delete_confirm_popup(NULL)
 	,m_rename_edit_field(NULL)
+	,m_main_folder_job_id(0)
+	,m_sub_folder_job_id(0)
+	,m_is_main_folder_changed(EINA_FALSE)
+	,m_is_sub_folder_changed(EINA_FALSE)
+	,m_reload_folder_idler(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 	m_current_bookmark_navigationbar_title = "";
@@ -71,6 +76,18 @@ Browser_Bookmark_View::~Browser_Bookmark_View(void)
 	BROWSER_LOGD("[%s]", __func__);
 	hide_notify_popup_layout(m_sub_main_layout);
 
+	if (m_data_manager->get_bookmark_db())
+		m_data_manager->get_bookmark_db()->remove_bookmark_changed_cb(__bookmark_changed_cb, this);
+	if (m_reload_folder_idler)
+		ecore_idler_del(m_reload_folder_idler);
+
+	if (Browser_DB_Executor::has_instance()) {
+		if (m_main_folder_job_id)
+			Browser_DB_Executor::get_instance()->cancel(m_main_folder_job_id);
+		if (m_sub_folder_job_id)
+			Browser_DB_Executor::get_instance()->cancel(m_sub_folder_job_id);
+	}
+
 	for(int i = 0 ; i < m_sub_folder_list.size() ; i++ ) {
 		if (m_sub_folder_list[i]) {
 			delete m_sub_folder_list[i];
@@ -104,87 +121,17 @@ Eina_Bool Browser_Bookmark_View::init(void)
 		return EINA_FALSE;
 	}
 
-	return _create_main_layout();
-}
-
-Eina_Bool Browser_Bookmark_View::append_bookmark_item(const char *title, const char *url)
-{
-	if (!url || !title) {
-		BROWSER_LOGE("url or title is null");
-		return EINA_FALSE;
-	}
-
-	if (!m_data_manager->get_bookmark_db()->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID, title, url)) {
-		BROWSER_LOGE("save_bookmark failed");
+	if (!_create_main_layout())
 		return EINA_FALSE;
-	}
 
-	Browser_Bookmark_DB::bookmark_item *item = new(nothrow) Browser_Bookmark_DB::bookmark_item;
-	if (!item) {
-		BROWSER_LOGE("new(nothrow) Browser_Bookmark_DB::bookmark_item failed");
-		return EINA_FALSE;
-	}
-
-	int bookmark_id = -1;
-	m_data_manager->get_bookmark_db()->get_bookmark_id_by_title_url(BROWSER_BOOKMARK_MAIN_FOLDER_ID, title,
-				url, &bookmark_id);
-
-	item->parent = BROWSER_BOOKMARK_MAIN_FOLDER_ID;
-	item->user_data_1 = (void *)this;
-	item->url = std::string(url);
-	item->title = std::string(title);
-	item->is_folder = EINA_FALSE;
-	item->id = bookmark_id;
-	item->user_data_2 = (void *)elm_genlist_item_append(m_main_folder_genlist, &m_bookmark_genlist_item_class,
-							item, NULL, ELM_GENLIST_ITEM_NONE,
-							__bookmark_item_clicked_cb, this);
-
-	m_main_folder_list.push_back(item);
-
-	_show_empty_content_layout(EINA_FALSE);
+	m_data_manager->get_bookmark_db()->add_bookmark_changed_cb(__bookmark_changed_cb, this);
 
 	return EINA_TRUE;
 }
 
-void Browser_Bookmark_View::delete_bookmark_item(int bookmark_id)
+void Browser_Bookmark_View::return_to_bookmark_view(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
-	int ret = EINA_TRUE;
-
-	ret = m_data_manager->get_bookmark_db()->delete_bookmark(bookmark_id);
-	if (!ret) {
-		BROWSER_LOGE("bookmark_db->delete_bookmark failed");
-		return;
-	}
-
-	Elm_Object_Item *it = elm_genlist_first_item_get(m_main_folder_genlist);
-	while (it) {
-		Browser_Bookmark_DB::bookmark_item *item = NULL;
-		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-		if (item->id == bookmark_id) {
-			elm_object_item_del(it);
-			break;
-		}
-
-		it = elm_genlist_item_next_get(it);
-	}
-
-	for(int index = 0 ; index <  m_main_folder_list.size() ; index++) {
-		if (m_main_folder_list[index]->id == bookmark_id) {
-			delete m_main_folder_list[index];
-			m_main_folder_list.erase(m_main_folder_list.begin() + index);
-			break;
-		}
-	}
-
-	if (m_main_folder_list.size() == 0) {
-		_show_empty_content_layout(EINA_TRUE);
-	}
-}
-
-void Browser_Bookmark_View::return_to_bookmark_view(int added_bookmark_id)
-{
-	BROWSER_LOGD("added_bookmark_id = %d", added_bookmark_id);
 	if (m_view_mode == BOOKMARK_VIEW) {
 		/* In case that bookmark view -> Edit bookmark item, then return to bookmark view. */
 		if (elm_genlist_decorate_mode_get(_get_current_folder_genlist())) {
@@ -226,76 +173,6 @@ void Browser_Bookmark_View::return_to_bookmark_view(int added_bookmark_id)
 			m_data_manager->get_history_layout()->m_current_sweep_item = NULL;
 		}
 	}
-
-	/* boomark view -> history -> add to bookmark by slide button, then done. */
-	if (added_bookmark_id != -1) {
-		Browser_Bookmark_DB::bookmark_item *item = m_data_manager->get_bookmark_db()->get_bookmark_item_by_id(added_bookmark_id);
-		if (!item) {
-			BROWSER_LOGE("get_bookmark_item_by_id failed");
-			return;
-		}
-
-		Elm_Object_Item *it = elm_genlist_first_item_get(_get_current_folder_genlist());
-		while (it) {
-			Browser_Bookmark_DB::bookmark_item *exist_item = NULL;
-			exist_item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-			if (exist_item->id == added_bookmark_id) {
-				exist_item->url = item->url;
-				exist_item->title = item->title;
-				exist_item->parent = item->parent;
-				elm_genlist_item_update(it);
-				return;
-			}
-			it = elm_genlist_item_next_get(it);
-		}
-
-		if (m_current_folder_id == item->parent) {
-			/* If the saved bookmark item is in the current folder, just add it to current folder. */
-			Evas_Object *genlist = NULL;
-			if (item->parent == BROWSER_BOOKMARK_MAIN_FOLDER_ID)
-				genlist = m_main_folder_genlist;
-			else
-				genlist = m_sub_folder_genlist;
-
-			item->user_data_1 = (void *)this;
-			if (item->is_folder) {
-				item->user_data_2 = (void *)elm_genlist_item_append(genlist, &m_folder_genlist_item_class,
-									item, NULL, ELM_GENLIST_ITEM_NONE,
-									__bookmark_item_clicked_cb, this);
-
-			} else {
-				item->user_data_2 = (void *)elm_genlist_item_append(genlist, &m_bookmark_genlist_item_class,
-									item, NULL, ELM_GENLIST_ITEM_NONE,
-									__bookmark_item_clicked_cb, this);
-			}
-
-			if (item->parent == BROWSER_BOOKMARK_MAIN_FOLDER_ID)
-				m_main_folder_list.push_back(item);
-			else
-				m_sub_folder_list.push_back(item);
-		} else if (m_current_folder_id != BROWSER_BOOKMARK_MAIN_FOLDER_ID
-			   && item->parent == BROWSER_BOOKMARK_MAIN_FOLDER_ID){
-			/* If the current folder is sub folder but the saved folder is main folder,
-			  * add the saved bookmark item to main folder. */
-			item->user_data_1 = (void *)this;
-			if (item->is_folder) {
-			item->user_data_2 = (void *)elm_genlist_item_append(m_main_folder_genlist, &m_folder_genlist_item_class,
-									item, NULL, ELM_GENLIST_ITEM_NONE,
-									__bookmark_item_clicked_cb, this);
-			} else {
-			item->user_data_2 = (void *)elm_genlist_item_append(m_main_folder_genlist, &m_bookmark_genlist_item_class,
-									item, NULL, ELM_GENLIST_ITEM_NONE,
-									__bookmark_item_clicked_cb, this);
-			}
-			m_main_folder_list.push_back(item);
-		}
-
-		/* If the bookmark is empty page, destroy the empty layout to show the bookmark list. */
-		if (_get_current_folder_item_list().size() == 0)
-			_show_empty_content_layout(EINA_TRUE);
-		else
-			_show_empty_content_layout(EINA_FALSE);
-	}
 }
 
 void Browser_Bookmark_View::__back_button_clicked_cb(void *data, Evas_Object *obj, void *event_info)
@@ -352,6 +229,21 @@ void Browser_Bookmark_View::__edit_controlbar_item_clicked_cb(void *data, Evas_O
 		elm_object_focus_set(bookmark_view->m_rename_edit_field, EINA_FALSE);
 }
 
+void Browser_Bookmark_View::__clear_history_controlbar_item_clicked_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)data;
+	Browser_History_Layout *history_layout = m_data_manager->get_history_layout();
+	if (!history_layout)
+		return;
+
+	if (!history_layout->_show_clear_history_popup(bookmark_view->m_bottom_control_bar))
+		BROWSER_LOGE("_show_clear_history_popup failed");
+}
+
 void Browser_Bookmark_View::__delete_controlbar_item_clicked_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	if (!data)
@@ -405,63 +297,48 @@ void Browser_Bookmark_View::_delete_selected_bookmark(void)
 	BROWSER_LOGD("[%s]", __func__);
 	Browser_Bookmark_DB *bookmark_db = m_data_manager->get_bookmark_db();
 	Eina_List *delete_item_list = NULL;
+	std::vector<int> delete_id_list;
 	Elm_Object_Item *it = elm_genlist_first_item_get(_get_current_folder_genlist());
 	int remain_count = 0;
 	while(it) {
 		Browser_Bookmark_DB::bookmark_item *item = NULL;
 		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-		if (item->is_delete)
+		if (item->is_delete) {
 			delete_item_list = eina_list_append(delete_item_list, it);
-		else
+			delete_id_list.push_back(item->id);
+		} else
 			remain_count++;
 		it = elm_genlist_item_next_get(it);
 	}
 
-	int count = eina_list_count(delete_item_list);
+	/* All the selected items, folders with their contents, are deleted from db in one transaction. */
+	int deleted_count = 0;
+	if (!bookmark_db->delete_bookmarks(delete_id_list, &deleted_count)) {
+		BROWSER_LOGE("bookmark_db->delete_bookmarks failed");
+		eina_list_free(delete_item_list);
+		return;
+	}
+	BROWSER_LOGD("%d items are deleted", deleted_count);
 
-	if (count >= BROWSER_BOOKMARK_PROCESS_BLOCK_COUNT) {
-		/* If delete more than 100 items, show the processing popup. */
-		_show_delete_processing_popup();
-	} else {
-		for (int i = 0; i < count; i++) {
-			it = (Elm_Object_Item *)eina_list_data_get(delete_item_list);
-			Browser_Bookmark_DB::bookmark_item *item = NULL;
-			Eina_Bool ret = EINA_TRUE;
-			item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-			if (item->is_folder) {
-				int folder_id = 0;
-				ret = bookmark_db->get_folder_id(m_current_folder_id, item->title.c_str(), &folder_id);
-				if (!ret) {
-					BROWSER_LOGE("bookmark_db->get_folder_id failed");
-					return;
-				}
-				ret = bookmark_db->delete_folder(folder_id);
-				if (!ret) {
-					BROWSER_LOGE("bookmark_db->delete_folder failed");
-					return;
-				}
-			} else {
-				ret = bookmark_db->delete_bookmark(item->id);
-				if (!ret) {
-					BROWSER_LOGE("bookmark_db->delete_bookmark failed");
-					return;
-				}
-			}
-			delete_item_list = eina_list_next(delete_item_list);
+	Eina_List *list = NULL;
+	void *list_data = NULL;
+	EINA_LIST_FOREACH(delete_item_list, list, list_data) {
+		it = (Elm_Object_Item *)list_data;
+		Browser_Bookmark_DB::bookmark_item *item = NULL;
+		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
 
-			_delete_bookmark_item_from_folder_list(item);
+		_delete_bookmark_item_from_folder_list(item);
 
-			elm_object_item_del(it);
-		}
-		eina_list_free(delete_item_list);
+		elm_object_item_del(it);
+	}
+	eina_list_free(delete_item_list);
 
-		elm_check_state_set(m_edit_mode_select_all_check_button, EINA_FALSE);
+	elm_check_state_set(m_edit_mode_select_all_check_button, EINA_FALSE);
 
-		if (remain_count == 0)
-			_show_empty_content_layout(EINA_TRUE);
+	if (remain_count == 0)
+		_show_empty_content_layout(EINA_TRUE);
 
-		show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
-	}
+	show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
 }
 
 void Browser_Bookmark_View::__edit_mode_item_check_changed_cb(void *data, Evas_Object *obj, void *event_info)
@@ -493,149 +370,6 @@ void Browser_Bookmark_View::__edit_mode_item_check_changed_cb(void *data, Evas_O
 	bookmark_view->_show_selection_info();
 }
 
-void Browser_Bookmark_View::_show_delete_processing_popup(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_processing_popup)
-		evas_object_del(m_processing_popup);
-
-	m_processing_popup = elm_popup_add(m_main_layout);
-	if (!m_processing_popup) {
-		BROWSER_LOGE("elm_popup_add failed");
-		return;
-	}
-
-	if (m_processing_popup_layout)
-		evas_object_del(m_processing_popup_layout);
-	m_processing_popup_layout = elm_layout_add(m_processing_popup);
-	if (!m_processing_popup_layout) {
-		BROWSER_LOGE("elm_layout_add failed");
-		return;
-	}
-	if (!elm_layout_file_set(m_processing_popup_layout, BROWSER_EDJE_DIR"/browser-bookmark-view.edj",
-							"browser/popup_center_progressview")) {
-		BROWSER_LOGE("elm_layout_file_set failed");
-		return;
-	}
-	evas_object_size_hint_weight_set(m_processing_popup_layout, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-
-	m_processing_progress_bar = elm_progressbar_add(m_processing_popup);
-	elm_object_style_set(m_processing_progress_bar, "list_progress");
-	elm_progressbar_horizontal_set(m_processing_progress_bar, EINA_TRUE);
-	evas_object_size_hint_align_set(m_processing_progress_bar, EVAS_HINT_FILL, EVAS_HINT_FILL);
-	evas_object_size_hint_weight_set(m_processing_progress_bar, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-	elm_progressbar_value_set(m_processing_progress_bar, 0.0);
-
-	if (m_processing_popup_timer)
-		ecore_timer_del(m_processing_popup_timer);
-
-	m_processed_count = 0;
-	m_processed_it = elm_genlist_last_item_get(_get_current_folder_genlist());
-
-	Elm_Object_Item *it = elm_genlist_first_item_get(_get_current_folder_genlist());
-	m_total_item_count = 0;
-	while(it) {
-		Browser_Bookmark_DB::bookmark_item *item = NULL;
-		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-		if (item) {
-			if(item->is_editable && item->is_delete)
-				m_total_item_count++;
-		}
-		it = elm_genlist_item_next_get(it);
-	}
-
-	m_processing_popup_timer = ecore_timer_add(0.1, __delete_processing_popup_timer_cb, this);
-	evas_object_show(m_processing_progress_bar);
-
-	elm_object_part_content_set(m_processing_popup_layout, "elm.swallow.content", m_processing_progress_bar);
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.title", BR_STRING_PROCESSING);
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.text.left", "");
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.text.right", "");
-
-	elm_object_content_set(m_processing_popup, m_processing_popup_layout);
-
-	Evas_Object *cancel_button = elm_button_add(m_processing_popup);
-	elm_object_text_set(cancel_button, BR_STRING_CANCEL);
-	elm_object_part_content_set(m_processing_popup, "button1", cancel_button);
-	evas_object_smart_callback_add(cancel_button, "clicked", __delete_processing_popup_response_cb, this);
-
-	evas_object_show(m_processing_popup);
-}
-
-Eina_Bool Browser_Bookmark_View::__delete_processing_popup_timer_cb(void *data)
-{
-	if (!data)
-		return ECORE_CALLBACK_CANCEL;
-
-	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)data;
-	Evas_Object* progress_bar = bookmark_view->m_processing_progress_bar;
-
-	Eina_Bool check_value = bookmark_view->m_select_all_check_value;
-
-	double value = elm_progressbar_value_get(progress_bar);
-	if (value >= 1.0) {
-		__delete_processing_popup_response_cb(bookmark_view, NULL, NULL);
-
-		bookmark_view->m_processing_popup_timer = NULL;
-		bookmark_view->show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
-
-		return ECORE_CALLBACK_CANCEL;
-	}
-
-	while(bookmark_view->m_processed_it) {
-		Browser_Bookmark_DB::bookmark_item *item = NULL;
-		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(bookmark_view->m_processed_it);
-		if (item) {
-			if(item->is_editable && item->is_delete) {
-				Browser_Bookmark_DB *bookmark_db = m_data_manager->get_bookmark_db();
-				int ret = EINA_TRUE;
-				if (item->is_folder) {
-					int folder_id = 0;
-					ret = bookmark_db->get_folder_id(bookmark_view->m_current_folder_id,
-										item->title.c_str(), &folder_id);
-					if (!ret) {
-						BROWSER_LOGE("bookmark_db->get_folder_id failed");
-						return ECORE_CALLBACK_CANCEL;
-					}
-					ret = bookmark_db->delete_folder(folder_id);
-					if (!ret) {
-						BROWSER_LOGE("bookmark_db->delete_folder failed");
-						return ECORE_CALLBACK_CANCEL;
-					}
-				} else {
-					ret = bookmark_db->delete_bookmark(item->id);
-					if (!ret) {
-						BROWSER_LOGE("bookmark_db->delete_bookmark failed");
-						return ECORE_CALLBACK_CANCEL;
-					}
-				}
-				bookmark_view->_delete_bookmark_item_from_folder_list(item);
-				bookmark_view->m_processed_count++;
-				Elm_Object_Item *it = bookmark_view->m_processed_it;
-				bookmark_view->m_processed_it = elm_genlist_item_prev_get(bookmark_view->m_processed_it);
-				elm_object_item_del(it);
-			} else
-				bookmark_view->m_processed_it = elm_genlist_item_prev_get(bookmark_view->m_processed_it);
-		} else
-			bookmark_view->m_processed_it = elm_genlist_item_prev_get(bookmark_view->m_processed_it);
-
-		if (bookmark_view->m_processed_count % 5 == 0)
-			break;
-	}
-
-	elm_progressbar_value_set(bookmark_view->m_processing_progress_bar,
-				(float)((float)bookmark_view->m_processed_count / (float)bookmark_view->m_total_item_count));
-
-	char progress_text[20] = {0, };
-	snprintf(progress_text, sizeof(progress_text) - 1, "%d / %d",
-			bookmark_view->m_processed_count, bookmark_view->m_total_item_count);
-
-	edje_object_part_text_set(elm_layout_edje_get(bookmark_view->m_processing_popup_layout),
-				"elm.text.right", progress_text);
-
-	return ECORE_CALLBACK_RENEW;
-}
-
 void Browser_Bookmark_View::_show_select_processing_popup(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -761,31 +495,6 @@ Eina_Bool Browser_Bookmark_View::__select_processing_popup_timer_cb(void *data)
 	return ECORE_CALLBACK_RENEW;
 }
 
-void Browser_Bookmark_View::__delete_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (!data)
-		return;
-
-	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)data;
-
-	bookmark_view->m_processing_progress_bar = NULL;
-	bookmark_view->m_processed_it = NULL;
-
-	evas_object_del(bookmark_view->m_processing_popup);
-
-	if (bookmark_view->m_processing_popup_timer) {
-		ecore_timer_del(bookmark_view->m_processing_popup_timer);
-		bookmark_view->m_processing_popup_timer = NULL;
-	}
-
-	bookmark_view->show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
-
-	vector<Browser_Bookmark_DB::bookmark_item *> item_list = bookmark_view->_get_current_folder_item_list();
-	if (item_list.size() == 0)
-		bookmark_view->_show_empty_content_layout(EINA_TRUE);
-}
-
 void Browser_Bookmark_View::__select_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -1031,6 +740,10 @@ void Browser_Bookmark_View::_set_edit_mode(Eina_Bool edit_mode)
 
 		if (!_set_controlbar_type(BOOKMARK_VIEW_DEFAULT))
 			BROWSER_LOGE("_set_controlbar_type(BOOKMARK_VIEW_DEFAULT) failed");
+
+		/* Reload the folders changed while in edit mode. */
+		if ((m_is_main_folder_changed || m_is_sub_folder_changed) && !m_reload_folder_idler)
+			m_reload_folder_idler = ecore_idler_add(__reload_folder_idler_cb, this);
 	}
 }
 
@@ -1076,6 +789,17 @@ void Browser_Bookmark_View::_set_view_mode(view_mode mode)
 		} else {
 			if (!_set_controlbar_type(BOOKMARK_VIEW_DEFAULT))
 				BROWSER_LOGE("_set_controlbar_type BOOKMARK_VIEW_DEFAULT failed");
+
+			/* The bookmarks may be changed from the history view. */
+			int job_id = (m_current_folder_id == BROWSER_BOOKMARK_MAIN_FOLDER_ID) ? m_main_folder_job_id
+												: m_sub_folder_job_id;
+			if (job_id) {
+				_show_empty_content_layout(EINA_FALSE);
+				elm_object_item_disabled_set(m_bookmark_edit_controlbar_item, EINA_TRUE);
+			} else if (_get_current_folder_item_list().size() == 0)
+				_show_empty_content_layout(EINA_TRUE);
+			else
+				_show_empty_content_layout(EINA_FALSE);
 		}
 	}
 }
@@ -1353,7 +1077,9 @@ Evas_Object *Browser_Bookmark_View::__genlist_icon_get_cb(void *data, Evas_Objec
 				return folder_icon;
 			} else {
 				Evas_Object *favicon = NULL;
-				favicon = m_data_manager->get_browser_view()->get_favicon(item->url.c_str());
+				std::map<int, Browser_Favicon>::iterator it = bookmark_view->m_favicons.find(item->id);
+				if (it != bookmark_view->m_favicons.end())
+					favicon = Browser_View::create_favicon(it->second, obj);
 				if (favicon)
 					return favicon;
 				else {
@@ -1489,6 +1215,18 @@ Eina_Bool Browser_Bookmark_View::_is_empty_folder(string folder_name)
 		return EINA_TRUE;
 }
 
+void Browser_Bookmark_View::_read_favicons(const vector<Browser_Bookmark_DB::bookmark_item *> &list)
+{
+	std::vector<int> bookmark_ids;
+	for (int i = 0 ; i < list.size() ; i++) {
+		if (!list[i]->is_folder)
+			bookmark_ids.push_back(list[i]->id);
+	}
+
+	if (!m_data_manager->get_bookmark_db()->get_favicons(bookmark_ids, m_favicons))
+		BROWSER_LOGE("get_favicons failed");
+}
+
 void Browser_Bookmark_View::__slide_edit_button_clicked_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -1629,11 +1367,13 @@ void Browser_Bookmark_View::_delete_bookmark_item_by_slide_button(Browser_Bookma
 			BROWSER_LOGE("bookmark_db->get_folder_id failed");
 			return;
 		}
-		ret = m_data_manager->get_bookmark_db()->delete_folder(folder_id);
+		int deleted_count = 0;
+		ret = m_data_manager->get_bookmark_db()->delete_folder(folder_id, &deleted_count);
 		if (!ret) {
 			BROWSER_LOGE("bookmark_db->delete_folder failed");
 			return;
 		}
+		BROWSER_LOGD("%d items are deleted with the folder", deleted_count);
 	} else {
 		ret = m_data_manager->get_bookmark_db()->delete_bookmark(item->id);
 		if (!ret) {
@@ -1718,57 +1458,52 @@ void Browser_Bookmark_View::_reorder_bookmark_item(int order_index, Eina_Bool is
 	Browser_Bookmark_DB *bookmark_db = m_data_manager->get_bookmark_db();
 
 	Elm_Object_Item *it = NULL;
-	Elm_Object_Item *next_it = NULL;
+	Elm_Object_Item *moved_it = NULL;
 	Browser_Bookmark_DB::bookmark_item *item = NULL;
-	Browser_Bookmark_DB::bookmark_item *next_item = NULL;
-	Eina_Bool ret = EINA_TRUE;
-	int index = order_index;
+	Browser_Bookmark_DB::bookmark_item *moved_item = NULL;
 
-	if (is_move_down) {
-		it = elm_genlist_first_item_get(_get_current_folder_genlist());
-		while(it) {
-			item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-			if (item->order_index > index) {
-				ret = bookmark_db->modify_bookmark_order_index(item->id, m_current_folder_id, index);
-				if (!ret)
-					BROWSER_LOGD("modify_bookmark_order_index failed");
-				int temp = item->order_index;
-				item->order_index = index;
-				index = temp;
-				elm_object_item_data_set(it, item);
-			} else if (item->order_index == order_index) {
-				ret = bookmark_db->modify_bookmark_order_index(item->id, m_current_folder_id, index);
-				item->order_index = index;
-				elm_object_item_data_set(it, item);
-				if (!ret)
-					BROWSER_LOGD("modify_bookmark_order_index failed");
-				break;
-			}
-			it = elm_genlist_item_next_get(it);
-		}
-	} else {
-		index = order_index;
-		it = elm_genlist_last_item_get(_get_current_folder_genlist());
-		while(it) {
-			item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
-			if (item->order_index < index) {
-				ret = bookmark_db->modify_bookmark_order_index(item->id, m_current_folder_id, index);
-				if (!ret)
-					BROWSER_LOGD("modify_bookmark_order_index failed");
-				int temp = item->order_index;
-				item->order_index = index;
-				index = temp;
-				elm_object_item_data_set(it, item);
-			} else if (item->order_index == order_index) {
-				ret = bookmark_db->modify_bookmark_order_index(item->id, m_current_folder_id, index);
-				item->order_index = index;
-				elm_object_item_data_set(it, item);
-				if (!ret)
-					BROWSER_LOGD("modify_bookmark_order_index failed");
-				break;
-			}
-			it = elm_genlist_item_prev_get(it);
+	/* The moved item still has its old order index. */
+	it = elm_genlist_first_item_get(_get_current_folder_genlist());
+	while(it) {
+		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
+		if (item->order_index == order_index) {
+			moved_it = it;
+			moved_item = item;
+			break;
 		}
+		it = elm_genlist_item_next_get(it);
+	}
+	if (!moved_it)
+		return;
+
+	/* It takes the order index of the last item it passed over. */
+	if (is_move_down)
+		it = elm_genlist_item_prev_get(moved_it);
+	else
+		it = elm_genlist_item_next_get(moved_it);
+	if (!it)
+		return;
+
+	item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
+	int new_index = item->order_index;
+
+	if (!bookmark_db->move_bookmark(moved_item->id, m_current_folder_id, new_index)) {
+		BROWSER_LOGE("move_bookmark failed");
+		return;
+	}
+
+	/* Apply the same shift as the db did. */
+	it = elm_genlist_first_item_get(_get_current_folder_genlist());
+	while(it) {
+		item = (Browser_Bookmark_DB::bookmark_item *)elm_object_item_data_get(it);
+		if (item == moved_item)
+			item->order_index = new_index;
+		else if (is_move_down && item->order_index > order_index && item->order_index <= new_index)
+			item->order_index--;
+		else if (!is_move_down && item->order_index >= new_index && item->order_index < order_index)
+			item->order_index++;
+		elm_object_item_data_set(it, item);
+		it = elm_genlist_item_next_get(it);
 	}
 }
 
@@ -1934,6 +1669,11 @@ void Browser_Bookmark_View::_go_up_to_main_folder(void)
 	elm_object_item_signal_emit(top_it, ELM_NAVIFRAME_ITEM_SIGNAL_OPTIONHEADER_INSTANT_OPEN);
 	evas_object_data_set(m_navi_bar, "visible", (void *)EINA_TRUE);
 
+	if (m_sub_folder_job_id) {
+		Browser_DB_Executor::get_instance()->cancel(m_sub_folder_job_id);
+		m_sub_folder_job_id = 0;
+	}
+
 	for(int i = 0 ; i < m_sub_folder_list.size() ; i++) {
 		if (m_sub_folder_list[i]) {
 			delete m_sub_folder_list[i];
@@ -1959,7 +1699,10 @@ void Browser_Bookmark_View::_go_up_to_main_folder(void)
 		m_sub_folder_conformant = NULL;
 	}
 
-	if (m_main_folder_list.size() == 0)
+	if (m_main_folder_job_id) {
+		_show_empty_content_layout(EINA_FALSE);
+		elm_object_item_disabled_set(m_bookmark_edit_controlbar_item, EINA_TRUE);
+	} else if (m_main_folder_list.size() == 0)
 		_show_empty_content_layout(EINA_TRUE);
 	else
 		_show_empty_content_layout(EINA_FALSE);
@@ -1988,9 +1731,6 @@ void Browser_Bookmark_View::_go_to_sub_foler(const char *folder_name)
 	_set_navigationbar_title(navigationbar_title.c_str());
 
 	elm_object_item_disabled_set(m_create_folder_controlbar_item, EINA_TRUE);
-
-	if (!m_sub_folder_list.size())
-		elm_object_item_disabled_set(m_bookmark_edit_controlbar_item, EINA_TRUE);
 }
 
 void Browser_Bookmark_View::_set_navigationbar_title(const char *title)
@@ -2067,26 +1807,13 @@ Evas_Object *Browser_Bookmark_View::_create_sub_folder_genlist(int folder_id)
 		}
 
 		/* Fill bookmark list */
-		Eina_Bool ret = m_data_manager->get_bookmark_db()->get_bookmark_list(m_sub_folder_list,
-											m_current_folder_id);
-		if (!ret) {
+		if (!_load_folder_items(genlist, EINA_FALSE))
 			return NULL;
-			BROWSER_LOGE("get_bookmark_list failed");
-		}
-
-		int size = m_sub_folder_list.size();
-		BROWSER_LOGD("bookmark count=%d", size);
-		for (int i = 0 ; i < size ; i++ ) {
-			m_sub_folder_list[i]->user_data_1 = (void *)this;
-			m_sub_folder_list[i]->user_data_2 = (void *)elm_genlist_item_append(genlist,
-						&m_bookmark_genlist_item_class, m_sub_folder_list[i], NULL,
-						ELM_GENLIST_ITEM_NONE, __bookmark_item_clicked_cb, this);
-		}
 
-		if (size == 0)
-			_show_empty_content_layout(EINA_TRUE);
-		else
+		if (m_sub_folder_job_id) {
 			_show_empty_content_layout(EINA_FALSE);
+			elm_object_item_disabled_set(m_bookmark_edit_controlbar_item, EINA_TRUE);
+		}
 	}
 
 	return genlist;
@@ -2131,31 +1858,175 @@ Evas_Object *Browser_Bookmark_View::_create_main_folder_genlist(void)
 		evas_object_show(genlist);
 
 		/* Fill bookmark list */
-		Eina_Bool ret = m_data_manager->get_bookmark_db()->get_bookmark_list(m_main_folder_list,
-											m_current_folder_id);
-		if (!ret) {
+		if (!_load_folder_items(genlist, EINA_TRUE))
 			return NULL;
-			BROWSER_LOGE("get_bookmark_list failed");
-		}
+	}
 
-		int size = m_main_folder_list.size();
-		BROWSER_LOGD("bookmark count=%d", size);
-		for (int i = 0 ; i < size ; i++ ) {
-			m_main_folder_list[i]->user_data_1 = (void *)this;
-			if (m_main_folder_list[i]->is_folder) {
-				m_main_folder_list[i]->user_data_2 = (void *)elm_genlist_item_append(genlist,
-							&m_folder_genlist_item_class, m_main_folder_list[i], NULL,
-							ELM_GENLIST_ITEM_NONE, __bookmark_item_clicked_cb, this);
+	return genlist;
+}
 
-			} else {
-				m_main_folder_list[i]->user_data_2 = (void *)elm_genlist_item_append(genlist,
-							&m_bookmark_genlist_item_class, m_main_folder_list[i], NULL,
-							ELM_GENLIST_ITEM_NONE, __bookmark_item_clicked_cb, this);
-			}
+Eina_Bool Browser_Bookmark_View::_load_folder_items(Evas_Object *genlist, Eina_Bool is_main_folder)
+{
+	int folder_id = is_main_folder ? BROWSER_BOOKMARK_MAIN_FOLDER_ID : m_current_folder_id;
+	int &job_id = is_main_folder ? m_main_folder_job_id : m_sub_folder_job_id;
+	if (job_id)
+		Browser_DB_Executor::get_instance()->cancel(job_id);
+
+	/* Read on the DB executor, the items are appended by __main_folder_list_loaded_cb
+	  * or __sub_folder_list_loaded_cb. */
+	Browser_Bookmark_DB *bookmark_db = m_data_manager->get_bookmark_db();
+	job_id = bookmark_db->get_bookmark_list_async(folder_id, is_main_folder ? __main_folder_list_loaded_cb
+								: __sub_folder_list_loaded_cb, this);
+	if (job_id)
+		return EINA_TRUE;
+
+	BROWSER_LOGE("get_bookmark_list_async failed, read the list here");
+	vector<Browser_Bookmark_DB::bookmark_item *> list;
+	if (!bookmark_db->get_bookmark_list(list, folder_id)) {
+		BROWSER_LOGE("get_bookmark_list failed");
+		return EINA_FALSE;
+	}
+	_append_folder_items(genlist, is_main_folder ? m_main_folder_list : m_sub_folder_list, list);
+
+	return EINA_TRUE;
+}
+
+void Browser_Bookmark_View::_reload_folder_genlist(Eina_Bool is_main_folder)
+{
+	BROWSER_LOGD("is_main_folder=%d", is_main_folder);
+	Evas_Object *genlist = is_main_folder ? m_main_folder_genlist : m_sub_folder_genlist;
+	vector<Browser_Bookmark_DB::bookmark_item *> &folder_list = is_main_folder ? m_main_folder_list
+										: m_sub_folder_list;
+	if (!genlist)
+		return;
+
+	m_current_sweep_item = NULL;
+	elm_genlist_clear(genlist);
+
+	for(int i = 0 ; i < folder_list.size() ; i++ ) {
+		if (folder_list[i])
+			delete folder_list[i];
+	}
+	folder_list.clear();
+
+	if (!_load_folder_items(genlist, is_main_folder))
+		BROWSER_LOGE("_load_folder_items failed");
+}
+
+void Browser_Bookmark_View::_reload_changed_folders(void)
+{
+	/* The edit mode changes its items itself and keeps their selection,
+	  * the folder is reloaded when it ends. */
+	if (m_is_main_folder_changed && !elm_genlist_decorate_mode_get(m_main_folder_genlist)) {
+		m_is_main_folder_changed = EINA_FALSE;
+		_reload_folder_genlist(EINA_TRUE);
+	}
+
+	if (m_is_sub_folder_changed && !m_sub_folder_genlist)
+		m_is_sub_folder_changed = EINA_FALSE;
+	else if (m_is_sub_folder_changed && !elm_genlist_decorate_mode_get(m_sub_folder_genlist)) {
+		m_is_sub_folder_changed = EINA_FALSE;
+		_reload_folder_genlist(EINA_FALSE);
+	}
+}
+
+void Browser_Bookmark_View::__bookmark_changed_cb(int folder_id, void *user_data)
+{
+	BROWSER_LOGD("folder_id=%d", folder_id);
+	if (!user_data)
+		return;
+
+	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)user_data;
+
+	/* The main folder is also notified when the changed folders are not known. */
+	if (folder_id == BROWSER_BOOKMARK_MAIN_FOLDER_ID) {
+		bookmark_view->m_is_main_folder_changed = EINA_TRUE;
+		if (bookmark_view->m_sub_folder_genlist)
+			bookmark_view->m_is_sub_folder_changed = EINA_TRUE;
+	} else if (bookmark_view->m_sub_folder_genlist && folder_id == bookmark_view->m_current_folder_id)
+		bookmark_view->m_is_sub_folder_changed = EINA_TRUE;
+	else
+		return;
+
+	/* The change may be made from a callback of an item of the genlist, which must not be cleared under it. */
+	if (!bookmark_view->m_reload_folder_idler)
+		bookmark_view->m_reload_folder_idler = ecore_idler_add(__reload_folder_idler_cb, bookmark_view);
+}
+
+Eina_Bool Browser_Bookmark_View::__reload_folder_idler_cb(void *data)
+{
+	if (!data)
+		return ECORE_CALLBACK_CANCEL;
+
+	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)data;
+	bookmark_view->m_reload_folder_idler = NULL;
+	bookmark_view->_reload_changed_folders();
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+void Browser_Bookmark_View::_append_folder_items(Evas_Object *genlist,
+					vector<Browser_Bookmark_DB::bookmark_item *> &folder_list,
+					vector<Browser_Bookmark_DB::bookmark_item *> &list)
+{
+	_read_favicons(list);
+
+	/* The folder may have been put in edit mode while it was read. */
+	Eina_Bool is_edit_mode = elm_genlist_decorate_mode_get(genlist);
+
+	int size = list.size();
+	BROWSER_LOGD("bookmark count=%d", size);
+	for (int i = 0 ; i < size ; i++ ) {
+		list[i]->user_data_1 = (void *)this;
+		if (list[i]->is_folder) {
+			list[i]->user_data_2 = (void *)elm_genlist_item_append(genlist,
+						&m_folder_genlist_item_class, list[i], NULL,
+						ELM_GENLIST_ITEM_NONE, __bookmark_item_clicked_cb, this);
+		} else {
+			list[i]->user_data_2 = (void *)elm_genlist_item_append(genlist,
+						&m_bookmark_genlist_item_class, list[i], NULL,
+						ELM_GENLIST_ITEM_NONE, __bookmark_item_clicked_cb, this);
 		}
+		if (is_edit_mode && !list[i]->is_editable)
+			elm_object_item_disabled_set((Elm_Object_Item *)list[i]->user_data_2, EINA_TRUE);
+		folder_list.push_back(list[i]);
 	}
 
-	return genlist;
+	/* The edit mode and the history tab keep their own controlbar. */
+	if (m_view_mode == BOOKMARK_VIEW && genlist == _get_current_folder_genlist() && !is_edit_mode) {
+		if (folder_list.size() == 0)
+			_show_empty_content_layout(EINA_TRUE);
+		else
+			_show_empty_content_layout(EINA_FALSE);
+	}
+}
+
+void Browser_Bookmark_View::__main_folder_list_loaded_cb(Eina_Bool result,
+					vector<Browser_Bookmark_DB::bookmark_item *> &list, void *user_data)
+{
+	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)user_data;
+	bookmark_view->m_main_folder_job_id = 0;
+	if (!result) {
+		BROWSER_LOGE("get_bookmark_list_async failed");
+		return;
+	}
+
+	bookmark_view->_append_folder_items(bookmark_view->m_main_folder_genlist,
+					bookmark_view->m_main_folder_list, list);
+}
+
+void Browser_Bookmark_View::__sub_folder_list_loaded_cb(Eina_Bool result,
+					vector<Browser_Bookmark_DB::bookmark_item *> &list, void *user_data)
+{
+	Browser_Bookmark_View *bookmark_view = (Browser_Bookmark_View *)user_data;
+	bookmark_view->m_sub_folder_job_id = 0;
+	if (!result) {
+		BROWSER_LOGE("get_bookmark_list_async failed");
+		return;
+	}
+
+	bookmark_view->_append_folder_items(bookmark_view->m_sub_folder_genlist,
+					bookmark_view->m_sub_folder_list, list);
 }
 
 void Browser_Bookmark_View::__create_folder_button(void *data, Evas_Object *obj, void *event_info)
@@ -2328,14 +2199,14 @@ Eina_Bool Browser_Bookmark_View::_set_controlbar_type(controlbar_type type)
 		elm_object_style_set(m_bottom_control_bar, "browser/default");
 		elm_toolbar_shrink_mode_set(m_bottom_control_bar, ELM_TOOLBAR_SHRINK_EXPAND);
 
-		Elm_Object_Item *empty_item = elm_toolbar_item_append(m_bottom_control_bar, NULL, NULL, NULL, NULL);
-		elm_object_item_disabled_set(empty_item, EINA_TRUE);
+		elm_toolbar_item_append(m_bottom_control_bar, BROWSER_IMAGE_DIR"/01_controlbar_icon_delete.png", NULL,
+								__clear_history_controlbar_item_clicked_cb, this);
 
 		m_bookmark_edit_controlbar_item = elm_toolbar_item_append(m_bottom_control_bar,
 								BROWSER_IMAGE_DIR"/01_controlbar_icon_compose.png", NULL,
 								__edit_controlbar_item_clicked_cb, this);
 
-		empty_item = elm_toolbar_item_append(m_bottom_control_bar, NULL, NULL, NULL, NULL);
+		Elm_Object_Item *empty_item = elm_toolbar_item_append(m_bottom_control_bar, NULL, NULL, NULL, NULL);
 		elm_object_item_disabled_set(empty_item, EINA_TRUE);
 
 		Browser_History_Layout *history_layout = m_data_manager->get_history_layout();
@@ -2487,8 +2358,11 @@ Eina_Bool Browser_Bookmark_View::_create_main_layout(void)
 
 	evas_object_smart_callback_add(m_navi_bar, "transition,finished", __naviframe_pop_finished_cb, this);
 
-	int size = m_main_folder_list.size();
-	if (size == 0)
+	/* While the main folder is read, its items show the empty layout if there are none. */
+	if (m_main_folder_job_id) {
+		_show_empty_content_layout(EINA_FALSE);
+		elm_object_item_disabled_set(m_bookmark_edit_controlbar_item, EINA_TRUE);
+	} else if (m_main_folder_list.size() == 0)
 		_show_empty_content_layout(EINA_TRUE);
 	else
 		_show_empty_content_layout(EINA_FALSE);
@@ -35,9 +35,7 @@ public:
 	~Browser_Bookmark_View(void);
 
 	Eina_Bool init(void);
-	void return_to_bookmark_view(int added_bookmark_id = -1);
-	Eina_Bool append_bookmark_item(const char *title, const char *url);
-	void delete_bookmark_item(int bookmark_id);
+	void return_to_bookmark_view(void);
 protected:
 	void history_item_clicked(const char *url);
 private:
@@ -56,6 +54,13 @@ private:
 	Eina_Bool _create_main_layout(void);
 	Evas_Object *_create_main_folder_genlist(void);
 	Evas_Object *_create_sub_folder_genlist(int folder_id);
+	/* Appends the items of list, read for the folder of genlist, to folder_list. */
+	void _append_folder_items(Evas_Object *genlist, vector<Browser_Bookmark_DB::bookmark_item *> &folder_list,
+					vector<Browser_Bookmark_DB::bookmark_item *> &list);
+	/* Reads the items of the main or the current sub folder into genlist. */
+	Eina_Bool _load_folder_items(Evas_Object *genlist, Eina_Bool is_main_folder);
+	void _reload_folder_genlist(Eina_Bool is_main_folder);
+	void _reload_changed_folders(void);
 	void _go_to_sub_foler(const char *folder_name);
 	void _go_up_to_main_folder(void);
 	void _set_navigationbar_title(const char *title);
@@ -66,25 +71,36 @@ private:
 	void _show_empty_content_layout(Eina_Bool is_empty);
 	void _reorder_bookmark_item(int order_index, Eina_Bool is_move_down);
 	Eina_Bool _is_empty_folder(string folder_name);
+	/* Reads the icons of the bookmarks of list into m_favicons. */
+	void _read_favicons(const vector<Browser_Bookmark_DB::bookmark_item *> &list);
 	Evas_Object *_get_current_folder_genlist(void);
 	void _delete_bookmark_item_from_folder_list(Browser_Bookmark_DB::bookmark_item *item);
 	vector<Browser_Bookmark_DB::bookmark_item *> _get_current_folder_item_list(void);
 	void _show_select_processing_popup(void);
-	void _show_delete_processing_popup(void);
 	Evas_Object *_show_delete_confirm_popup(void);
 	void _delete_bookmark_item_by_slide_button(Browser_Bookmark_DB::bookmark_item *item);
 	Eina_Bool _set_controlbar_type(controlbar_type type);
 
 	/* ecore timer callback functions */
 	static Eina_Bool __select_processing_popup_timer_cb(void *data);
-	static Eina_Bool __delete_processing_popup_timer_cb(void *data);
+
+	/* ecore idler callback functions */
+	static Eina_Bool __reload_folder_idler_cb(void *data);
+
+	/* bookmark db callback functions */
+	static void __bookmark_changed_cb(int folder_id, void *user_data);
+
+	/* DB executor callback functions */
+	static void __main_folder_list_loaded_cb(Eina_Bool result,
+				vector<Browser_Bookmark_DB::bookmark_item *> &list, void *user_data);
+	static void __sub_folder_list_loaded_cb(Eina_Bool result,
+				vector<Browser_Bookmark_DB::bookmark_item *> &list, void *user_data);
 
 	/* evas object event callback functions. */
 	static void __edit_mode_select_all_clicked_cb(void *data, Evas *evas, Evas_Object *obj, void *event_info);
 
 	/* elementary event callback functions. */
 	static void __select_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info);
-	static void __delete_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __slide_edit_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __slide_delete_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __slide_share_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
@@ -103,6 +119,7 @@ private:
 #endif
 	static void __back_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __edit_controlbar_item_clicked_cb(void *data, Evas_Object *obj, void *event_info);
+	static void __clear_history_controlbar_item_clicked_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __controlbar_tab_changed_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __bookmark_item_clicked_cb(void *data, Evas_Object *obj, void *eventInfo);
 	static void __delete_confirm_response_by_slide_button_cb(void *data, Evas_Object *obj, void *event_info);
@@ -146,6 +163,15 @@ private:
 
 	vector<Browser_Bookmark_DB::bookmark_item *> m_main_folder_list;
 	vector<Browser_Bookmark_DB::bookmark_item *> m_sub_folder_list;
+	/* By bookmark id, read with the folder lists. */
+	std::map<int, Browser_Favicon> m_favicons;
+	/* The folder lists being read on the DB executor, 0 if none. */
+	int m_main_folder_job_id;
+	int m_sub_folder_job_id;
+	/* The folders to reload on the idler, changed in the bookmark db. */
+	Eina_Bool m_is_main_folder_changed;
+	Eina_Bool m_is_sub_folder_changed;
+	Ecore_Idler *m_reload_folder_idler;
 
 	view_mode m_view_mode;
 	int m_current_folder_id;
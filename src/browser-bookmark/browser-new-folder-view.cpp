@@ -97,11 +97,6 @@ void Browser_New_Folder_View::__save_button_clicked_cb(void *data, Evas_Object *
 	if (elm_naviframe_bottom_item_get(m_navi_bar) != elm_naviframe_top_item_get(m_navi_bar))
 		elm_naviframe_item_pop(m_navi_bar);
 
-	if (m_data_manager->is_in_view_stack(BR_SELECT_FOLDER_VIEW)) {
-		/* Add to bookmark -> Folder select -> New folder, then Done. */
-		m_data_manager->get_select_folder_view()->return_to_select_folder_view();
-	}
-
 	Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
 
 	if (m_data_manager->is_in_view_stack(BR_BOOKMARK_VIEW)
@@ -114,7 +109,6 @@ Eina_Bool Browser_New_Folder_View::_create_new_folder(const char *folder_name)
 	BROWSER_LOGD("folder_name=[%s]", folder_name);
 
 	Browser_Bookmark_DB *bookmark_db = m_data_manager->get_bookmark_db();
-	Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
 
 	if (bookmark_db->is_duplicated(folder_name)) {
 		show_msg_popup(BR_STRING_ALREADY_EXISTS);
@@ -130,29 +124,6 @@ Eina_Bool Browser_New_Folder_View::_create_new_folder(const char *folder_name)
 			BROWSER_LOGD("bookmark_db->save_folder failed");
 	}
 
-	if (m_data_manager->is_in_view_stack(BR_BOOKMARK_VIEW)) {
-		/* If new folder is created, append the folder item to the main bookmark list. */
-		vector<Browser_Bookmark_DB::bookmark_item *> folder_list;
-		bookmark_db->get_folder_list(folder_list);
-		for(int i = 0 ; i < folder_list.size() ; i++) {
-			if (!strcmp(folder_list[i]->title.c_str(), folder_name)) {
-				folder_list[i]->user_data_1 = (void *)bookmark_view;
-				bookmark_view->m_main_folder_list.push_back(folder_list[i]);
-				folder_list[i]->user_data_2 = (void *)elm_genlist_item_append(bookmark_view->m_main_folder_genlist,
-						&(bookmark_view->m_folder_genlist_item_class), folder_list[i], NULL,
-						ELM_GENLIST_ITEM_NONE, bookmark_view->__bookmark_item_clicked_cb, bookmark_view);
-
-				break;
-			}
-		}
-
-		for(int i = 0 ; i < folder_list.size() ; i++) {
-			if (folder_list[i] && strcmp(folder_list[i]->title.c_str(), folder_name))
-				delete folder_list[i];
-		}
-
-	}
-
 	return EINA_TRUE;
 }
 
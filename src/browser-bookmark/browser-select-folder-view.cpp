@@ -32,6 +32,7 @@ Browser_Select_Folder_View::Browser_Select_Folder_View(int current_folder_id)
 	,m_cancel_button(NULL)
 	,m_done_button(NULL)
 	,m_navi_it(NULL)
+	,m_fill_folder_list_idler(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -40,6 +41,11 @@ Browser_Select_Folder_View::~Browser_Select_Folder_View(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
 
+	if (m_data_manager->get_bookmark_db())
+		m_data_manager->get_bookmark_db()->remove_bookmark_changed_cb(__bookmark_changed_cb, this);
+	if (m_fill_folder_list_idler)
+		ecore_idler_del(m_fill_folder_list_idler);
+
 	if (m_main_folder_item)
 		delete m_main_folder_item;
 
@@ -56,14 +62,42 @@ Eina_Bool Browser_Select_Folder_View::init(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
 
-	return _create_main_layout();
+	if (!_create_main_layout())
+		return EINA_FALSE;
+
+	m_data_manager->get_bookmark_db()->add_bookmark_changed_cb(__bookmark_changed_cb, this);
+
+	return EINA_TRUE;
 }
 
-void Browser_Select_Folder_View::return_to_select_folder_view(void)
+void Browser_Select_Folder_View::__bookmark_changed_cb(int folder_id, void *user_data)
 {
-	BROWSER_LOGD("[%s]", __func__);
+	BROWSER_LOGD("folder_id=%d", folder_id);
+	if (!user_data)
+		return;
 
-	_fill_folder_list();
+	Browser_Select_Folder_View *select_folder_view = (Browser_Select_Folder_View *)user_data;
+
+	/* The folders are in the main folder. */
+	if (folder_id != BROWSER_BOOKMARK_MAIN_FOLDER_ID)
+		return;
+
+	/* The list must not be cleared from the callback of its item. */
+	if (!select_folder_view->m_fill_folder_list_idler)
+		select_folder_view->m_fill_folder_list_idler = ecore_idler_add(__fill_folder_list_idler_cb,
+										select_folder_view);
+}
+
+Eina_Bool Browser_Select_Folder_View::__fill_folder_list_idler_cb(void *data)
+{
+	if (!data)
+		return ECORE_CALLBACK_CANCEL;
+
+	Browser_Select_Folder_View *select_folder_view = (Browser_Select_Folder_View *)data;
+	select_folder_view->m_fill_folder_list_idler = NULL;
+	select_folder_view->_fill_folder_list();
+
+	return ECORE_CALLBACK_CANCEL;
 }
 
 void Browser_Select_Folder_View::__folder_item_selected_cb(void *data, Evas_Object *obj, void *event_info)
@@ -110,6 +144,8 @@ void Browser_Select_Folder_View::_fill_folder_list(void)
 		return;
 	}
 
+	if (m_main_folder_item)
+		delete m_main_folder_item;
 	m_main_folder_item = new(nothrow) Browser_Bookmark_DB::bookmark_item;
 	if (!m_main_folder_item) {
 		BROWSER_LOGE("new Browser_Bookmark_DB::bookmark_item failed");
@@ -28,11 +28,16 @@ public:
 	~Browser_Select_Folder_View(void);
 
 	Eina_Bool init(void);
-	void return_to_select_folder_view(void);
 private:
 	Eina_Bool _create_main_layout(void);
 	void _fill_folder_list(void);
 
+	/* ecore idler callback functions */
+	static Eina_Bool __fill_folder_list_idler_cb(void *data);
+
+	/* bookmark db callback functions */
+	static void __bookmark_changed_cb(int folder_id, void *user_data);
+
 	/* Elementary event callback functions */
 	static void __folder_item_selected_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __new_folder_clicked_cb(void *data, Evas_Object *obj, void *event_info);
@@ -51,6 +56,7 @@ private:
 	int m_current_folder_id;
 	vector<Browser_Bookmark_DB::bookmark_item *> m_folder_list;
 	Browser_Bookmark_DB::bookmark_item *m_main_folder_item;
+	Ecore_Idler *m_fill_folder_list_idler;
 };
 
 #endif /* BROWSER_SELECT_FOLDER_VIEW_H */
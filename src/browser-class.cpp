@@ -15,10 +15,15 @@
  *
  */
 
+#include "browser-bookmark-db.h"
 #include "browser-class.h"
 #include "browser-context-menu.h"
+#include "browser-db-connection.h"
+#include "browser-db-executor.h"
+#include "browser-db-maintenance.h"
 #include "browser-find-word.h"
 #include "browser-geolocation.h"
+#include "browser-history-db.h"
 #include "browser-multi-window-view.h"
 #include "browser-network-manager.h"
 #include "browser-user-agent-db.h"
@@ -64,6 +69,16 @@ Browser_Class::~Browser_Class(void)
 
 	if (m_clean_up_windows_timer)
 		ecore_timer_del(m_clean_up_windows_timer);
+
+	Browser_DB_Maintenance::cancel();
+	/* Runs the jobs already queued, the worker connections are closed with it. */
+	Browser_DB_Executor::destroy_instance();
+
+	if (!Browser_History_DB::flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	/* All the *_DB objects are gone with the views above. */
+	Browser_DB_Connection::close_all_connections();
 }
 
 Eina_Bool Browser_Class::__create_network_manager_idler_cb(void *data)
@@ -819,6 +834,13 @@ void Browser_Class::pause(void)
 	m_browser_view->pause();
 	m_download_policy->pause();
 
+	/* The process may be killed while it is in background. */
+	if (!Browser_History_DB::flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+	/* Anything written to the files from now on is done by another application. */
+	Browser_DB_Connection::mark_all_synced();
+	Browser_DB_Maintenance::schedule();
+
 	if (m_clean_up_windows_timer)
 		ecore_timer_del(m_clean_up_windows_timer);
 	m_clean_up_windows_timer = ecore_timer_add(BROWSER_CLEAN_UP_WINDOWS_TIMEOUT,
@@ -828,6 +850,10 @@ void Browser_Class::pause(void)
 void Browser_Class::resume(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
+	Browser_DB_Maintenance::cancel();
+	Browser_Bookmark_DB::check_external_change();
+	Browser_History_DB::check_external_change();
+
 	m_browser_view->resume();
 
 	if (m_clean_up_windows_timer) {
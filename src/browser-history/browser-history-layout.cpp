@@ -20,30 +20,61 @@
 #include "browser-view.h"
 #include "browser-history-layout.h"
 
-Date::Date() : day(0), month(0), year(0) {}
-
-Date::Date(Date &date)
+Date_Label_Arena::Date_Label_Arena(void)
+:	m_block_used(BROWSER_DATE_LABEL_BLOCK_SIZE)
 {
-	this->day = date.day;
-	this->month = date.month;
-	this->year = date.year;
 }
 
-void Date::operator=(Date &date)
+Date_Label_Arena::~Date_Label_Arena(void)
 {
-	this->day = date.day;
-	this->month = date.month;
-	this->year = date.year;
+	clear();
 }
 
-bool Date::operator==(Date &date)
+const char *Date_Label_Arena::add(time_t day, const char *today_format, const char *yesterday_format,
+					const char *format)
 {
-	return (this->day == date.day && this->month == date.month && this->year == date.year);
+	time_t now = time(NULL);
+	struct tm time_info;
+	localtime_r(&now, &time_info);
+	time_info.tm_hour = 0;
+	time_info.tm_min = 0;
+	time_info.tm_sec = 0;
+	time_info.tm_isdst = -1;
+	time_t today = mktime(&time_info);
+	time_info.tm_mday--;
+	time_info.tm_isdst = -1;
+	time_t yesterday = mktime(&time_info);
+
+	if (day == today)
+		format = today_format;
+	else if (day == yesterday)
+		format = yesterday_format;
+
+	if (m_block_used + BROWSER_MAX_DATE_LEN > BROWSER_DATE_LABEL_BLOCK_SIZE) {
+		char *block = (char *)malloc(BROWSER_DATE_LABEL_BLOCK_SIZE);
+		if (!block) {
+			BROWSER_LOGE("malloc failed");
+			return NULL;
+		}
+		m_blocks.push_back(block);
+		m_block_used = 0;
+	}
+
+	char *label = m_blocks.back() + m_block_used;
+	localtime_r(&day, &time_info);
+	size_t length = strftime(label, BROWSER_MAX_DATE_LEN, format, &time_info);
+	label[length] = '\0';
+	m_block_used += length + 1;
+
+	return label;
 }
 
-bool Date::operator!=(Date &date)
+void Date_Label_Arena::clear(void)
 {
-	return (this->day != date.day || this->month != date.month || this->year != date.year);
+	for (int i = 0 ; i < m_blocks.size() ; i++)
+		free(m_blocks[i]);
+	m_blocks.clear();
+	m_block_used = BROWSER_DATE_LABEL_BLOCK_SIZE;
 }
 
 Browser_History_Layout::Browser_History_Layout(void)
@@ -68,6 +99,13 @@ Browser_History_Layout::Browser_History_Layout(void)
 	,m_searchbar(NULL)
 	,m_delete_confirm_popup(NULL)
 	,m_is_bookmark_on_off_icon_clicked(EINA_FALSE)
+	,m_last_day(0)
+	,m_last_date_group_item(NULL)
+	,m_is_history_list_end(EINA_FALSE)
+	,m_append_history_page_idler(NULL)
+	,m_history_page_job_id(0)
+	,m_is_history_list_reloading(EINA_FALSE)
+	,m_clear_history_popup(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -77,24 +115,19 @@ Browser_History_Layout::~Browser_History_Layout(void)
 	BROWSER_LOGD("[%s]", __func__);
 	hide_notify_popup_layout(m_sub_main_history_layout);
 
+	if (m_append_history_page_idler) {
+		ecore_idler_del(m_append_history_page_idler);
+		m_append_history_page_idler = NULL;
+	}
+	if (m_history_page_job_id && Browser_DB_Executor::has_instance())
+		Browser_DB_Executor::get_instance()->cancel(m_history_page_job_id);
+
 	for(int i = 0 ; i < m_history_list.size() ; i++ ) {
 		if (m_history_list[i])
 			delete m_history_list[i];
 	}
 	m_history_list.clear();
 
-	for(int i = 0 ; i < m_history_date_label_list.size() ; i++ ) {
-		if (m_history_date_label_list[i])
-			free(m_history_date_label_list[i]);
-	}
-	m_history_date_label_list.clear();
-
-	for(int i = 0 ; i < m_searched_history_date_label_list.size() ; i++ ) {
-		if (m_searched_history_date_label_list[i])
-			free(m_searched_history_date_label_list[i]);
-	}
-	m_searched_history_date_label_list.clear();
-
 	for(int i = 0 ; i < m_searched_history_item_list.size() ; i++ ) {
 		if (m_searched_history_item_list[i])
 			delete m_searched_history_item_list[i];
@@ -104,6 +137,7 @@ Browser_History_Layout::~Browser_History_Layout(void)
 	if (m_delete_confirm_popup)
 		evas_object_del(m_delete_confirm_popup);
 
+	_destroy_clear_history_popup();
 }
 
 Eina_Bool Browser_History_Layout::init(void)
@@ -122,12 +156,6 @@ Eina_Bool Browser_History_Layout::_show_searched_history(const char *search_text
 	}
 	m_searched_history_item_list.clear();
 
-	for(int i = 0 ; i < m_searched_history_date_label_list.size() ; i++ ) {
-		if (m_searched_history_date_label_list[i])
-			free(m_searched_history_date_label_list[i]);
-	}
-	m_searched_history_date_label_list.clear();
-
 	if (!search_text || !strlen(search_text)) {
 		if (m_searched_history_genlist || m_no_content_search_result) {
 			elm_box_unpack_all(m_content_box);
@@ -155,25 +183,11 @@ Eina_Bool Browser_History_Layout::_show_searched_history(const char *search_text
 		}
 	}
 
-	Elm_Object_Item *it = elm_genlist_first_item_get(m_history_genlist);
-	while (it) {
-		Browser_History_DB::history_item *item = NULL;
-		item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
-		if (item && elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
-			if (item->url.find(search_text) != string::npos || item->title.find(search_text) != string::npos) {
-				Browser_History_DB::history_item *searched_item = NULL;
-				searched_item = new(nothrow) Browser_History_DB::history_item;
-				searched_item->id = item->id;
-				searched_item->url = item->url;
-				searched_item->title = item->title;
-				searched_item->date = item->date;
-				searched_item->is_delete = item->is_delete;
-				searched_item->user_data = item->user_data;
-				m_searched_history_item_list.push_back(searched_item);
-			}
-		}
-		it = elm_genlist_item_next_get(it);
-	}
+	if (!m_data_manager->get_history_db()->search_history(search_text, BROWSER_HISTORY_SEARCH_RESULT_MAX,
+								m_searched_history_item_list))
+		BROWSER_LOGE("search_history failed");
+
+	_read_favicons(m_searched_history_item_list);
 
 	if (m_searched_history_item_list.size()) {
 		if (m_no_content_search_result) {
@@ -191,26 +205,11 @@ Eina_Bool Browser_History_Layout::_show_searched_history(const char *search_text
 
 		elm_genlist_clear(m_searched_history_genlist);
 
-		Date date;
-		Date last_date;
+		/* The results are in rank order, so they are not grouped by date. */
 		for(int i = 0 ; i < m_searched_history_item_list.size() ; i++) {
-			sscanf(m_searched_history_item_list[i]->date.c_str(), "%d-%d-%d", &date.year, &date.month, &date.day);
 			m_searched_history_item_list[i]->user_data = (void *)this;
-			if (last_date != date) {
-				last_date = date;
-				char *labe_item = strdup(m_searched_history_item_list[i]->date.c_str());
-				if (!labe_item) {
-					BROWSER_LOGE("strdup failed");
-					return EINA_FALSE;
-				}
-				m_searched_history_date_label_list.push_back(labe_item);
-				it = elm_genlist_item_append(m_searched_history_genlist, &m_history_group_title_class,
-								labe_item, NULL, ELM_GENLIST_ITEM_GROUP, NULL, NULL);
-
-				elm_genlist_item_select_mode_set(it, ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY);
-			}
 			elm_genlist_item_append(m_searched_history_genlist, &m_history_genlist_item_class,
-						m_searched_history_item_list[i], it, ELM_GENLIST_ITEM_NONE,
+						m_searched_history_item_list[i], NULL, ELM_GENLIST_ITEM_NONE,
 						__history_item_clicked_cb, this);
 		}
 
@@ -294,12 +293,6 @@ void Browser_History_Layout::_enable_searchbar_layout(Eina_Bool enable)
 		}
 		m_searched_history_item_list.clear();
 
-		for(int i = 0 ; i < m_searched_history_date_label_list.size() ; i++ ) {
-			if (m_searched_history_date_label_list[i])
-				free(m_searched_history_date_label_list[i]);
-		}
-		m_searched_history_date_label_list.clear();
-
 		if (m_searched_history_genlist || m_no_content_search_result) {
 			elm_box_unpack_all(m_content_box);
 			elm_box_pack_start(m_content_box, m_history_genlist);
@@ -410,33 +403,9 @@ void Browser_History_Layout::_set_edit_mode(Eina_Bool edit_mode)
 
 		bookmark_view->_set_navigationbar_title(BR_STRING_HISTORY);
 
-		if (m_history_list.size() == 0) {
-			elm_box_unpack_all(m_content_box);
-			elm_genlist_clear(m_history_genlist);
-			evas_object_hide(m_history_genlist);
-
-			if (m_edit_mode_select_all_layout) {
-				evas_object_del(m_edit_mode_select_all_layout);
-				m_edit_mode_select_all_layout = NULL;
-			}
-			if (m_edit_mode_select_all_check_button) {
-				evas_object_del(m_edit_mode_select_all_check_button);
-				m_edit_mode_select_all_check_button = NULL;
-			}
-
-			m_no_history_label = elm_label_add(m_searchbar_layout);
-			if (!m_no_history_label) {
-				BROWSER_LOGE("elm_label_add failed");
-				return;
-			}
-
-			std::string text = std::string("<color='#646464'>") + std::string(BR_STRING_NO_HISTORY);
-			elm_object_text_set(m_no_history_label, text.c_str());
-			evas_object_show(m_no_history_label);
-			elm_box_pack_start(m_content_box, m_no_history_label);
-
-			elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_TRUE);
-		}
+		/* Otherwise the page being read shows the label if it is empty. */
+		if (m_history_list.size() == 0 && m_is_history_list_end)
+			_show_no_history();
 	}
 }
 
@@ -482,194 +451,6 @@ void Browser_History_Layout::_show_selection_info(void)
 	}
 }
 
-void Browser_History_Layout::_show_delete_processing_popup(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_processing_popup)
-		evas_object_del(m_processing_popup);
-
-	m_processing_popup = elm_popup_add(m_searchbar_layout);
-	if (!m_processing_popup) {
-		BROWSER_LOGE("elm_popup_add failed");
-		return;
-	}
-
-	if (m_processing_popup_layout)
-		evas_object_del(m_processing_popup_layout);
-	m_processing_popup_layout = elm_layout_add(m_processing_popup);
-	if (!m_processing_popup_layout) {
-		BROWSER_LOGE("elm_layout_add failed");
-		return;
-	}
-	if (!elm_layout_file_set(m_processing_popup_layout, BROWSER_EDJE_DIR"/browser-bookmark-view.edj",
-							"browser/popup_center_progressview")) {
-		BROWSER_LOGE("elm_layout_file_set failed");
-		return;
-	}
-	evas_object_size_hint_weight_set(m_processing_popup_layout, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-
-	m_processing_progress_bar = elm_progressbar_add(m_processing_popup);
-	elm_object_style_set(m_processing_progress_bar, "list_progress");
-	elm_progressbar_horizontal_set(m_processing_progress_bar, EINA_TRUE);
-	evas_object_size_hint_align_set(m_processing_progress_bar, EVAS_HINT_FILL, EVAS_HINT_FILL);
-	evas_object_size_hint_weight_set(m_processing_progress_bar, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-	elm_progressbar_value_set(m_processing_progress_bar, 0.0);
-
-	if (m_processing_popup_timer)
-		ecore_timer_del(m_processing_popup_timer);
-
-	m_processed_count = 0;
-	m_processed_it = elm_genlist_last_item_get(m_history_genlist);
-
-	Elm_Object_Item *it = elm_genlist_first_item_get(m_history_genlist);
-	m_total_item_count = 0;
-	while (it) {
-		Browser_History_DB::history_item *item = NULL;
-		item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
-		if (item && elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
-			if(item->is_delete)
-				m_total_item_count++;
-		}
-		it = elm_genlist_item_next_get(it);
-	}
-
-	m_processing_popup_timer = ecore_timer_add(0.3, __delete_processing_popup_timer_cb, this);
-	evas_object_show(m_processing_progress_bar);
-
-	elm_object_part_content_set(m_processing_popup_layout, "elm.swallow.content", m_processing_progress_bar);
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.title", BR_STRING_PROCESSING);
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.text.left", "");
-	edje_object_part_text_set(elm_layout_edje_get(m_processing_popup_layout), "elm.text.right", "");
-
-	elm_object_content_set(m_processing_popup, m_processing_popup_layout);
-
-	Evas_Object *cancel_button = elm_button_add(m_processing_popup);
-	if (!cancel_button) {
-		BROWSER_LOGE("elm_button_add failed");
-		return;
-	}
-	elm_object_text_set(cancel_button, BR_STRING_CANCEL);
-	elm_object_part_content_set(m_processing_popup, "button1", cancel_button);
-	evas_object_smart_callback_add(cancel_button, "clicked", __delete_processing_popup_response_cb, this);
-
-	evas_object_show(m_processing_popup);
-}
-
-void Browser_History_Layout::__delete_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (!data)
-		return;
-
-	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
-
-	evas_object_del(history_layout->m_processing_popup);
-
-	history_layout->m_processing_progress_bar = NULL;
-	history_layout->m_processed_it = NULL;
-
-	if (history_layout->m_processing_popup_timer) {
-		ecore_timer_del(history_layout->m_processing_popup_timer);
-		history_layout->m_processing_popup_timer = NULL;
-	}
-
-	history_layout->show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
-
-	if (history_layout->m_history_list.size() == 0) {
-		elm_box_unpack_all(history_layout->m_content_box);
-		elm_genlist_clear(history_layout->m_history_genlist);
-		evas_object_hide(history_layout->m_history_genlist);
-
-		if (history_layout->m_edit_mode_select_all_layout) {
-			evas_object_del(history_layout->m_edit_mode_select_all_layout);
-			history_layout->m_edit_mode_select_all_layout = NULL;
-		}
-		if (history_layout->m_edit_mode_select_all_check_button) {
-			evas_object_del(history_layout->m_edit_mode_select_all_check_button);
-			history_layout->m_edit_mode_select_all_check_button = NULL;
-		}
-
-		history_layout->m_no_history_label = elm_label_add(history_layout->m_searchbar_layout);
-		if (!history_layout->m_no_history_label) {
-			BROWSER_LOGE("elm_label_add failed");
-			return;
-		}
-
-		std::string text = std::string("<color='#646464'>") + std::string(BR_STRING_NO_HISTORY);
-		elm_object_text_set(history_layout->m_no_history_label, text.c_str());
-		evas_object_show(history_layout->m_no_history_label);
-		elm_box_pack_start(history_layout->m_content_box, history_layout->m_no_history_label);
-
-		Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
-		if (!bookmark_view->_set_controlbar_type(Browser_Bookmark_View::HISTORY_VIEW_DEFAULT))
-			BROWSER_LOGE("_set_controlbar_type failed");
-
-		elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_TRUE);
-	}
-}
-
-Eina_Bool Browser_History_Layout::__delete_processing_popup_timer_cb(void *data)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (!data)
-		return ECORE_CALLBACK_CANCEL;
-
-	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
-	Evas_Object* progress_bar = history_layout->m_processing_progress_bar;
-
-	Eina_Bool check_value = history_layout->m_select_all_check_value;
-
-	double value = elm_progressbar_value_get(progress_bar);
-	if (value >= 1.0) {
-		__delete_processing_popup_response_cb(history_layout, NULL, NULL);
-
-		history_layout->m_processing_popup_timer = NULL;
-		history_layout->show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
-
-		return ECORE_CALLBACK_CANCEL;
-	}
-
-	while (history_layout->m_processed_it) {
-		Browser_History_DB::history_item *item = NULL;
-		item = (Browser_History_DB::history_item *)elm_object_item_data_get(history_layout->m_processed_it);
-		if (item) {			
-			if(item->is_delete
-			    && elm_genlist_item_select_mode_get(history_layout->m_processed_it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
-				Eina_Bool ret = m_data_manager->get_history_db()->delete_history(item->id);
-				for(int index = 0 ; index < history_layout->m_history_list.size() ; index++) {
-					if (history_layout->m_history_list[index]->id == item->id) {
-						delete history_layout->m_history_list[index];
-						history_layout->m_history_list.erase(history_layout->m_history_list.begin() + index);
-					}
-				}
-
-				history_layout->m_processed_count++;
-				Elm_Object_Item *it = history_layout->m_processed_it;
-				history_layout->m_processed_it = elm_genlist_item_prev_get(history_layout->m_processed_it);
-				elm_object_item_del(it);
-				elm_genlist_realized_items_update(history_layout->m_history_genlist);
-			} else
-				history_layout->m_processed_it = elm_genlist_item_prev_get(history_layout->m_processed_it);
-		} else
-			history_layout->m_processed_it = elm_genlist_item_prev_get(history_layout->m_processed_it);
-
-		if (history_layout->m_processed_count % 20 == 0)
-			break;
-	}
-
-	elm_progressbar_value_set(history_layout->m_processing_progress_bar,
-				(float)((float)history_layout->m_processed_count / (float)history_layout->m_total_item_count));
-
-	char progress_text[20] = {0, };
-	snprintf(progress_text, sizeof(progress_text) - 1, "%d / %d",
-			history_layout->m_processed_count, history_layout->m_total_item_count);
-
-	edje_object_part_text_set(elm_layout_edje_get(history_layout->m_processing_popup_layout),
-				"elm.text.right", progress_text);
-
-	return ECORE_CALLBACK_RENEW;
-}
-
 void Browser_History_Layout::_show_select_processing_popup(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -957,96 +738,127 @@ void Browser_History_Layout::_delete_selected_history(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
 
+	Eina_List *delete_item_list = NULL;
+	std::vector<int> delete_id_list;
+	std::set<int> delete_ids;
 	Elm_Object_Item *it = elm_genlist_first_item_get(m_history_genlist);
-	int delete_item_count = 0;
+	int remain_count = 0;
 	Browser_History_DB::history_item *item = NULL;
+
 	while (it) {
 		item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
-		if ((elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) && item->is_delete) {
-			delete_item_count++;
+		if (elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY
+		    && item->is_delete && delete_ids.insert(item->id).second)
+			delete_id_list.push_back(item->id);
+		it = elm_genlist_item_next_get(it);
+	}
+
+	/* An address is listed under every day it was visited on, all of them go with it. */
+	it = elm_genlist_first_item_get(m_history_genlist);
+	while (it) {
+		item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
+		if (elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
+			if (delete_ids.count(item->id))
+				delete_item_list = eina_list_append(delete_item_list, it);
+			else
+				remain_count++;
 		}
 		it = elm_genlist_item_next_get(it);
 	}
 
-	if (delete_item_count >= BROWSER_BOOKMARK_PROCESS_BLOCK_COUNT) {
-		_show_delete_processing_popup();
-	} else {
-		Eina_List *delete_item_list = NULL;
-		it = elm_genlist_first_item_get(m_history_genlist);
-		int remain_count = 0;
-		Browser_History_DB::history_item *item = NULL;
+	/* With select all, the pages which are not loaded yet are selected too,
+	  * so the whole history is cleared in db instead of the loaded ids. */
+	Eina_Bool is_all_selected = EINA_FALSE;
+	if (remain_count == 0 && m_edit_mode_select_all_check_button)
+		is_all_selected = elm_check_state_get(m_edit_mode_select_all_check_button);
 
-		while (it) {
-			item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
-			if (elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
-				if (item->is_delete)
-					delete_item_list = eina_list_append(delete_item_list, it);
-				else
-					remain_count++;
-			}
-			it = elm_genlist_item_next_get(it);
+	if (is_all_selected) {
+		if (!m_data_manager->get_history_db()->clear_history()) {
+			BROWSER_LOGE("clear_history failed");
+			eina_list_free(delete_item_list);
+			return;
 		}
+		/* A page being read may hold the cleared items. */
+		if (m_history_page_job_id) {
+			Browser_DB_Executor::get_instance()->cancel(m_history_page_job_id);
+			m_history_page_job_id = 0;
+		}
+		m_is_history_list_end = EINA_TRUE;
+	} else if (!m_data_manager->get_history_db()->delete_history(delete_id_list)) {
+		/* All the selected items are deleted from db in one transaction. */
+		BROWSER_LOGE("delete_history failed");
+		eina_list_free(delete_item_list);
+		return;
+	}
 
-		int count = eina_list_count(delete_item_list);
-		for (int i = 0; i < count; i++) {
-			it = (Elm_Object_Item *)eina_list_data_get(delete_item_list);
-			item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
-			/* Delete history item */
-			Eina_Bool ret = m_data_manager->get_history_db()->delete_history(item->id);
-			if (!ret)
-				BROWSER_LOGD("history [%s] delete failed", item->title.c_str());
-
-			delete_item_list = eina_list_next(delete_item_list);
+	Eina_List *list = NULL;
+	void *list_data = NULL;
+	EINA_LIST_FOREACH(delete_item_list, list, list_data) {
+		it = (Elm_Object_Item *)list_data;
+		item = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
 
-			for(int index = 0 ; index < m_history_list.size() ; index++) {
-				if (m_history_list[index]->id == item->id) {
-					delete m_history_list[index];
-					m_history_list.erase(m_history_list.begin() + index);
-				}
+		for(int index = 0 ; index < m_history_list.size() ; index++) {
+			if (m_history_list[index] == item) {
+				delete m_history_list[index];
+				m_history_list.erase(m_history_list.begin() + index);
+				break;
 			}
-
-			elm_object_item_del(it);
 		}
-		eina_list_free(delete_item_list);
 
-		elm_check_state_set(m_edit_mode_select_all_check_button, EINA_FALSE);
+		elm_object_item_del(it);
+	}
+	eina_list_free(delete_item_list);
 
-		_delete_date_only_label_genlist_item();
+	elm_check_state_set(m_edit_mode_select_all_check_button, EINA_FALSE);
 
-		if (remain_count == 0) {
-			elm_box_unpack_all(m_content_box);
-			elm_genlist_clear(m_history_genlist);
-			evas_object_hide(m_history_genlist);
+	_delete_date_only_label_genlist_item();
 
-			if (m_edit_mode_select_all_layout) {
-				evas_object_del(m_edit_mode_select_all_layout);
-				m_edit_mode_select_all_layout = NULL;
-			}
-			if (m_edit_mode_select_all_check_button) {
-				evas_object_del(m_edit_mode_select_all_check_button);
-				m_edit_mode_select_all_check_button = NULL;
-			}
+	/* The loaded items are all deleted, but the next pages may still remain in db.
+	  * The no history label is then shown by _history_page_loaded() if there are none. */
+	if (remain_count == 0 && !m_is_history_list_end) {
+		if (!_append_history_page())
+			BROWSER_LOGE("_append_history_page failed");
+	} else if (remain_count == 0)
+		_show_no_history();
 
-			m_no_history_label = elm_label_add(m_searchbar_layout);
-			if (!m_no_history_label) {
-				BROWSER_LOGE("elm_label_add failed");
-				return;
-			}
-
-			std::string text = std::string("<color='#646464'>") + std::string(BR_STRING_NO_HISTORY);
-			elm_object_text_set(m_no_history_label, text.c_str());
-			evas_object_show(m_no_history_label);
-			elm_box_pack_start(m_content_box, m_no_history_label);
+	show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
+}
 
-			Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
-			if (!bookmark_view->_set_controlbar_type(Browser_Bookmark_View::HISTORY_VIEW_DEFAULT))
-				BROWSER_LOGE("_set_controlbar_type failed");
+void Browser_History_Layout::_show_no_history(void)
+{
+	elm_box_unpack_all(m_content_box);
+	elm_genlist_clear(m_history_genlist);
+	evas_object_hide(m_history_genlist);
 
-			elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_TRUE);
-		}
+	if (m_edit_mode_select_all_layout) {
+		evas_object_del(m_edit_mode_select_all_layout);
+		m_edit_mode_select_all_layout = NULL;
+	}
+	if (m_edit_mode_select_all_check_button) {
+		evas_object_del(m_edit_mode_select_all_check_button);
+		m_edit_mode_select_all_check_button = NULL;
+	}
+	if (m_no_history_label) {
+		evas_object_del(m_no_history_label);
+		m_no_history_label = NULL;
+	}
 
-		show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
+	m_no_history_label = elm_label_add(m_searchbar_layout);
+	if (!m_no_history_label) {
+		BROWSER_LOGE("elm_label_add failed");
+		return;
 	}
+
+	std::string text = std::string("<color='#646464'>") + std::string(BR_STRING_NO_HISTORY);
+	elm_object_text_set(m_no_history_label, text.c_str());
+	evas_object_show(m_no_history_label);
+	elm_box_pack_start(m_content_box, m_no_history_label);
+
+	Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
+	if (!bookmark_view->_set_controlbar_type(Browser_Bookmark_View::HISTORY_VIEW_DEFAULT))
+		BROWSER_LOGE("_set_controlbar_type failed");
+
+	elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_TRUE);
 }
 
 void Browser_History_Layout::_reload_history_genlist(void)
@@ -1062,40 +874,22 @@ void Browser_History_Layout::_reload_history_genlist(void)
 	elm_box_unpack_all(m_content_box);
 	m_history_list.clear();	
 
-	for(int i = 0 ; i < m_history_date_label_list.size() ; i++ ) {
-		if (m_history_date_label_list[i])
-			free(m_history_date_label_list[i]);
-	}
-	m_history_date_label_list.clear();
-
-	Eina_Bool ret = m_data_manager->get_history_db()->get_history_list(m_history_list);
-	if (!ret)
-		BROWSER_LOGE("get_history_list failed");
-
-	unsigned int history_count = m_history_list.size();
-	BROWSER_LOGD("history_count=%d", history_count);
-
-	Date date;
-	for(int i = 0 ; i < history_count; i++) {
-		sscanf(m_history_list[i]->date.c_str(), "%d-%d-%d", &date.year, &date.month, &date.day);
-		m_history_list[i]->user_data = (void *)this;
-		if (m_last_date != date) {
-			m_last_date = date;
-			char *labe_item = strdup(m_history_list[i]->date.c_str());
-			if (!labe_item) {
-				BROWSER_LOGE("strdup failed");
-				return;
-			}
-			m_history_date_label_list.push_back(labe_item);
-			it = elm_genlist_item_append(m_history_genlist, &m_history_group_title_class,
-							labe_item, NULL, ELM_GENLIST_ITEM_GROUP, NULL, NULL);
+	m_date_labels.clear();
+	m_favicons.clear();
 
-			elm_genlist_item_select_mode_set(it, ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY);
-		}
-		elm_genlist_item_append(m_history_genlist, &m_history_genlist_item_class, m_history_list[i], it,
-					ELM_GENLIST_ITEM_NONE, __history_item_clicked_cb, this);
+	if (m_append_history_page_idler) {
+		ecore_idler_del(m_append_history_page_idler);
+		m_append_history_page_idler = NULL;
+	}
+	if (m_history_page_job_id) {
+		Browser_DB_Executor::get_instance()->cancel(m_history_page_job_id);
+		m_history_page_job_id = 0;
 	}
 
+	m_last_day = 0;
+	m_last_date_group_item = NULL;
+	m_is_history_list_end = EINA_FALSE;
+
 	if (m_no_history_label) {
 		evas_object_del(m_no_history_label);
 		m_no_history_label = NULL;
@@ -1111,31 +905,281 @@ void Browser_History_Layout::_reload_history_genlist(void)
 		m_edit_mode_select_all_layout = NULL;
 	}
 
-	if (m_history_list.size() == 0) {
-		evas_object_hide(m_history_genlist);
+	/* Only the first page, the rest is appended while scrolling down.
+	  * The genlist or the no history label is shown once the page is read. */
+	m_is_history_list_reloading = EINA_TRUE;
+	if (!_append_history_page())
+		BROWSER_LOGE("_append_history_page failed");
+}
+
+Eina_Bool Browser_History_Layout::_show_clear_history_popup(Evas_Object *control_bar)
+{
+	BROWSER_LOGD("[%s]", __func__);
+
+	_destroy_clear_history_popup();
+
+	m_clear_history_popup = elm_ctxpopup_add(m_navi_bar);
+	if (!m_clear_history_popup) {
+		BROWSER_LOGE("elm_ctxpopup_add failed");
+		return EINA_FALSE;
+	}
+	evas_object_size_hint_weight_set(m_clear_history_popup, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+	elm_ctxpopup_hover_parent_set(m_clear_history_popup, m_navi_bar);
+	evas_object_smart_callback_add(m_clear_history_popup, "dismissed",
+					__clear_history_popup_dismissed_cb, this);
+
+	elm_ctxpopup_item_append(m_clear_history_popup, BR_STRING_LAST_HOUR, NULL,
+					__clear_last_hour_history_cb, this);
+	elm_ctxpopup_item_append(m_clear_history_popup, BR_STRING_TODAY, NULL,
+					__clear_today_history_cb, this);
+	elm_ctxpopup_item_append(m_clear_history_popup, BR_STRING_DELETE_ALL, NULL,
+					__clear_all_history_cb, this);
 
-		m_no_history_label = elm_label_add(m_searchbar_layout);
-		if (!m_no_history_label) {
-			BROWSER_LOGE("elm_label_add failed");
+	/* Above the clear item, the first of the three controlbar items. */
+	int controlbar_x = 0;
+	int controlbar_y = 0;
+	int controlbar_w = 0;
+	int controlbar_h = 0;
+	evas_object_geometry_get(control_bar, &controlbar_x, &controlbar_y, &controlbar_w, &controlbar_h);
+
+	evas_object_move(m_clear_history_popup, controlbar_x + controlbar_w / 6, controlbar_y + (controlbar_h / 2));
+	evas_object_show(m_clear_history_popup);
+
+	return EINA_TRUE;
+}
+
+void Browser_History_Layout::_destroy_clear_history_popup(void)
+{
+	if (m_clear_history_popup) {
+		evas_object_del(m_clear_history_popup);
+		m_clear_history_popup = NULL;
+	}
+}
+
+void Browser_History_Layout::_clear_history_since(time_t from)
+{
+	BROWSER_LOGD("from=%ld", (long)from);
+	_destroy_clear_history_popup();
+
+	/* The visits of the range are read back from the visit log, the addresses
+	  * with no visit left are deleted and the others are dated by their last one. */
+	Browser_History_DB *history_db = m_data_manager->get_history_db();
+	if (from) {
+		if (!history_db->delete_history_by_time(from, time(NULL) + 1)) {
+			BROWSER_LOGE("delete_history_by_time failed");
 			return;
 		}
+	} else if (!history_db->clear_history()) {
+		BROWSER_LOGE("clear_history failed");
+		return;
+	}
 
-		std::string text = std::string("<color='#646464'>") + std::string(BR_STRING_NO_HISTORY);
-		elm_object_text_set(m_no_history_label, text.c_str());
-		evas_object_show(m_no_history_label);
-		elm_box_pack_start(m_content_box, m_no_history_label);
+	_reload_history_genlist();
 
-		Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
-		if (!bookmark_view->_set_controlbar_type(Browser_Bookmark_View::HISTORY_VIEW_DEFAULT))
-			BROWSER_LOGE("_set_controlbar_type failed");
-		elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_TRUE);
-	} else {
-		elm_box_pack_start(m_content_box, m_history_genlist);
-		evas_object_show(m_history_genlist);
+	show_notify_popup(BR_STRING_DELETED, 3, EINA_TRUE);
+}
 
-		Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
-		elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_FALSE);
+void Browser_History_Layout::__clear_history_popup_dismissed_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+	history_layout->_destroy_clear_history_popup();
+}
+
+void Browser_History_Layout::__clear_last_hour_history_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+	history_layout->_clear_history_since(time(NULL) - 60 * 60);
+}
+
+void Browser_History_Layout::__clear_today_history_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+
+	/* Since the local midnight. */
+	time_t now = time(NULL);
+	struct tm local_time;
+	localtime_r(&now, &local_time);
+	local_time.tm_hour = 0;
+	local_time.tm_min = 0;
+	local_time.tm_sec = 0;
+	local_time.tm_isdst = -1;
+	history_layout->_clear_history_since(mktime(&local_time));
+}
+
+void Browser_History_Layout::__clear_all_history_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+	history_layout->_clear_history_since(0);
+}
+
+Eina_Bool Browser_History_Layout::_append_history_page(void)
+{
+	if (m_is_history_list_end || m_history_page_job_id)
+		return EINA_TRUE;
+
+	time_t before_visit_time = 0;
+	int before_id = 0;
+	if (m_history_list.size()) {
+		before_visit_time = m_history_list.back()->visit_time;
+		before_id = m_history_list.back()->id;
+	}
+
+	/* Read on the DB executor, the page is appended by __history_page_loaded_cb. */
+	Browser_History_DB *history_db = m_data_manager->get_history_db();
+	m_history_page_job_id = history_db->get_history_page_async(before_visit_time, before_id,
+						BROWSER_HISTORY_PAGE_SIZE, __history_page_loaded_cb, this);
+	if (m_history_page_job_id)
+		return EINA_TRUE;
+
+	BROWSER_LOGE("get_history_page_async failed, read the page here");
+	std::vector<Browser_History_DB::history_item *> page;
+	std::vector<Browser_History_DB::history_day_group> groups;
+	Eina_Bool ret = history_db->get_history_page(before_visit_time, before_id,
+						BROWSER_HISTORY_PAGE_SIZE, page, &groups);
+	_history_page_loaded(ret, page, groups);
+
+	return ret;
+}
+
+void Browser_History_Layout::__history_page_loaded_cb(Eina_Bool result,
+					std::vector<Browser_History_DB::history_item *> &list,
+					std::vector<Browser_History_DB::history_day_group> &groups, void *user_data)
+{
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)user_data;
+	history_layout->m_history_page_job_id = 0;
+	history_layout->_history_page_loaded(result, list, groups);
+}
+
+void Browser_History_Layout::_history_page_loaded(Eina_Bool result,
+					std::vector<Browser_History_DB::history_item *> &page,
+					std::vector<Browser_History_DB::history_day_group> &groups)
+{
+	BROWSER_LOGD("result=%d page count=%d", result, page.size());
+	if (!result) {
+		BROWSER_LOGE("get_history_page failed");
+		m_is_history_list_end = EINA_TRUE;
+		for(int i = 0 ; i < page.size() ; i++)
+			delete page[i];
+	} else if (!_append_history_items(page, groups))
+		BROWSER_LOGE("_append_history_items failed");
+
+	if (m_is_history_list_reloading) {
+		m_is_history_list_reloading = EINA_FALSE;
+		if (m_history_list.size()) {
+			elm_box_pack_start(m_content_box, m_history_genlist);
+			evas_object_show(m_history_genlist);
+
+			Browser_Bookmark_View *bookmark_view = m_data_manager->get_bookmark_view();
+			elm_object_item_disabled_set(bookmark_view->m_bookmark_edit_controlbar_item, EINA_FALSE);
+		}
+	}
+
+	if (m_history_list.size() == 0 && m_is_history_list_end)
+		_show_no_history();
+}
+
+Eina_Bool Browser_History_Layout::_append_history_items(std::vector<Browser_History_DB::history_item *> &page,
+					std::vector<Browser_History_DB::history_day_group> &groups)
+{
+	if (page.size() < BROWSER_HISTORY_PAGE_SIZE)
+		m_is_history_list_end = EINA_TRUE;
+
+	_read_favicons(page);
+
+	/* In edit mode, the items of a new page follow the select all check. */
+	Eina_Bool is_edit_mode = elm_genlist_decorate_mode_get(m_history_genlist);
+	Eina_Bool is_all_selected = EINA_FALSE;
+	if (is_edit_mode && m_edit_mode_select_all_check_button)
+		is_all_selected = elm_check_state_get(m_edit_mode_select_all_check_button);
+
+	/* The first group continues the last one of the previous page if it is the same day. */
+	for(int i = 0 ; i < groups.size() ; i++) {
+		if (m_last_day != groups[i].day) {
+			const char *label = m_date_labels.add(groups[i].day, "Today (%a, %b %d %Y)",
+								"Yesterday (%a, %b %d %Y)", "%a, %b %d %Y");
+			if (!label) {
+				BROWSER_LOGE("m_date_labels.add failed");
+				for(int j = groups[i].first_index ; j < page.size() ; j++)
+					delete page[j];
+				return EINA_FALSE;
+			}
+			m_last_day = groups[i].day;
+			m_last_date_group_item = elm_genlist_item_append(m_history_genlist, &m_history_group_title_class,
+							label, NULL, ELM_GENLIST_ITEM_GROUP, NULL, NULL);
+
+			elm_genlist_item_select_mode_set(m_last_date_group_item, ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY);
+		}
+
+		for(int j = groups[i].first_index ; j < groups[i].first_index + groups[i].count ; j++) {
+			page[j]->user_data = (void *)this;
+			if (is_edit_mode)
+				page[j]->is_delete = is_all_selected;
+			m_history_list.push_back(page[j]);
+
+			elm_genlist_item_append(m_history_genlist, &m_history_genlist_item_class, page[j],
+						m_last_date_group_item, ELM_GENLIST_ITEM_NONE, __history_item_clicked_cb, this);
+		}
 	}
+
+	return EINA_TRUE;
+}
+
+void Browser_History_Layout::_read_favicons(const vector<Browser_History_DB::history_item *> &list)
+{
+	/* One read for the whole list instead of a lookup in the icon database per realized item. */
+	std::vector<int> history_ids;
+	for(int i = 0 ; i < list.size() ; i++)
+		history_ids.push_back(list[i]->id);
+
+	if (!m_data_manager->get_history_db()->get_favicons(history_ids, m_favicons))
+		BROWSER_LOGE("get_favicons failed");
+}
+
+void Browser_History_Layout::__history_genlist_realized_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	if (!data)
+		return;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+	Elm_Object_Item *it = (Elm_Object_Item *)event_info;
+	if (history_layout->m_is_history_list_end || history_layout->m_append_history_page_idler
+	    || history_layout->m_history_page_job_id)
+		return;
+
+	/* Do not append to the genlist in the middle of its own callback. */
+	if (it == elm_genlist_last_item_get(obj))
+		history_layout->m_append_history_page_idler = ecore_idler_add(__append_history_page_idler_cb,
+										history_layout);
+}
+
+Eina_Bool Browser_History_Layout::__append_history_page_idler_cb(void *data)
+{
+	if (!data)
+		return ECORE_CALLBACK_CANCEL;
+
+	Browser_History_Layout *history_layout = (Browser_History_Layout *)data;
+	history_layout->m_append_history_page_idler = NULL;
+
+	if (!history_layout->_append_history_page())
+		BROWSER_LOGE("_append_history_page failed");
+
+	return ECORE_CALLBACK_CANCEL;
 }
 
 Eina_Bool Browser_History_Layout::_create_main_layout(void)
@@ -1179,6 +1223,7 @@ Eina_Bool Browser_History_Layout::_create_main_layout(void)
 		BROWSER_LOGE("_create_history_genlist failed");
 		return EINA_FALSE;
 	}
+	evas_object_smart_callback_add(m_history_genlist, "realized", __history_genlist_realized_cb, this);
 
 	m_history_genlist_item_class.decorate_item_style = "mode/slide2";
 	m_history_genlist_item_class.item_style = "dialogue/2text.2icon.3";
@@ -1313,38 +1358,10 @@ char *Browser_History_Layout::__genlist_date_label_get_cb(void *data, Evas_Objec
 	if (!data)
 		return NULL;
 
-	char *date_label = (char *)data;
-
-	if (!strncmp(part, "elm.text", strlen("elm.text"))) {
-		Date date;
-		char buffer[BROWSER_MAX_DATE_LEN] = {0, };
-
-		sscanf(date_label, "%d-%d-%d",
-			&date.year, &date.month, &date.day);
-//		BROWSER_LOGD("%d %d %d\n", date.day, date.month, date.year);
-		time_t raw_time;
-		struct tm *time_info;
-		time(&raw_time);
-		time_info = localtime(&raw_time);
-		int day_gap = -1;
-//		BROWSER_LOGD("\ncurrent time : %d %d %d\n", time_info->tm_mday, (time_info->tm_mon+1), (time_info->tm_year+1900));
-		if (time_info->tm_year == date.year -1900 && time_info->tm_mon == date.month - 1)
-			day_gap = time_info->tm_mday - date.day;
-		else {
-			time_info->tm_year = date.year - 1900;
-			time_info->tm_mon = date.month - 1;
-		}
-		time_info->tm_mday = date.day;
-		mktime(time_info);
+	/* The label is formatted by _append_history_page(), the genlist frees the copy. */
+	if (!strncmp(part, "elm.text", strlen("elm.text")))
+		return strdup((const char *)data);
 
-		if (day_gap == 0)
-			strftime (buffer, BROWSER_MAX_DATE_LEN, "Today (%a, %b %d %Y)", time_info);
-		else if (day_gap == 1)
-			strftime (buffer, 40, "Yesterday (%a, %b %d %Y)", time_info);
-		else
-			strftime (buffer, 40, "%a, %b %d %Y", time_info);
-		return strdup(buffer);
-	}
 	return NULL;
 }
 
@@ -1393,8 +1410,10 @@ void Browser_History_Layout::_delete_history_item_by_slide_button(Browser_Histor
 	BROWSER_LOGD("[%s]", __func__);
 	Browser_History_Layout *history_layout = (Browser_History_Layout *)(item->user_data);
 
+	/* item may be one of the deleted items below. */
+	int history_id = item->id;
 	int ret = EINA_TRUE;
-	ret = m_data_manager->get_history_db()->delete_history(item->id);
+	ret = m_data_manager->get_history_db()->delete_history(history_id);
 	if (!ret) {
 		BROWSER_LOGE("m_data_manager->get_history_db()->delete_history failed");
 		return;
@@ -1402,26 +1421,26 @@ void Browser_History_Layout::_delete_history_item_by_slide_button(Browser_Histor
 
 	elm_object_item_del(history_layout->m_current_sweep_item);
 
-	/* If the item is deleted in searched list, then delete it from original history genlist also. */
+	/* If the item is deleted in searched list, then delete it from original history genlist also.
+	  * The address is listed under every day it was visited on. */
 	Elm_Object_Item *it = elm_genlist_first_item_get(history_layout->m_history_genlist);
 	while (it) {
+		Elm_Object_Item *next_it = elm_genlist_item_next_get(it);
 		Browser_History_DB::history_item *item_data = NULL;
 		item_data = (Browser_History_DB::history_item *)elm_object_item_data_get(it);
 		if (item_data && (elm_genlist_item_select_mode_get(it) != ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY)) {
-			if (item_data->id == item->id) {
+			if (item_data->id == history_id)
 				elm_object_item_del(it);
-				break;
-			}
 		}
-		it = elm_genlist_item_next_get(it);
+		it = next_it;
 	}
 
-	for(int i = 0 ; i < history_layout->m_history_list.size() ; i++) {
-		if (history_layout->m_history_list[i]->id == item->id) {
+	for(int i = 0 ; i < history_layout->m_history_list.size() ; ) {
+		if (history_layout->m_history_list[i]->id == history_id) {
 			delete history_layout->m_history_list[i];
 			history_layout->m_history_list.erase(history_layout->m_history_list.begin() + i);
-			break;
-		}
+		} else
+			i++;
 	}
 
 	if (history_layout->m_history_list.size() == 0) {
@@ -1497,6 +1516,11 @@ void Browser_History_Layout::_delete_date_only_label_genlist_item(void)
 			if (!tmp_it || elm_genlist_item_select_mode_get(tmp_it) == ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY) {
 				tmp_it = it;
 				it = elm_genlist_item_next_get(it);
+				/* The next page must not append to a deleted date label. */
+				if (tmp_it == m_last_date_group_item) {
+					m_last_day = 0;
+					m_last_date_group_item = NULL;
+				}
 				elm_object_item_del(tmp_it);
 				continue;
 			}
@@ -1533,12 +1557,17 @@ void Browser_History_Layout::__bookmark_on_off_icon_clicked_cb(void* data, Evas*
 		if (!elm_icon_file_set(obj, BROWSER_IMAGE_DIR"/I01_icon_bookmark_off.png", NULL)) {
 			BROWSER_LOGE("elm_icon_file_set is failed.\n");
 		}
-		m_data_manager->get_bookmark_view()->delete_bookmark_item(bookmark_id);
+		if (!m_data_manager->get_bookmark_db()->delete_bookmark(bookmark_id))
+			BROWSER_LOGE("delete_bookmark failed");
 	} else {
 		if (!elm_icon_file_set(obj, BROWSER_IMAGE_DIR"/I01_icon_bookmark_on.png", NULL)) {
 			BROWSER_LOGE("elm_icon_file_set is failed.\n");
 		}
-		m_data_manager->get_bookmark_view()->append_bookmark_item(item->title.c_str(), item->url.c_str());
+		if (!m_data_manager->get_bookmark_db()->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID,
+							item->title.c_str(), item->url.c_str()))
+			BROWSER_LOGE("save_bookmark failed");
+		else if (!m_data_manager->get_browser_view()->save_bookmark_favicon(item->url.c_str()))
+			BROWSER_LOGD("no favicon for [%s]", item->url.c_str());
 	}
 }
 
@@ -1554,7 +1583,9 @@ Evas_Object *Browser_History_Layout::__genlist_icon_get_cb(void *data, Evas_Obje
 
 	if (!strncmp(part, "elm.icon.1", strlen("elm.icon.1"))) {
 		Evas_Object *favicon = NULL;
-		favicon = m_data_manager->get_browser_view()->get_favicon(item->url.c_str());
+		std::map<int, Browser_Favicon>::iterator it = history_layout->m_favicons.find(item->id);
+		if (it != history_layout->m_favicons.end())
+			favicon = Browser_View::create_favicon(it->second, obj);
 		if (favicon)
 			return favicon;
 		else {
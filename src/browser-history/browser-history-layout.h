@@ -24,17 +24,20 @@
 #include "browser-history-db.h"
 #include "browser-bookmark-view.h"
 
-class Date {
+/* The labels of the date group items of a history genlist, formatted once per day
+  * into blocks of BROWSER_DATE_LABEL_BLOCK_SIZE, which are all freed by clear(). */
+class Date_Label_Arena {
 public:
-	int year;
-	int month;
-	int day;
-
-	Date();
-	Date(Date &date);
-	void operator=(Date &date);
-	bool operator==(Date &date);
-	bool operator!=(Date &date);
+	Date_Label_Arena(void);
+	~Date_Label_Arena(void);
+
+	/* day is a local midnight, the formats are for strftime().
+	  * Returns NULL on failure. */
+	const char *add(time_t day, const char *today_format, const char *yesterday_format, const char *format);
+	void clear(void);
+private:
+	vector<char *> m_blocks;
+	int m_block_used;
 };
 
 class Browser_History_Layout : public Browser_Common_View {
@@ -49,23 +52,30 @@ protected:
 	void _set_edit_mode(Eina_Bool edit_mode);
 
 private:
-	typedef struct _history_date_param {
-		Date date;
-		Browser_History_Layout *history_layout;
-	} history_date_param;
-
 	Eina_Bool _create_main_layout(void);
 	Evas_Object *_create_history_genlist(void);
 	void _reload_history_genlist(void);
+	Eina_Bool _append_history_page(void);
+	void _history_page_loaded(Eina_Bool result, std::vector<Browser_History_DB::history_item *> &page,
+				std::vector<Browser_History_DB::history_day_group> &groups);
+	Eina_Bool _append_history_items(std::vector<Browser_History_DB::history_item *> &page,
+				std::vector<Browser_History_DB::history_day_group> &groups);
+	void _show_no_history(void);
+	/* Reads the icons of the items of list into m_favicons. */
+	void _read_favicons(const vector<Browser_History_DB::history_item *> &list);
 	void _show_selection_info(void);
 	void _delete_selected_history(void);
 	Evas_Object *_show_delete_confirm_popup(void);
 	void _delete_history_item_by_slide_button(Browser_History_DB::history_item *item);
 	void _show_select_processing_popup(void);
-	void _show_delete_processing_popup(void);
 	void _enable_searchbar_layout(Eina_Bool enable);
 	Eina_Bool _show_searched_history(const char *search_text);
 	void _delete_date_only_label_genlist_item(void);
+	/* The clear menu of the history controlbar, the visits since the last hour, today or all of them. */
+	Eina_Bool _show_clear_history_popup(Evas_Object *control_bar);
+	void _destroy_clear_history_popup(void);
+	/* 0 from clears the whole history. */
+	void _clear_history_since(time_t from);
 
 	/* elementary event callback functions. */
 #if defined(GENLIST_SWEEP)
@@ -74,6 +84,7 @@ private:
 	static void __sweep_cancel_genlist_cb(void *data, Evas_Object *obj, void *event_info);
 #endif
 	static void __history_item_clicked_cb(void *data, Evas_Object *obj, void *eventInfo);
+	static void __history_genlist_realized_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __edit_mode_item_check_changed_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __edit_mode_select_all_check_changed_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __slide_add_to_bookmark_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
@@ -83,8 +94,11 @@ private:
 	static void __delete_confirm_response_by_slide_button_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __cancel_confirm_response_by_slide_button_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __select_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info);
-	static void __delete_processing_popup_response_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __search_delay_changed_cb(void *data, Evas_Object *obj, void *event_info);
+	static void __clear_history_popup_dismissed_cb(void *data, Evas_Object *obj, void *event_info);
+	static void __clear_last_hour_history_cb(void *data, Evas_Object *obj, void *event_info);
+	static void __clear_today_history_cb(void *data, Evas_Object *obj, void *event_info);
+	static void __clear_all_history_cb(void *data, Evas_Object *obj, void *event_info);
 
 	static void __bookmark_on_off_icon_clicked_cb(void* data, Evas* evas, Evas_Object* obj, void* ev);
 
@@ -98,9 +112,14 @@ private:
 
 	/* ecore timer callback functions */
 	static Eina_Bool __select_processing_popup_timer_cb(void *data);
-	static Eina_Bool __delete_processing_popup_timer_cb(void *data);
 
-	history_date_param m_date_param;
+	/* ecore idler callback functions */
+	static Eina_Bool __append_history_page_idler_cb(void *data);
+
+	/* DB executor callback functions */
+	static void __history_page_loaded_cb(Eina_Bool result, std::vector<Browser_History_DB::history_item *> &list,
+				std::vector<Browser_History_DB::history_day_group> &groups, void *user_data);
+
 	Elm_Genlist_Item_Class m_history_genlist_item_class;
 	Elm_Genlist_Item_Class m_history_group_title_class;
 
@@ -118,10 +137,19 @@ private:
 	Evas_Object *m_no_history_label;
 
 	vector<Browser_History_DB::history_item *> m_history_list;
-	vector<char *> m_history_date_label_list;
+	Date_Label_Arena m_date_labels;
 	vector<Browser_History_DB::history_item *> m_searched_history_item_list;
-	vector<char *> m_searched_history_date_label_list;
-	Date m_last_date;
+	/* By item id, read with each page and search result. */
+	std::map<int, Browser_Favicon> m_favicons;
+	time_t m_last_day;
+	Elm_Object_Item *m_last_date_group_item;
+	/* The history is loaded one page at a time, when the end of the genlist is realized. */
+	Eina_Bool m_is_history_list_end;
+	Ecore_Idler *m_append_history_page_idler;
+	/* The page being read on the DB executor, 0 if none. */
+	int m_history_page_job_id;
+	/* The genlist is shown again once the first page is read. */
+	Eina_Bool m_is_history_list_reloading;
 
 	/* For select all processing popup. */
 	Evas_Object *m_processing_progress_bar;
@@ -134,6 +162,7 @@ private:
 	int m_total_item_count;
 
 	Evas_Object *m_delete_confirm_popup;
+	Evas_Object *m_clear_history_popup;
 	Eina_Bool m_is_bookmark_on_off_icon_clicked;
 };
 #endif /* BROWSER_HISTORY_LAYOUT_H */
@@ -17,6 +17,7 @@
 
 
 #include "browser-view.h"
+#include "browser-bookmark-db.h"
 #include "browser-data-manager.h"
 #include "browser-history-db.h"
 #include "browser-settings-clear-data-view.h"
@@ -646,6 +647,12 @@ char *Browser_Settings_Main_View::__genlist_label_get(void *data, Evas_Object *o
 	} else if (type == BR_MENU_USER_AGENT) {
 		if (!strncmp(part, "elm.text", strlen("elm.text")))
 			return strdup(BR_STRING_USER_AGENT);
+	} else if (type == BR_MENU_IMPORT_BOOKMARKS) {
+		if (!strncmp(part, "elm.text", strlen("elm.text")))
+			return strdup(BR_STRING_IMPORT_BOOKMARKS);
+	} else if (type == BR_MENU_EXPORT_BOOKMARKS) {
+		if (!strncmp(part, "elm.text", strlen("elm.text")))
+			return strdup(BR_STRING_EXPORT_BOOKMARKS);
 	} else if (type == BR_MENU_RESET_TO_DEFAULT) {
 		if (!strncmp(part, "elm.text", strlen("elm.text")))
 			return strdup(BR_STRING_RESET_TO_DEFAULT);
@@ -935,6 +942,10 @@ void Browser_Settings_Main_View::__genlist_item_clicked_cb(void *data, Evas_Obje
 	} else if (type == BR_MENU_USER_AGENT) {
 		if (!main_view->_call_user_agent())
 			BROWSER_LOGE("_call_user_agent failed");
+	} else if (type == BR_MENU_IMPORT_BOOKMARKS) {
+		main_view->_import_bookmarks();
+	} else if (type == BR_MENU_EXPORT_BOOKMARKS) {
+		main_view->_export_bookmarks();
 	} else if (type == BR_MENU_RESET_TO_DEFAULT) {
 		main_view->_show_reset_confirm_popup();
 	} else if (type == BR_PRIVACY_MENU_CLEAR_LOCATION_ACCESS) {
@@ -944,6 +955,56 @@ void Browser_Settings_Main_View::__genlist_item_clicked_cb(void *data, Evas_Obje
 	elm_genlist_item_selected_set(callback_data->it, EINA_FALSE);
 }
 
+void Browser_Settings_Main_View::_import_bookmarks(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	/* The bookmark db is kept if it is used by another view. */
+	Browser_Bookmark_DB *bookmark_db = m_data_manager->create_bookmark_db();
+	Eina_Bool is_created = bookmark_db ? EINA_TRUE : EINA_FALSE;
+	if (!bookmark_db)
+		bookmark_db = m_data_manager->get_bookmark_db();
+	if (!bookmark_db) {
+		BROWSER_LOGE("create_bookmark_db failed");
+		return;
+	}
+
+	int imported_count = 0;
+	if (bookmark_db->import_bookmarks(BROWSER_BOOKMARK_HTML_FILE_PATH, &imported_count)) {
+		BROWSER_LOGD("%d bookmarks imported", imported_count);
+		show_notify_popup(BR_STRING_ADDED_TO_BOOKMARKS, 3, EINA_TRUE);
+	} else {
+		BROWSER_LOGE("import_bookmarks failed");
+		show_notify_popup(BR_STRING_FAILED, 3, EINA_TRUE);
+	}
+
+	if (is_created)
+		m_data_manager->destroy_bookmark_db();
+}
+
+void Browser_Settings_Main_View::_export_bookmarks(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	/* The bookmark db is kept if it is used by another view. */
+	Browser_Bookmark_DB *bookmark_db = m_data_manager->create_bookmark_db();
+	Eina_Bool is_created = bookmark_db ? EINA_TRUE : EINA_FALSE;
+	if (!bookmark_db)
+		bookmark_db = m_data_manager->get_bookmark_db();
+	if (!bookmark_db) {
+		BROWSER_LOGE("create_bookmark_db failed");
+		return;
+	}
+
+	if (bookmark_db->export_bookmarks(BROWSER_BOOKMARK_HTML_FILE_PATH))
+		show_notify_popup(BR_STRING_SAVED, 3, EINA_TRUE);
+	else {
+		BROWSER_LOGE("export_bookmarks failed");
+		show_notify_popup(BR_STRING_FAILED, 3, EINA_TRUE);
+	}
+
+	if (is_created)
+		m_data_manager->destroy_bookmark_db();
+}
+
 void Browser_Settings_Main_View::_reset_settings(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -1479,6 +1540,18 @@ Evas_Object *Browser_Settings_Main_View::_create_content_genlist(void)
 							&m_website_setting_callback_data, NULL, ELM_GENLIST_ITEM_NONE,
 							__genlist_item_clicked_cb, &m_website_setting_callback_data);
 
+	m_import_bookmarks_item_callback_data.type = BR_MENU_IMPORT_BOOKMARKS;
+	m_import_bookmarks_item_callback_data.user_data = this;
+	m_import_bookmarks_item_callback_data.it = elm_genlist_item_append(genlist, &m_1_text_item_class,
+							&m_import_bookmarks_item_callback_data, NULL, ELM_GENLIST_ITEM_NONE,
+							__genlist_item_clicked_cb, &m_import_bookmarks_item_callback_data);
+
+	m_export_bookmarks_item_callback_data.type = BR_MENU_EXPORT_BOOKMARKS;
+	m_export_bookmarks_item_callback_data.user_data = this;
+	m_export_bookmarks_item_callback_data.it = elm_genlist_item_append(genlist, &m_1_text_item_class,
+							&m_export_bookmarks_item_callback_data, NULL, ELM_GENLIST_ITEM_NONE,
+							__genlist_item_clicked_cb, &m_export_bookmarks_item_callback_data);
+
 	m_reset_item_callback_data.type = BR_MENU_RESET_TO_DEFAULT;
 	m_reset_item_callback_data.user_data = this;
 	m_reset_item_callback_data.it = elm_genlist_item_append(genlist, &m_1_text_item_class,
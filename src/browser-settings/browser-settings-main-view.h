@@ -61,12 +61,14 @@ public:
 		BR_PRIVACY_MENU_ENABLE_LOCATION,
 		BR_PRIVACY_MENU_CLEAR_LOCATION_ACCESS,
 		BR_MENU_CERTIFICATES,
+		BR_MENU_IMPORT_BOOKMARKS,
+		BR_MENU_EXPORT_BOOKMARKS,
 		BR_MENU_RESET_TO_DEFAULT,
 		BR_DEBUG_TITLE,
 		BR_MENU_USER_AGENT,
 		BR_MENU_UNKNOWN
 	}menu_type;
-
+
 	Browser_Settings_Main_View(void);
 	~Browser_Settings_Main_View(void);
 
@@ -84,6 +86,9 @@ private:
 	Eina_Bool _call_user_agent(void);
 	Eina_Bool _show_reset_confirm_popup(void);
 	void _reset_settings(void);
+	/* From and to BROWSER_BOOKMARK_HTML_FILE_PATH. */
+	void _import_bookmarks(void);
+	void _export_bookmarks(void);
 
 	Eina_Bool _show_clear_cache_confirm_popup(void);
 	Eina_Bool _show_clear_history_confirm_popup(void);
@@ -185,6 +190,8 @@ private:
 	genlist_callback_data m_clear_location_access_callback_data;
 
 	/* Others */
+	genlist_callback_data m_import_bookmarks_item_callback_data;
+	genlist_callback_data m_export_bookmarks_item_callback_data;
 	genlist_callback_data m_reset_item_callback_data;
 
 	/* Debug */
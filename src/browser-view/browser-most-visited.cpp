@@ -289,6 +289,13 @@ Eina_Bool Browser_Most_Visited::_update_items(void)
 		return EINA_FALSE;
 	}
 
+	std::vector<int> history_ids;
+	for (int i = 0 ; i < most_visited_list.size() ; i++)
+		history_ids.push_back(most_visited_list[i].id);
+	std::map<int, Browser_Favicon> favicons;
+	if (!m_history_db->get_favicons(history_ids, favicons))
+		BROWSER_LOGE("m_history_db->get_favicons failed");
+
 	for (int i = 0 ; i < most_visited_list.size() ; i++) {
 		most_visited_item *item = new(nothrow) most_visited_item;
 		if (!item) {
@@ -337,7 +344,9 @@ Eina_Bool Browser_Most_Visited::_update_items(void)
 								__item_mouse_up_cb, this);
 		evas_object_show(item->item_button);
 
-		item->favicon = m_browser_view->get_favicon(item->url.c_str());
+		std::map<int, Browser_Favicon>::iterator it = favicons.find(most_visited_list[i].id);
+		if (it != favicons.end())
+			item->favicon = Browser_View::create_favicon(it->second, m_navi_bar);
 		if (!item->favicon) {
 			item->favicon = elm_icon_add(m_navi_bar);
 			if (!item->favicon) {
@@ -30,6 +30,7 @@
 #include "most-visited-sites-db.h"
 #endif
 #include "browser-string.h"
+#include "browser-url-key.h"
 #include "browser-view.h"
 #include "browser-window.h"
 #include <devman.h>
@@ -82,6 +83,7 @@ Browser_View::Browser_View(Evas_Object *win, Evas_Object *navi_bar, Evas_Object
 #if defined(FEATURE_MOST_VISITED_SITES)
 	,m_most_visited_sites(NULL)
 	,m_most_visited_sites_db(NULL)
+	,m_capture_most_visited_sites_job_id(0)
 #endif
 	,m_new_window_transit(NULL)
 	,m_created_new_window(NULL)
@@ -117,6 +119,9 @@ Browser_View::Browser_View(Evas_Object *win, Evas_Object *navi_bar, Evas_Object
 	,m_high_seg_it(NULL)
 	,m_vibration_device_handle_id(-1)
 	,m_is_multi_window_grid_mode(EINA_FALSE)
+	,m_is_typed_url(EINA_FALSE)
+	,m_predictive_history_layout(NULL)
+	,m_predictive_history_genlist(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 	m_win = win;
@@ -143,6 +148,8 @@ Browser_View::~Browser_View()
 		m_data_manager = NULL;
 	}
 #if defined(FEATURE_MOST_VISITED_SITES)
+	if (m_capture_most_visited_sites_job_id && Browser_DB_Executor::has_instance())
+		Browser_DB_Executor::get_instance()->cancel(m_capture_most_visited_sites_job_id);
 	if (m_most_visited_sites) {
 		delete m_most_visited_sites;
 		m_most_visited_sites = NULL;
@@ -188,6 +195,10 @@ Browser_View::~Browser_View()
 		m_zoom_button_timer = NULL;
 	}
 #endif
+	if (m_predictive_history_layout) {
+		evas_object_del(m_predictive_history_layout);
+		m_predictive_history_layout = NULL;
+	}
 }
 
 Eina_Bool Browser_View::init(void)
@@ -481,6 +492,50 @@ Evas_Object *Browser_View::get_favicon(const char *url)
 	return favicon;
 }
 
+Eina_Bool Browser_View::get_favicon(const char *url, Browser_Favicon &favicon)
+{
+	Evas_Object *icon = get_favicon(url);
+	if (!icon)
+		return EINA_FALSE;
+
+	int width = 0;
+	int height = 0;
+	evas_object_image_size_get(icon, &width, &height);
+	const unsigned int *pixels = (const unsigned int *)evas_object_image_data_get(icon, EINA_FALSE);
+	Eina_Bool ret = favicon.set_pixels(pixels, width, height, evas_object_image_stride_get(icon));
+	evas_object_del(icon);
+
+	return ret;
+}
+
+Evas_Object *Browser_View::create_favicon(const Browser_Favicon &favicon, Evas_Object *parent)
+{
+	if (favicon.is_empty() || !parent)
+		return NULL;
+
+	Evas_Object *image = evas_object_image_filled_add(evas_object_evas_get(parent));
+	if (!image) {
+		BROWSER_LOGE("evas_object_image_filled_add failed");
+		return NULL;
+	}
+
+	evas_object_image_alpha_set(image, EINA_TRUE);
+	evas_object_image_size_set(image, favicon.get_width(), favicon.get_height());
+	evas_object_image_data_copy_set(image, (void *)favicon.get_pixels());
+	evas_object_image_data_update_add(image, 0, 0, favicon.get_width(), favicon.get_height());
+
+	return image;
+}
+
+Eina_Bool Browser_View::save_bookmark_favicon(const char *url)
+{
+	Browser_Favicon favicon;
+	if (!get_favicon(url, favicon))
+		return EINA_FALSE;
+
+	return Browser_Bookmark_DB::save_favicon(url, favicon);
+}
+
 Eina_Bool Browser_View::_set_favicon(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -1076,10 +1131,10 @@ Eina_Bool Browser_View::_capture_most_visited_sites_item_screen_shot(void)
 		return EINA_FALSE;
 	}
 
+	sqlite3_int64 current_url_key = br_url_key(current_url.c_str());
 	for (int i = 0 ; i < most_visited_sites_list.size() ; i++) {
 		if (!current_url.empty() && !most_visited_sites_list[i].url.empty()
-		     && (current_url.length() == most_visited_sites_list[i].url.length())
-		     && !strncmp(most_visited_sites_list[i].url.c_str(), current_url.c_str(), current_url.length())) {
+		     && br_url_key(most_visited_sites_list[i].url.c_str()) == current_url_key) {
 			is_ranked = EINA_TRUE;
 			screen_shot_path = std::string(BROWSER_SCREEN_SHOT_DIR)
 							+ most_visited_sites_list[i].id;
@@ -1182,6 +1237,18 @@ Eina_Bool Browser_View::__capture_most_visited_sites_screen_shot_idler_cb(void *
 
 	return ECORE_CALLBACK_CANCEL;
 }
+
+void Browser_View::__capture_most_visited_sites_visits_flushed_cb(void *data)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_View *browser_view = (Browser_View *)data;
+	browser_view->m_capture_most_visited_sites_job_id = 0;
+	if (!browser_view->_capture_most_visited_sites_item_screen_shot())
+		BROWSER_LOGE("_capture_most_visited_sites_item_screen_shot failed");
+}
 #endif
 
 void Browser_View::_load_finished(void)
@@ -1201,17 +1268,36 @@ void Browser_View::_load_finished(void)
 	/* Save last visited url to save this when browser exits. */
 	m_last_visited_url = get_url();
 
-	if (m_data_manager->get_history_db() && !m_is_private) {
+	/* In private mode the history db keeps the visit in memory only. */
+	if (m_data_manager->get_history_db()) {
+		Eina_Bool is_bookmarked = m_data_manager->get_history_db()->is_in_bookmark(m_last_visited_url.c_str(), NULL);
 		m_data_manager->get_history_db()->save_history(m_last_visited_url.c_str(),
-							get_title().c_str(), &is_full);
+							get_title().c_str(), &is_full, m_is_typed_url, is_bookmarked);
 		if (is_full)
 			BROWSER_LOGE("history is full, delete the first one");
+
+		/* The lists read the icons from the tables, they are written once per load here. */
+		Browser_Favicon favicon;
+		if (!m_is_private && get_favicon(m_last_visited_url.c_str(), favicon)) {
+			if (!m_data_manager->get_history_db()->save_favicon(m_last_visited_url.c_str(), favicon))
+				BROWSER_LOGE("save_favicon failed");
+			if (is_bookmarked && !Browser_Bookmark_DB::save_favicon(m_last_visited_url.c_str(), favicon))
+				BROWSER_LOGE("save_favicon failed");
+		}
 	}
+	m_is_typed_url = EINA_FALSE;
 
 	_hide_scroller_url_layout();
 
 #if defined(FEATURE_MOST_VISITED_SITES)
-	ecore_idler_add(__capture_most_visited_sites_screen_shot_idler_cb, this);
+	/* The capture looks up the visit saved above, so it waits until the DB executor has written it
+	  * instead of writing it on the main loop. */
+	if (m_capture_most_visited_sites_job_id)
+		Browser_DB_Executor::get_instance()->cancel(m_capture_most_visited_sites_job_id);
+	m_capture_most_visited_sites_job_id = Browser_History_DB::flush_visits_async(
+					__capture_most_visited_sites_visits_flushed_cb, this);
+	if (!m_capture_most_visited_sites_job_id)
+		ecore_idler_add(__capture_most_visited_sites_screen_shot_idler_cb, this);
 #endif
 
 	elm_object_focus_set(m_option_header_cancel_button, EINA_TRUE);
@@ -2034,6 +2120,7 @@ void Browser_View::__private_cb(void *data, Evas_Object *obj, void *event_info)
 
 	Ewk_Setting *setting = ewk_view_setting_get(browser_view->m_focused_window->m_ewk_view);
 	ewk_setting_private_browsing_set(setting, browser_view->m_is_private);
+	Browser_History_DB::set_private_mode(browser_view->m_is_private);
 }
 
 void Browser_View::__bookmark_cb(void *data, Evas_Object *obj, void *event_info)
@@ -2049,8 +2136,9 @@ void Browser_View::__bookmark_cb(void *data, Evas_Object *obj, void *event_info)
 			BROWSER_LOGE("elm_icon_file_set is failed.\n");
 			return;
 		}
-		m_data_manager->create_bookmark_db()->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID,
-					browser_view->get_title().c_str(), browser_view->get_url().c_str());
+		if (m_data_manager->create_bookmark_db()->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID,
+					browser_view->get_title().c_str(), browser_view->get_url().c_str()))
+			browser_view->save_bookmark_favicon(browser_view->get_url().c_str());
 		browser_view->show_notify_popup(BR_STRING_ADDED_TO_BOOKMARKS, 3, EINA_TRUE);
 	} else {
 		if (!elm_icon_file_set(browser_view->m_bookmark_on_off_icon, BROWSER_IMAGE_DIR"/I01_icon_bookmark_off.png", NULL)) {
@@ -2099,6 +2187,7 @@ void Browser_View::__private_check_change_cb(void *data, Evas_Object *obj, void
 
 	Ewk_Setting *setting = ewk_view_setting_get(browser_view->m_focused_window->m_ewk_view);
 	ewk_setting_private_browsing_set(setting, browser_view->m_is_private);
+	Browser_History_DB::set_private_mode(browser_view->m_is_private);
 }
 
 void Browser_View::__expand_option_header_cb(void *data, Evas_Object *obj, void *event_info)
@@ -2901,7 +2990,17 @@ void Browser_View::_set_edit_mode(edit_mode mode)
 		elm_scroller_region_show(m_scroller ,scroller_x, 0, scroller_w, scroller_h);
 	}
 
+	if (mode != BR_URL_ENTRY_EDIT_MODE) {
+		evas_object_smart_callback_del(br_elm_editfield_entry_get(_get_activated_url_entry()),
+							"changed", __url_entry_changed_cb);
+		_hide_predictive_history();
+	}
+
 	if (mode == BR_URL_ENTRY_EDIT_MODE) {
+		Evas_Object *url_entry = br_elm_editfield_entry_get(_get_activated_url_entry());
+		evas_object_smart_callback_del(url_entry, "changed", __url_entry_changed_cb);
+		evas_object_smart_callback_add(url_entry, "changed", __url_entry_changed_cb, this);
+
 		/* change layout of url layout for edit mode. */
 		edje_object_signal_emit(elm_layout_edje_get(m_url_layout), "edit,url,on,signal", "");
 		edje_object_signal_emit(elm_layout_edje_get(m_option_header_url_layout),
@@ -3081,6 +3180,7 @@ void Browser_View::__url_entry_enter_key_cb(void *data, Evas_Object *obj, void *
 	BROWSER_LOGD("input url = [%s]", url);
 
 	if (url && strlen(url)) {
+		browser_view->m_is_typed_url = EINA_TRUE;
 		browser_view->load_url(url);
 		free(url);
 	}
@@ -3090,6 +3190,125 @@ void Browser_View::__url_entry_enter_key_cb(void *data, Evas_Object *obj, void *
 void Browser_View::__url_entry_changed_cb(void *data, Evas_Object *obj, void *event_info)
 {
 	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_View *browser_view = (Browser_View *)data;
+	if (browser_view->_get_edit_mode() != BR_URL_ENTRY_EDIT_MODE)
+		return;
+
+	char *url = elm_entry_markup_to_utf8(elm_entry_entry_get(obj));
+	if (!browser_view->_show_predictive_history(url))
+		BROWSER_LOGE("_show_predictive_history failed");
+
+	if (url)
+		free(url);
+}
+
+char *Browser_View::__predictive_history_label_get_cb(void *data, Evas_Object *obj, const char *part)
+{
+	if (!data)
+		return NULL;
+
+	if (!strncmp(part, "elm.text", strlen("elm.text")))
+		return strdup((const char *)data);
+
+	return NULL;
+}
+
+void Browser_View::__predictive_history_item_clicked_cb(void *data, Evas_Object *obj, void *event_info)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!data)
+		return;
+
+	Browser_View *browser_view = (Browser_View *)data;
+	Elm_Object_Item *it = (Elm_Object_Item *)event_info;
+	const char *selected_url = (const char *)elm_object_item_data_get(it);
+	if (!selected_url)
+		return;
+
+	/* The list is cleared by _hide_predictive_history. */
+	std::string url = std::string(selected_url);
+	browser_view->_hide_predictive_history();
+
+	Evas_Object *edit_field_entry = br_elm_editfield_entry_get(browser_view->_get_activated_url_entry());
+	evas_object_smart_callback_del(edit_field_entry, "changed", __url_entry_changed_cb);
+	elm_entry_entry_set(edit_field_entry, url.c_str());
+
+	__url_entry_enter_key_cb(browser_view, obj, NULL);
+}
+
+Eina_Bool Browser_View::_show_predictive_history(const char *url)
+{
+	BROWSER_LOGD("url = [%s]", url);
+	if (m_predictive_history_genlist)
+		elm_genlist_clear(m_predictive_history_genlist);
+	m_predictive_history_list.clear();
+
+	/* In private mode the addresses of the private session are suggested first. */
+	if (url && strlen(url) && m_data_manager->get_history_db()) {
+		if (!m_data_manager->get_history_db()->get_history_list_by_partial_url(url,
+					BROWSER_PREDICTIVE_HISTORY_COUNT, m_predictive_history_list))
+			BROWSER_LOGE("get_history_list_by_partial_url failed");
+	}
+
+	if (m_predictive_history_list.empty()) {
+		_hide_predictive_history();
+		return EINA_TRUE;
+	}
+
+	if (!m_predictive_history_layout) {
+		m_predictive_history_layout = elm_layout_add(m_main_layout);
+		if (!m_predictive_history_layout) {
+			BROWSER_LOGE("elm_layout_add failed");
+			return EINA_FALSE;
+		}
+		if (!elm_layout_file_set(m_predictive_history_layout, BROWSER_PREDICTIVE_HISTORY_THEME,
+					"browser/predictive-history")) {
+			BROWSER_LOGE("elm_layout_file_set failed");
+			evas_object_del(m_predictive_history_layout);
+			m_predictive_history_layout = NULL;
+			return EINA_FALSE;
+		}
+
+		m_predictive_history_genlist = elm_genlist_add(m_predictive_history_layout);
+		if (!m_predictive_history_genlist) {
+			BROWSER_LOGE("elm_genlist_add failed");
+			evas_object_del(m_predictive_history_layout);
+			m_predictive_history_layout = NULL;
+			return EINA_FALSE;
+		}
+		elm_object_part_content_set(m_predictive_history_layout, "elm.swallow.predictive_history_genlist",
+						m_predictive_history_genlist);
+		elm_object_part_content_set(m_main_layout, "elm.swallow.predictive_history", m_predictive_history_layout);
+
+		m_predictive_history_item_class.item_style = "browser/1text";
+		m_predictive_history_item_class.func.text_get = __predictive_history_label_get_cb;
+		m_predictive_history_item_class.func.content_get = NULL;
+		m_predictive_history_item_class.func.state_get = NULL;
+		m_predictive_history_item_class.func.del = NULL;
+	}
+
+	for (int i = 0 ; i < m_predictive_history_list.size() ; i++) {
+		elm_genlist_item_append(m_predictive_history_genlist, &m_predictive_history_item_class,
+					m_predictive_history_list[i].c_str(), NULL, ELM_GENLIST_ITEM_NONE,
+					__predictive_history_item_clicked_cb, this);
+	}
+
+	edje_object_signal_emit(elm_layout_edje_get(m_main_layout), "show,predictive_history,signal", "");
+
+	return EINA_TRUE;
+}
+
+void Browser_View::_hide_predictive_history(void)
+{
+	if (!m_predictive_history_layout)
+		return;
+
+	elm_genlist_clear(m_predictive_history_genlist);
+	m_predictive_history_list.clear();
+	edje_object_signal_emit(elm_layout_edje_get(m_main_layout), "hide,predictive_history,signal", "");
 }
 
 void Browser_View::__url_layout_mouse_down_cb(void *data, Evas* evas, Evas_Object *obj,
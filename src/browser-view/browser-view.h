@@ -20,6 +20,7 @@
 
 #include "browser-common-view.h"
 #include "browser-config.h"
+#include "browser-favicon.h"
 #if defined(FEATURE_MOST_VISITED_SITES)
 #include "browser-most-visited.h"
 #include "most-visited-sites-db.h"
@@ -87,6 +88,12 @@ public:
 	Eina_Bool is_most_visited_sites_running(void);
 #endif
 	Evas_Object *get_favicon(const char *url);
+	/* The icon of url in the WebKit icon database, scaled down for the history and bookmark tables. */
+	Eina_Bool get_favicon(const char *url, Browser_Favicon &favicon);
+	/* An image of an icon read from the history or bookmark table, the lists use it instead of the icon database. */
+	static Evas_Object *create_favicon(const Browser_Favicon &favicon, Evas_Object *parent);
+	/* Stores the icon of url for the bookmarks of its host, when a bookmark has been added. */
+	Eina_Bool save_bookmark_favicon(const char *url);
 	void delete_non_user_created_windows(void);
 	Eina_Bool _is_loading(void);
 	Eina_Bool launch_find_word_with_text(const char *text_to_find);
@@ -138,6 +145,8 @@ private:
 	static Eina_Bool __webview_layout_resize_idler_cb(void *data);
 #if defined(FEATURE_MOST_VISITED_SITES)
 	static Eina_Bool __capture_most_visited_sites_screen_shot_idler_cb(void *data);
+	/* DB executor callback functions */
+	static void __capture_most_visited_sites_visits_flushed_cb(void *data);
 #endif
 	static Eina_Bool __close_window_idler_cb(void *data);
 	static Eina_Bool __scroller_bring_in_idler_cb(void *data);
@@ -182,6 +191,8 @@ private:
 	static void __more_context_popup_dismissed_cb(void *data, Evas_Object *obj,
 									void *event_info);
 	static void __url_entry_changed_cb(void *data, Evas_Object *obj, void *event_info);
+	static char *__predictive_history_label_get_cb(void *data, Evas_Object *obj, const char *part);
+	static void __predictive_history_item_clicked_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __internet_settings_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __find_word_cb(void *data, Evas_Object *obj, void *event_info);
 	static void __find_word_cancel_button_clicked_cb(void *data, Evas_Object *obj, void *event_info);
@@ -267,6 +278,8 @@ private:
 	Evas_Object *_create_brightness_control_bar(void);
 	Eina_Bool _show_brightness_layout(void);
 	void _destroy_brightness_layout(void);
+	Eina_Bool _show_predictive_history(const char *url);
+	void _hide_predictive_history(void);
 
 	Evas_Object *m_main_layout;
 	Evas_Object *m_scroller;
@@ -322,6 +335,8 @@ private:
 #if defined(FEATURE_MOST_VISITED_SITES)
 	Most_Visited_Sites *m_most_visited_sites;
 	Most_Visited_Sites_DB *m_most_visited_sites_db;
+	/* The capture waits for the visit of the page to be written, 0 if it does not. */
+	int m_capture_most_visited_sites_job_id;
 	/* To update the clicked most visited sites item info such as snapshot, url, title. */
 	Most_Visited_Sites_DB::most_visited_sites_entry m_selected_most_visited_sites_item_info;
 #endif
@@ -331,6 +346,8 @@ private:
 	Browser_Window *m_created_new_window;
 
 	std::string m_last_visited_url;
+	/* The next page was entered in the url entry, it is saved to history with a typed bonus. */
+	Eina_Bool m_is_typed_url;
 
 	Elm_Object_Item *m_navi_it;
 	Browser_Find_Word *m_find_word;
@@ -371,6 +388,12 @@ private:
 	int m_vibration_device_handle_id;
 
 	Eina_Bool m_is_multi_window_grid_mode;
+
+	/* history suggestions under the url entry while typing */
+	Evas_Object *m_predictive_history_layout;
+	Evas_Object *m_predictive_history_genlist;
+	Elm_Genlist_Item_Class m_predictive_history_item_class;
+	std::vector<std::string> m_predictive_history_list;
 };
 #endif /* BROWSER_VIEW_H */
 
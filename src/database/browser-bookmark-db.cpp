@@ -20,12 +20,28 @@ using namespace std;
 
 #include "browser-bookmark-db.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
+
 #define BOOKMARK_NORMAL	0
 #define BOOKMARK_FOLDER 1
 
-sqlite3* Browser_Bookmark_DB::m_db_descriptor = NULL;
+struct Browser_Bookmark_DB::title_length_compare {
+	bool operator()(const std::string &a, const std::string &b) const
+	{
+		if (a.length() != b.length())
+			return a.length() < b.length();
+		return a < b;
+	}
+};
+
+Browser_Bookmark_Url_Set Browser_Bookmark_DB::m_url_set;
+Browser_Bookmark_Tree Browser_Bookmark_DB::m_tree;
 
 Browser_Bookmark_DB::Browser_Bookmark_DB(void)
+:
+	m_db_connection(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -37,66 +53,159 @@ Browser_Bookmark_DB::~Browser_Bookmark_DB(void)
 
 Eina_Bool Browser_Bookmark_DB::_open_db(void)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	int error = db_util_open(BROWSER_BOOKMARK_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	m_db_connection = Browser_DB_Connection::get_connection(BROWSER_BOOKMARK_DB_PATH);
+	if (!m_db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
 	}
 
 	return EINA_TRUE;
 }
 
-Eina_Bool Browser_Bookmark_DB::_close_db(void)
+Eina_Bool Browser_Bookmark_DB::_get_last_index(int folder_id, int *last_index)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_db_descriptor)
-	{
-		int error = db_util_close(m_db_descriptor);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGE("db_util_close error");
-			m_db_descriptor = NULL;
-			return EINA_FALSE;
-		}
-		m_db_descriptor = NULL;
-	}
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return EINA_FALSE;
+
+	const std::vector<int> &children = tree->get_children(folder_id);
+	if (children.empty())
+		*last_index = 0;
+	else
+		*last_index = tree->get_node_at(children.back()).order_index;
 
 	return EINA_TRUE;
 }
 
-Eina_Bool Browser_Bookmark_DB::_get_last_index(int folder_id, int *last_index)
+Eina_Bool Browser_Bookmark_DB::_load_tree(void)
 {
-	if (_open_db() == EINA_FALSE)
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_BOOKMARK_DB_PATH);
+	if (!db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
+	}
+
+	std::vector<Browser_Bookmark_Tree::node> nodes;
+	if (!_read_tree_nodes(db_connection, nodes))
+		return EINA_FALSE;
+
+	m_tree.set_nodes(nodes);
 
-	std::string query = "select sequence from bookmarks where parent=? order by sequence desc";
+	return EINA_TRUE;
+}
 
+Eina_Bool Browser_Bookmark_DB::_read_tree_nodes(Browser_DB_Connection *db_connection,
+						std::vector<Browser_Bookmark_Tree::node> &nodes)
+{
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = db_connection->prepare_statement("select id,type,parent,address,title,sequence from bookmarks",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+	Browser_Bookmark_Tree::node node;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		node.id = sqlite3_column_int(sqlite3_stmt, 0);
+		node.is_folder = (sqlite3_column_int(sqlite3_stmt, 1) == BOOKMARK_NORMAL) ? EINA_FALSE : EINA_TRUE;
+		node.parent = sqlite3_column_int(sqlite3_stmt, 2);
 
-	if ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW || error == SQLITE_DONE)
-		*last_index = sqlite3_column_int(sqlite3_stmt, 0);
-	else
-		BROWSER_LOGE("sqlite3_step is failed. error=%d\n", error);
+		const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 3));
+		node.url = (url && !node.is_folder) ? url : "";
+		const char *title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 4));
+		node.title = title ? title : "";
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		node.order_index = sqlite3_column_int(sqlite3_stmt, 5);
+		nodes.push_back(node);
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	if (_close_db() == EINA_FALSE)
-		BROWSER_LOGE("_close_db is failed.");
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Browser_Bookmark_Tree *Browser_Bookmark_DB::_get_tree(void)
+{
+	if (!m_tree.is_loaded() && !_load_tree())
+		return NULL;
+
+	return &m_tree;
+}
+
+void Browser_Bookmark_DB::_add_tree_node(int id, int parent, Eina_Bool is_folder,
+					const std::string &url, const std::string &title, int order_index)
+{
+	if (m_tree.is_loaded()) {
+		Browser_Bookmark_Tree::node node;
+		node.id = id;
+		node.parent = parent;
+		node.is_folder = is_folder;
+		node.url = url;
+		node.title = title;
+		node.order_index = order_index;
+		m_tree.add(node);
+	}
+
+	m_tree.notify_changed(parent);
+}
+
+Browser_Bookmark_DB::bookmark_item *Browser_Bookmark_DB::_new_bookmark_item(const Browser_Bookmark_Tree::node &node)
+{
+	bookmark_item *item = new(nothrow) bookmark_item;
+	if (!item) {
+		BROWSER_LOGE("bookmark_item new is failed.\n");
+		return NULL;
+	}
+
+	item->id = node.id;
+	item->is_folder = node.is_folder;
+	item->url = node.url;
+	item->parent = node.parent;
+	item->title = node.title;
+	item->order_index = node.order_index;
+	item->is_editable = EINA_TRUE;
+	item->is_delete = EINA_FALSE;
+	item->user_data_1 = NULL;
+	item->user_data_2 = NULL;
+	item->user_data_3 = 0;
+
+	return item;
+}
+
+void Browser_Bookmark_DB::add_bookmark_changed_cb(bookmark_changed_cb callback, void *user_data)
+{
+	m_tree.add_changed_cb(callback, user_data);
+}
+
+void Browser_Bookmark_DB::remove_bookmark_changed_cb(bookmark_changed_cb callback, void *user_data)
+{
+	m_tree.remove_changed_cb(callback, user_data);
+}
 
-	return (error == SQLITE_DONE || error == SQLITE_ROW);
+void Browser_Bookmark_DB::check_external_change(void)
+{
+	/* Nothing is cached before the first read, which opens the file. */
+	if (!m_tree.is_loaded() && !m_url_set.is_loaded())
+		return;
+
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_BOOKMARK_DB_PATH);
+	if (!db_connection || !db_connection->has_external_change())
+		return;
+
+	BROWSER_LOGD("[%s] reload", __func__);
+	m_tree.unload();
+	m_url_set.unload();
+	m_tree.notify_changed(BROWSER_BOOKMARK_MAIN_FOLDER_ID);
 }
 
 Eina_Bool Browser_Bookmark_DB::delete_bookmark(int bookmark_id)
@@ -105,13 +214,12 @@ Eina_Bool Browser_Bookmark_DB::delete_bookmark(int bookmark_id)
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "delete from bookmarks where id=?",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("delete from bookmarks where id=?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -119,106 +227,169 @@ Eina_Bool Browser_Bookmark_DB::delete_bookmark(int bookmark_id)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	if (error != SQLITE_OK && error != SQLITE_DONE) {
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+	if (error != SQLITE_OK && error != SQLITE_DONE)
 		return EINA_FALSE;
-	}
 
-	if (_close_db() == EINA_FALSE)
-		BROWSER_LOGE("_close_db is failed.");
+	m_url_set.remove(bookmark_id);
+
+	Browser_Bookmark_Tree::node *node = m_tree.get_node(bookmark_id);
+	if (node) {
+		int parent = node->parent;
+		m_tree.remove(bookmark_id);
+		m_tree.notify_changed(parent);
+	}
 
 	return (error == SQLITE_DONE);
 }
 
-Eina_Bool Browser_Bookmark_DB::delete_folder(int folder_id)
+Eina_Bool Browser_Bookmark_DB::_step_statement(const char *query, const int *value, int *changes)
 {
-	delete_bookmark(folder_id);
-
-	if (_open_db() == EINA_FALSE)
-		return EINA_FALSE;
-
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id, type from bookmarks where parent=?",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement(query, &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK)
+	if (value && sqlite3_bind_int(sqlite3_stmt, 1, *value) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
-	std::vector<bookmark_item_type> item_type;
-	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
-		bookmark_item_type type;
-		type.id = sqlite3_column_int(sqlite3_stmt, 0);
-		type.is_folder = (sqlite3_column_int(sqlite3_stmt, 1) == BOOKMARK_FOLDER);
-		item_type.push_back(type);
+	error = sqlite3_step(sqlite3_stmt);
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d [%s]", error, query);
+		return EINA_FALSE;
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	if (changes)
+		*changes = sqlite3_changes(m_db_connection->get_descriptor());
+
+	return EINA_TRUE;
+}
 
-	_close_db();
+Eina_Bool Browser_Bookmark_DB::_delete_items_with_descendants(const std::vector<int> &bookmark_ids, int *deleted_count)
+{
+	/* The device sqlite has no recursive CTE. The ids to delete are collected in a temp table instead,
+	  * adding one whole level of the tree per statement, and then deleted with a single statement. */
+	if (!_step_statement("create temp table if not exists bookmark_delete_list(id integer primary key)", NULL, NULL))
+		return EINA_FALSE;
 
-	for (std::vector<bookmark_item_type>::iterator iter = item_type.begin()
-		; iter != item_type.end() ; iter++) {
-		if(iter->is_folder)
-			delete_folder(iter->id);
-		else
-			delete_bookmark(iter->id);
+	for (int i = 0 ; i < bookmark_ids.size() ; i++) {
+		if (!_step_statement("insert or ignore into temp.bookmark_delete_list (id) values(?)", &bookmark_ids[i], NULL))
+			return EINA_FALSE;
 	}
 
-	return EINA_TRUE;
+	int changes = 0;
+	do {
+		if (!_step_statement("insert or ignore into temp.bookmark_delete_list (id)"
+					" select id from bookmarks where parent in (select id from temp.bookmark_delete_list)",
+					NULL, &changes))
+			return EINA_FALSE;
+	} while (changes > 0);
+
+	if (!_step_statement("delete from bookmarks where id in (select id from temp.bookmark_delete_list)", NULL, &changes))
+		return EINA_FALSE;
+
+	if (deleted_count)
+		*deleted_count = changes;
+
+	return _step_statement("delete from temp.bookmark_delete_list", NULL, NULL);
 }
 
-Eina_Bool Browser_Bookmark_DB::get_bookmark_id_by_title_url(int folder_id, const char *title,
-								const char *url, int *bookmark_id)
+Eina_Bool Browser_Bookmark_DB::delete_folder(int folder_id, int *deleted_count)
+{
+	std::vector<int> bookmark_ids;
+	bookmark_ids.push_back(folder_id);
+
+	return delete_bookmarks(bookmark_ids, deleted_count);
+}
+
+Eina_Bool Browser_Bookmark_DB::delete_bookmarks(const std::vector<int> &bookmark_ids, int *deleted_count)
 {
+	BROWSER_LOGD("[%s] %d items", __func__, (int)bookmark_ids.size());
+	if (deleted_count)
+		*deleted_count = 0;
+
+	if (bookmark_ids.empty())
+		return EINA_TRUE;
+
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id from bookmarks where parent=? and title=?",
-					-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+	if (!m_db_connection->begin_transaction())
+		return EINA_FALSE;
+
+	/* Folders are deleted together with everything under them. */
+	if (!_delete_items_with_descendants(bookmark_ids, deleted_count)) {
+		BROWSER_LOGE("_delete_items_with_descendants failed");
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
- 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
-	if (sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
 
-	error = sqlite3_step(sqlite3_stmt);
-	if (error != SQLITE_ROW) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+	Eina_Bool ret = m_db_connection->commit_transaction();
+	/* The addresses of the descendants are not known here, read the set again on the next lookup. */
+	m_url_set.unload();
+
+	if (!ret) {
+		m_tree.unload();
 		return EINA_FALSE;
 	}
 
-	*bookmark_id = sqlite3_column_int(sqlite3_stmt, 0);
+	std::vector<int> parents;
+	for (int i = 0 ; i < bookmark_ids.size() ; i++) {
+		Browser_Bookmark_Tree::node *node = m_tree.get_node(bookmark_ids[i]);
+		if (node && std::find(parents.begin(), parents.end(), node->parent) == parents.end())
+			parents.push_back(node->parent);
+	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	m_tree.remove_with_descendants(bookmark_ids);
+	for (int i = 0 ; i < parents.size() ; i++)
+		m_tree.notify_changed(parents[i]);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_Bookmark_DB::get_bookmark_id_by_title_url(int folder_id, const char *title,
+								const char *url, int *bookmark_id)
+{
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree || !title)
+		return EINA_FALSE;
+
+	if (url && strlen(url)) {
+		if (!m_url_set.is_loaded() && !_load_url_set())
+			return EINA_FALSE;
 
-   	_close_db();
+		std::vector<int> bookmark_ids;
+		m_url_set.get_bookmark_ids(url, bookmark_ids);
+		for (int i = 0 ; i < bookmark_ids.size() ; i++) {
+			Browser_Bookmark_Tree::node *node = tree->get_node(bookmark_ids[i]);
+			if (node && node->parent == folder_id && node->title == title) {
+				*bookmark_id = node->id;
+				return EINA_TRUE;
+			}
+		}
+
+		return EINA_FALSE;
+	}
+
+	const std::vector<int> &children = tree->get_children(folder_id);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = tree->get_node_at(children[i]);
+		if (node.title == title) {
+			*bookmark_id = node.id;
+			return EINA_TRUE;
+		}
+	}
 
-	return (error == SQLITE_ROW);
+	return EINA_FALSE;
 }
 
 Eina_Bool Browser_Bookmark_DB::save_folder(const char* folder_name)
@@ -234,13 +405,12 @@ Eina_Bool Browser_Bookmark_DB::save_folder(const char* folder_name)
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "insert into bookmarks (type, parent, title, creationdate, sequence, updatedate, editable) values (?, ?, ?, DATETIME('now'), ?, DATETIME('now'), 1)",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("insert into bookmarks (type, parent, title, creationdate, sequence, updatedate, editable) values (?, ?, ?, DATETIME('now'), ?, DATETIME('now'), 1)",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -261,10 +431,12 @@ Eina_Bool Browser_Bookmark_DB::save_folder(const char* folder_name)
 
 	error = sqlite3_step(sqlite3_stmt);
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
+	if (error == SQLITE_DONE)
+		_add_tree_node(sqlite3_last_insert_rowid(m_db_connection->get_descriptor()), BROWSER_BOOKMARK_MAIN_FOLDER_ID,
+				EINA_TRUE, std::string(), folder_name ? folder_name : "", get_last_index_result ? last_index + 1 : 1);
 
 	return (error == SQLITE_DONE);
 }
@@ -285,13 +457,12 @@ Eina_Bool Browser_Bookmark_DB::save_bookmark(int folder_id, const char* title, c
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "insert into bookmarks (type, parent, address, title, creationdate, sequence, updatedate, editable) values (?, ?, ?, ?, DATETIME('now'), ?, DATETIME('now'), 1)",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("insert into bookmarks (type, parent, address, title, creationdate, sequence, updatedate, editable) values (?, ?, ?, ?, DATETIME('now'), ?, DATETIME('now'), 1)",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -325,158 +496,103 @@ Eina_Bool Browser_Bookmark_DB::save_bookmark(int folder_id, const char* title, c
 
   	error = sqlite3_step(sqlite3_stmt);
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	if (_close_db() == EINA_FALSE)
-		BROWSER_LOGE("_close_db is failed.");
+	if (error == SQLITE_DONE) {
+		int bookmark_id = sqlite3_last_insert_rowid(m_db_connection->get_descriptor());
+		if (m_url_set.is_loaded())
+			m_url_set.add(url_to_save.c_str(), bookmark_id);
+		_add_tree_node(bookmark_id, folder_id, EINA_FALSE, url_to_save, title_to_save,
+				get_last_index_result ? last_index + 1 : 1);
+	}
 
 	return (error == SQLITE_DONE);
 }
 
-Eina_Bool Browser_Bookmark_DB::is_full(void)
+Eina_Bool Browser_Bookmark_DB::_load_url_set(void)
 {
-	unsigned count = 0;
-
-	if (_open_db() == EINA_FALSE)
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_BOOKMARK_DB_PATH);
+	if (!db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
+	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select count(*) from bookmarks", -1, &sqlite3_stmt, NULL);
+	int error = db_connection->prepare_statement("select id, address from bookmarks where type=0",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	error = sqlite3_step(sqlite3_stmt);
-	if (error != SQLITE_ROW) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return EINA_FALSE;
+	m_url_set.unload();
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
+		m_url_set.add(url, sqlite3_column_int(sqlite3_stmt, 0));
 	}
 
-	count = sqlite3_column_int(sqlite3_stmt, 0);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+
+	if (error != SQLITE_DONE) {
+		m_url_set.unload();
 		return EINA_FALSE;
 	}
 
-	if (count >= BROWSER_BOOKMARK_COUNT_LIMIT)
-		return EINA_TRUE;
+	m_url_set.set_loaded();
 
-	return EINA_FALSE;
+	return EINA_TRUE;
 }
 
-Eina_Bool Browser_Bookmark_DB::is_duplicated(int folder_id, const char* title, const char* url)
+Eina_Bool Browser_Bookmark_DB::is_in_bookmark(const char *url, int *bookmark_id)
 {
-	if (_open_db() == EINA_FALSE)
+	if (!m_url_set.is_loaded() && !_load_url_set())
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id from bookmarks where parent=? and title=?",
-					-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return EINA_FALSE;
-	}
-
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
-		return EINA_FALSE;
-	}
+	return m_url_set.find(url, bookmark_id);
+}
 
-	if (sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+Eina_Bool Browser_Bookmark_DB::is_full(void)
+{
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
 		return EINA_FALSE;
-	}
 
-	error = sqlite3_step(sqlite3_stmt);
+	if (tree->get_count() >= BROWSER_BOOKMARK_COUNT_LIMIT)
+		return EINA_TRUE;
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	return EINA_FALSE;
+}
 
-	if (_close_db() == EINA_FALSE)
-		BROWSER_LOGE("_close_db is failed.");
-		
-	if (error == SQLITE_ROW)
-     		return EINA_TRUE;
-   
-   	return EINA_FALSE;
+Eina_Bool Browser_Bookmark_DB::is_duplicated(int folder_id, const char* title, const char* url)
+{
+	int bookmark_id = 0;
+	return get_bookmark_id_by_title_url(folder_id, title, url, &bookmark_id);
 }
 
 Eina_Bool Browser_Bookmark_DB::is_duplicated(const char *folder_name)
 {
-	if (_open_db() == EINA_FALSE)
+	int folder_id = 0;
+	if (!get_folder_id(BROWSER_BOOKMARK_MAIN_FOLDER_ID, folder_name, &folder_id))
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2( m_db_descriptor, "select id from bookmarks where type=1 and parent=1 and title=?",
-					-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return EINA_FALSE;
-	}
-
-
-	if (sqlite3_bind_text(sqlite3_stmt, 1, folder_name, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
-
-	error = sqlite3_step(sqlite3_stmt);
-
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	_close_db();
-
-	return (error == SQLITE_ROW);
+	return (folder_id != 0);
 }
 
 std::string Browser_Bookmark_DB::get_folder_name_by_id(const int folder_id)
 {
-	if (_open_db() == EINA_FALSE)
-		return EINA_FALSE;
-
-	sqlite3_stmt *sqlite3_stmt = NULL;
 	std::string folder_name = "";
-
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select title from bookmarks where type=1 and id=?",
-					-1, &sqlite3_stmt, NULL);
-
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
 		return folder_name;
-	}
- 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
-		return folder_name;
-	}
-
-	error = sqlite3_step(sqlite3_stmt);
-
-	if (error == SQLITE_ROW)
-		folder_name = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt,0));
-   
-   	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	if (_close_db() == EINA_FALSE)
-		BROWSER_LOGE("_close_db is failed.");
+	Browser_Bookmark_Tree::node *node = tree->get_node(folder_id);
+	if (node && node->is_folder)
+		folder_name = node->title;
 
 	return folder_name;
 }
@@ -487,48 +603,23 @@ Eina_Bool Browser_Bookmark_DB::get_folder_id(int current_folder_id, const char *
 		BROWSER_LOGE("folder name is invalid.\n");
 	}
 
-	if (_open_db() == EINA_FALSE)
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id from bookmarks where type=1 and parent=? and title=?",
-					-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return EINA_FALSE;
-	}
-
+	/* 0 if there is no such folder. */
+	*folder_id = 0;
 
-	// binding values
-	if (sqlite3_bind_int(sqlite3_stmt, 1, current_folder_id) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
-		return EINA_FALSE;
-	}
-	if (sqlite3_bind_text(sqlite3_stmt, 2, folder_name, -1, NULL) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
-		return EINA_FALSE;
-	}
-
-	// checking if a bookmark exists
-	error = sqlite3_step(sqlite3_stmt);
-
-	*folder_id = BROWSER_BOOKMARK_MAIN_FOLDER_ID; //just in case
-
-	if (error == SQLITE_ROW || error == SQLITE_DONE)
-		*folder_id = sqlite3_column_int(sqlite3_stmt, 0);
-
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	if (_close_db() == EINA_FALSE) {
-		BROWSER_LOGE("_close_db is failed.");
-		return EINA_FALSE;
+	const std::vector<int> &children = tree->get_children(current_folder_id);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = tree->get_node_at(children[i]);
+		if (node.is_folder && folder_name && node.title == folder_name) {
+			*folder_id = node.id;
+			break;
+		}
 	}
 
-	return (error == SQLITE_DONE || error == SQLITE_ROW);
+	return EINA_TRUE;
 }
 
 Eina_Bool Browser_Bookmark_DB::modify_bookmark(int bookmark_id, int folder_id, const char *title, const char *url)
@@ -546,13 +637,12 @@ Eina_Bool Browser_Bookmark_DB::modify_bookmark(int bookmark_id, int folder_id, c
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "update bookmarks set title=?, address=?, parent=?, updatedate=DATETIME('now'), sequence=? where id=?",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("update bookmarks set title=?, address=?, parent=?, updatedate=DATETIME('now'), sequence=? where id=?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -576,10 +666,27 @@ Eina_Bool Browser_Bookmark_DB::modify_bookmark(int bookmark_id, int folder_id, c
 
 	error = sqlite3_step(sqlite3_stmt);
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
+	if (error == SQLITE_DONE && m_url_set.is_loaded()) {
+		m_url_set.remove(bookmark_id);
+		m_url_set.add(url, bookmark_id);
+	}
+
+	Browser_Bookmark_Tree::node *node = m_tree.get_node(bookmark_id);
+	if (error == SQLITE_DONE && node) {
+		int old_parent = node->parent;
+		node->title = title ? title : "";
+		node->url = url ? url : "";
+		node->parent = folder_id;
+		node->order_index = get_last_index_result ? last_index + 1 : 1;
+		m_tree.reindex();
+
+		if (old_parent != folder_id)
+			m_tree.notify_changed(old_parent);
+		m_tree.notify_changed(folder_id);
+	}
 
 	return (error == SQLITE_DONE);
 }
@@ -591,13 +698,12 @@ Eina_Bool Browser_Bookmark_DB::modify_bookmark_title(int bookmark_id, const char
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "update bookmarks set title=?, updatedate=DATETIME('now') where id=?",
-				-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("update bookmarks set title=?, updatedate=DATETIME('now') where id=?",
+				&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 	if (sqlite3_bind_text(sqlite3_stmt, 1, title, -1, NULL) != SQLITE_OK)
@@ -607,298 +713,581 @@ Eina_Bool Browser_Bookmark_DB::modify_bookmark_title(int bookmark_id, const char
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	if (_close_db() == EINA_FALSE) {
-		BROWSER_LOGE("_close_db is failed.");
-		return EINA_FALSE;
+	Browser_Bookmark_Tree::node *node = m_tree.get_node(bookmark_id);
+	if (error == SQLITE_DONE && node) {
+		node->title = title ? title : "";
+		m_tree.notify_changed(node->parent);
 	}
 
 	return (error == SQLITE_DONE);
 }
 
-Eina_Bool Browser_Bookmark_DB::modify_bookmark_order_index(int bookmark_id, int folder_id, int order_index)
+Eina_Bool Browser_Bookmark_DB::move_bookmark(int bookmark_id, int folder_id, int new_index)
 {
+	BROWSER_LOGD("[%s] id=%d, new_index=%d", __func__, bookmark_id, new_index);
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
+	if (!m_db_connection->begin_transaction())
+		return EINA_FALSE;
+
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "update bookmarks set sequence=? where parent=? and id=?",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select sequence from bookmarks where parent=? and id=?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, order_index) != SQLITE_OK)
+	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	if (sqlite3_bind_int(sqlite3_stmt, 2, bookmark_id) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	int old_index = 0;
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW)
+		old_index = sqlite3_column_int(sqlite3_stmt, 0);
+
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_ROW) {
+		BROWSER_LOGE("bookmark %d is not in folder %d", bookmark_id, folder_id);
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	if (old_index == new_index)
+		return m_db_connection->commit_transaction();
+
+	/* Shift the whole range between the old and the new position with one statement. */
+	error = m_db_connection->prepare_statement("update bookmarks set sequence=sequence+? where parent=? and sequence between ? and ?",
+					&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	Eina_Bool is_move_down = (new_index > old_index);
+	if (sqlite3_bind_int(sqlite3_stmt, 1, is_move_down ? -1 : 1) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
 	if (sqlite3_bind_int(sqlite3_stmt, 2, folder_id) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
-	if (sqlite3_bind_int(sqlite3_stmt, 3, bookmark_id) != SQLITE_OK)
+	if (sqlite3_bind_int(sqlite3_stmt, 3, is_move_down ? old_index + 1 : new_index) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	if (sqlite3_bind_int(sqlite3_stmt, 4, is_move_down ? new_index : old_index - 1) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
 
-	return (error == SQLITE_DONE);
+	if (!_write_order_index(bookmark_id, folder_id, new_index)) {
+		BROWSER_LOGE("_write_order_index failed");
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	if (!m_db_connection->commit_transaction())
+		return EINA_FALSE;
+
+	/* The tree and the observers follow the file only once the move is committed. */
+	int first_index = is_move_down ? old_index + 1 : new_index;
+	int last_index = is_move_down ? new_index : old_index - 1;
+	const std::vector<int> &children = m_tree.get_children(folder_id);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = m_tree.get_node_at(children[i]);
+		if (node.id == bookmark_id)
+			node.order_index = new_index;
+		else if (node.order_index >= first_index && node.order_index <= last_index)
+			node.order_index += is_move_down ? -1 : 1;
+	}
+	m_tree.reindex();
+	m_tree.notify_changed(folder_id);
+
+	return EINA_TRUE;
 }
 
-Eina_Bool Browser_Bookmark_DB::get_untitled_folder_count(int *count)
+Eina_Bool Browser_Bookmark_DB::save_favicon(const char *url, const Browser_Favicon &favicon)
 {
 	BROWSER_LOGD("[%s]", __func__);
-	if (_open_db() == EINA_FALSE)
+	if (!url || !strlen(url) || favicon.is_empty())
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	std::string statement = "select title from bookmarks where type=1 and length(title)>8 and title like '%Folder_%' order by length(title), title";
-	int error = sqlite3_prepare_v2(m_db_descriptor, statement.c_str(), -1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_BOOKMARK_DB_PATH);
+	if (!db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
 	}
 
-	std::string title;
-	std::string title_from_db;
-	char buf[32] = {0, };
-	for (int i = 1; ; i++) {
-		*count = i;
-		error = sqlite3_step(sqlite3_stmt);
-		if (error == SQLITE_ROW) {
-			snprintf(buf, sizeof(buf)-1, "Folder_%02d", i);
-			title = buf;
-			title_from_db = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt,0));
-			if (title_from_db != title)
-				break;
-		} else
-			break;
-	}
-
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	return Browser_Favicon::write_favicon(db_connection, Browser_Favicon::get_host(url), favicon);
+}
 
-	_close_db();
+Eina_Bool Browser_Bookmark_DB::get_favicons(const std::vector<int> &bookmark_ids, std::map<int, Browser_Favicon> &favicons)
+{
+	BROWSER_LOGD("[%s] %d items", __func__, (int)bookmark_ids.size());
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
 
-	return (error == SQLITE_DONE || error == SQLITE_ROW);
+	return Browser_Favicon::read_favicons(m_db_connection, "bookmarks", bookmark_ids, favicons);
 }
 
-Browser_Bookmark_DB::bookmark_item *Browser_Bookmark_DB::get_bookmark_item_by_id(int bookmark_id)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (_open_db() == EINA_FALSE) {
-		BROWSER_LOGE("open failed");
-		return NULL;
+/* Inserts the entries of Browser_Bookmark_Html_Reader with one prepared statement.
+  * The sequence of each folder is counted here instead of being read per insert. */
+class Browser_Bookmark_DB::bookmark_importer {
+public:
+	bookmark_importer(Browser_DB_Connection *db_connection, Browser_Bookmark_Tree *tree, sqlite3_stmt *insert_statement)
+		: m_db_connection(db_connection), m_tree(tree), m_insert_statement(insert_statement)
+		, m_folder_id(BROWSER_BOOKMARK_MAIN_FOLDER_ID), m_folder_depth(0)
+		, m_available_count(BROWSER_BOOKMARK_COUNT_LIMIT - tree->get_count())
+		, m_imported_count(0), m_is_failed(EINA_FALSE) {}
+
+	static Eina_Bool __entry_cb(Browser_Bookmark_Html_Reader::entry_type type, const std::string &title,
+					const std::string &url, void *user_data)
+	{
+		return ((bookmark_importer *)user_data)->_add_entry(type, title, url);
 	}
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select type,parent,address,title,sequence,editable from bookmarks where id=?",
-					-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return NULL;
+
+	Eina_Bool _add_entry(Browser_Bookmark_Html_Reader::entry_type type, const std::string &title, const std::string &url);
+	Eina_Bool _is_in_folder(int folder_id, const std::string &title, const std::string &url);
+	int _get_folder_id(const std::string &title);
+	int _insert(Eina_Bool is_folder, int parent, const std::string &title, const std::string &url);
+
+	Browser_DB_Connection *m_db_connection;
+	Browser_Bookmark_Tree *m_tree;
+	sqlite3_stmt *m_insert_statement;
+	int m_folder_id;
+	int m_folder_depth;
+	int m_available_count;
+	int m_imported_count;
+	Eina_Bool m_is_failed;
+	std::map<int, int> m_next_index;
+	std::map<std::string, int> m_new_folders;
+	std::set<std::string> m_imported_keys;
+};
+
+Eina_Bool Browser_Bookmark_DB::bookmark_importer::_add_entry(Browser_Bookmark_Html_Reader::entry_type type,
+							const std::string &title, const std::string &url)
+{
+	if (type == Browser_Bookmark_Html_Reader::BOOKMARK_HTML_FOLDER_END) {
+		if (m_folder_depth > 0 && --m_folder_depth == 0)
+			m_folder_id = BROWSER_BOOKMARK_MAIN_FOLDER_ID;
+		return EINA_TRUE;
 	}
-	if (sqlite3_bind_int(sqlite3_stmt, 1, bookmark_id) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
-		return NULL;
+
+	if (type == Browser_Bookmark_Html_Reader::BOOKMARK_HTML_FOLDER_START) {
+		/* The folders can not be nested, see get_folder_list(). */
+		if (m_folder_depth++ > 0)
+			return EINA_TRUE;
+
+		m_folder_id = _get_folder_id(title);
+		return (m_folder_id != 0);
 	}
 
-	bookmark_item *item = NULL;
-	if ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
-		item = new(nothrow) bookmark_item;
-		if (!item) {
-			BROWSER_LOGE("bookmark_item new is failed.\n");
-			return NULL;
-		}
+	std::string title_to_save = title;
+	if (title_to_save.size() >= BROWSER_MAX_TITLE_LEN)
+		title_to_save.resize(BROWSER_MAX_TITLE_LEN - 1);
+	std::string url_to_save = url;
+	if (url_to_save.size() >= BROWSER_MAX_URL_LEN)
+		url_to_save.resize(BROWSER_MAX_URL_LEN - 1);
 
-		item->id = bookmark_id;
-		if (sqlite3_column_int(sqlite3_stmt, 0) == BOOKMARK_NORMAL)
-			item->is_folder = EINA_FALSE;
-		else
-			item->is_folder = EINA_TRUE;
-
-		if (!item->is_folder) {
-			const char* url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
-			if (url && strlen(url) > 0)
-				item->url = url;
-			else
-				item->url = "";
-		}
+	if (_is_in_folder(m_folder_id, title_to_save, url_to_save))
+		return EINA_TRUE;
 
-		item->parent = sqlite3_column_int(sqlite3_stmt, 1);
+	return (_insert(EINA_FALSE, m_folder_id, title_to_save, url_to_save) != 0);
+}
+
+Eina_Bool Browser_Bookmark_DB::bookmark_importer::_is_in_folder(int folder_id, const std::string &title,
+								const std::string &url)
+{
+	/* The file may hold the same page twice under different addresses. */
+	char folder_and_url[48];
+	snprintf(folder_and_url, sizeof(folder_and_url), "%d\n%llx\n", folder_id, (unsigned long long)br_url_key(url.c_str()));
+	if (!m_imported_keys.insert(folder_and_url + title).second)
+		return EINA_TRUE;
 
-		const char* title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 3));
-		if (title && strlen(title) > 0)
-			item->title = title;
-		else
-			item->title = "";
+	std::vector<int> bookmark_ids;
+	m_url_set.get_bookmark_ids(url.c_str(), bookmark_ids);
+	for (int i = 0 ; i < bookmark_ids.size() ; i++) {
+		Browser_Bookmark_Tree::node *node = m_tree->get_node(bookmark_ids[i]);
+		if (node && node->parent == folder_id && node->title == title)
+			return EINA_TRUE;
+	}
 
-		item->order_index = sqlite3_column_int(sqlite3_stmt, 4);
-		item->is_editable = EINA_TRUE;//sqlite3_column_int(sqlite3_stmt, 5);
+	return EINA_FALSE;
+}
 
-		item->is_delete = EINA_FALSE;
-		item->user_data_1 = NULL;
-		item->user_data_2 = NULL;
-		item->user_data_3 = 0;
+int Browser_Bookmark_DB::bookmark_importer::_get_folder_id(const std::string &title)
+{
+	std::map<std::string, int>::iterator iter = m_new_folders.find(title);
+	if (iter != m_new_folders.end())
+		return iter->second;
+
+	const std::vector<int> &children = m_tree->get_children(BROWSER_BOOKMARK_MAIN_FOLDER_ID);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = m_tree->get_node_at(children[i]);
+		if (node.is_folder && node.title == title)
+			return node.id;
 	}
 
-	error = sqlite3_finalize(sqlite3_stmt);
-	if (error != SQLITE_OK)
-	{
-		BROWSER_LOGE("sqlite3_finalize is failed. (%d)", error);
-		return NULL;
+	int folder_id = _insert(EINA_TRUE, BROWSER_BOOKMARK_MAIN_FOLDER_ID, title, std::string());
+	if (folder_id) {
+		m_new_folders[title] = folder_id;
+		m_next_index[folder_id] = 1;
 	}
 
-	if (_close_db() == EINA_FALSE) {
-		BROWSER_LOGE("_close_db is failed.");
-		return NULL;
+	return folder_id;
+}
+
+int Browser_Bookmark_DB::bookmark_importer::_insert(Eina_Bool is_folder, int parent, const std::string &title,
+							const std::string &url)
+{
+	if (m_available_count <= 0)
+		return 0;
+
+	std::map<int, int>::iterator iter = m_next_index.find(parent);
+	if (iter == m_next_index.end()) {
+		const std::vector<int> &children = m_tree->get_children(parent);
+		int last_index = children.empty() ? 0 : m_tree->get_node_at(children.back()).order_index;
+		iter = m_next_index.insert(std::make_pair(parent, last_index + 1)).first;
 	}
 
-	return item;
+	sqlite3_reset(m_insert_statement);
+	if (sqlite3_bind_int(m_insert_statement, 1, is_folder ? BOOKMARK_FOLDER : BOOKMARK_NORMAL) != SQLITE_OK
+	    || sqlite3_bind_int(m_insert_statement, 2, parent) != SQLITE_OK
+	    || (is_folder ? sqlite3_bind_null(m_insert_statement, 3)
+			: sqlite3_bind_text(m_insert_statement, 3, url.c_str(), -1, NULL)) != SQLITE_OK
+	    || sqlite3_bind_text(m_insert_statement, 4, title.c_str(), -1, NULL) != SQLITE_OK
+	    || sqlite3_bind_int(m_insert_statement, 5, iter->second) != SQLITE_OK) {
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
+		m_is_failed = EINA_TRUE;
+		return 0;
+	}
+
+	int error = sqlite3_step(m_insert_statement);
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		m_is_failed = EINA_TRUE;
+		return 0;
+	}
+
+	iter->second++;
+	m_available_count--;
+	m_imported_count++;
+
+	return sqlite3_last_insert_rowid(m_db_connection->get_descriptor());
 }
 
-Eina_Bool Browser_Bookmark_DB::get_bookmark_list(std::vector<bookmark_item *> &list, int folder_id)
+Eina_Bool Browser_Bookmark_DB::import_bookmarks(const char *file_path, int *imported_count)
 {
 	BROWSER_LOGD("[%s]", __func__);
-	if (_open_db() == EINA_FALSE) {
-		BROWSER_LOGE("open failed");
+	if (imported_count)
+		*imported_count = 0;
+
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return EINA_FALSE;
+
+	if (!m_url_set.is_loaded() && !_load_url_set())
+		return EINA_FALSE;
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	if (!m_db_connection->begin_transaction())
 		return EINA_FALSE;
-	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id,type,parent,address,title,sequence,editable from bookmarks where parent=? order by sequence",
-					-1,&sqlite3_stmt,NULL);
+	int error = m_db_connection->prepare_statement("insert into bookmarks (type, parent, address, title, creationdate, sequence, updatedate, editable) values (?, ?, ?, ?, DATETIME('now'), ?, DATETIME('now'), 1)",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
-	if (sqlite3_bind_int(sqlite3_stmt, 1, folder_id) != SQLITE_OK) {
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	bookmark_importer importer(m_db_connection, tree, sqlite3_stmt);
+	Browser_Bookmark_Html_Reader reader(bookmark_importer::__entry_cb, &importer);
+	Eina_Bool is_read = reader.read(file_path);
+
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (!is_read || importer.m_is_failed) {
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
 
-	bookmark_item *item;
-	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
-		item = new(nothrow) bookmark_item;
-		if (!item) {
-			BROWSER_LOGE("bookmark_item new is failed.\n");
-			return EINA_FALSE;
-		}
-
-		item->id = sqlite3_column_int(sqlite3_stmt, 0);
-		if (sqlite3_column_int(sqlite3_stmt, 1) == BOOKMARK_NORMAL)
-			item->is_folder = EINA_FALSE;
-		else
-			item->is_folder = EINA_TRUE;
-
-		if (!item->is_folder) {
-			const char* url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 3));
-			if (url && strlen(url) > 0)
-				item->url = url;
-			else
-				item->url = "";
-		}
+	if (!m_db_connection->commit_transaction())
+		return EINA_FALSE;
 
-		item->parent = sqlite3_column_int(sqlite3_stmt, 2);
+	BROWSER_LOGD("%d items imported", importer.m_imported_count);
+	if (imported_count)
+		*imported_count = importer.m_imported_count;
 
-		const char* title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 4));
-		if (title && strlen(title) > 0)
-			item->title = title;
-		else
-			item->title = "";
+	/* Reloaded with the new rows on the next read. */
+	if (importer.m_imported_count) {
+		m_tree.unload();
+		m_url_set.unload();
+		m_tree.notify_changed(BROWSER_BOOKMARK_MAIN_FOLDER_ID);
+	}
 
-		item->order_index = sqlite3_column_int(sqlite3_stmt, 5);
-		item->is_editable = EINA_TRUE;//sqlite3_column_int(sqlite3_stmt, 6);
+	return EINA_TRUE;
+}
 
-		item->is_delete = EINA_FALSE;
-		item->user_data_1 = NULL;
-		item->user_data_2 = NULL;
-		item->user_data_3 = 0;
-		list.push_back(item);
+void Browser_Bookmark_DB::_export_folder(Browser_Bookmark_Html_Writer &writer, Browser_Bookmark_Tree *tree, int folder_id)
+{
+	const std::vector<int> &children = tree->get_children(folder_id);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = tree->get_node_at(children[i]);
+		if (node.is_folder) {
+			writer.add_folder_start(node.title.c_str());
+			_export_folder(writer, tree, node.id);
+			writer.add_folder_end();
+		} else
+			writer.add_bookmark(node.title.c_str(), node.url.c_str());
 	}
+}
 
-	error = sqlite3_finalize(sqlite3_stmt);
-	if (error != SQLITE_OK)
-	{
-		BROWSER_LOGE("sqlite3_finalize is failed. (%d)", error);
+Eina_Bool Browser_Bookmark_DB::export_bookmarks(const char *file_path)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
 		return EINA_FALSE;
-	}
 
-	if (_close_db() == EINA_FALSE) {
-		BROWSER_LOGE("_close_db is failed.");
+	Browser_Bookmark_Html_Writer writer;
+	if (!writer.open(file_path))
 		return EINA_FALSE;
-	}
 
-	return EINA_TRUE;
+	_export_folder(writer, tree, BROWSER_BOOKMARK_MAIN_FOLDER_ID);
+
+	return writer.close();
 }
 
-Eina_Bool Browser_Bookmark_DB::get_folder_list(std::vector<bookmark_item *> &list)
+Eina_Bool Browser_Bookmark_DB::modify_bookmark_order_index(int bookmark_id, int folder_id, int order_index)
 {
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
+	if (!_write_order_index(bookmark_id, folder_id, order_index))
+		return EINA_FALSE;
+
+	Browser_Bookmark_Tree::node *node = m_tree.get_node(bookmark_id);
+	if (node && node->parent == folder_id) {
+		node->order_index = order_index;
+		m_tree.reindex();
+		m_tree.notify_changed(folder_id);
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_Bookmark_DB::_write_order_index(int bookmark_id, int folder_id, int order_index)
+{
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id,type,parent,address,title,sequence from bookmarks where type=1 and parent=? order by sequence",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("update bookmarks set sequence=? where parent=? and id=?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, BROWSER_BOOKMARK_MAIN_FOLDER_ID) != SQLITE_OK)
+	if (sqlite3_bind_int(sqlite3_stmt, 1, order_index) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
-	bookmark_item *item;
-	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW)
-	{
-		item = new(nothrow) bookmark_item;
-		if (!item) {
-			BROWSER_LOGE("bookmark_item new is failed.\n");
-			return EINA_FALSE;
-		}
+	if (sqlite3_bind_int(sqlite3_stmt, 2, folder_id) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	if (sqlite3_bind_int(sqlite3_stmt, 3, bookmark_id) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return (error == SQLITE_DONE);
+}
+
+Eina_Bool Browser_Bookmark_DB::get_untitled_folder_count(int *count)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return EINA_FALSE;
+
+	/* The folder titles which were matched by "length(title)>8 and title like '%Folder_%'". */
+	std::vector<std::string> titles;
+	for (int i = 0 ; i < tree->get_count() ; i++) {
+		Browser_Bookmark_Tree::node &node = tree->get_node_at(i);
+		if (!node.is_folder || node.title.length() <= 8)
+			continue;
 
-		item->id = sqlite3_column_int(sqlite3_stmt, 0);
-		item->is_folder = sqlite3_column_int(sqlite3_stmt, 1) == BOOKMARK_NORMAL ? EINA_FALSE : EINA_TRUE;
-		item->parent = sqlite3_column_int(sqlite3_stmt, 2);
-		item->title = "";
+		const char *folder = strcasestr(node.title.c_str(), "Folder");
+		if (folder && strlen(folder) > strlen("Folder"))
+			titles.push_back(node.title);
+	}
+	std::sort(titles.begin(), titles.end(), title_length_compare());
+
+	char buf[32] = {0, };
+	for (int i = 1; ; i++) {
+		*count = i;
+		if (i > titles.size())
+			break;
 
-		const char* title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 4));
-		if (title && strlen(title)>0)
-			item->title = title;
-		else
-			item->title = "";
-		item->order_index = sqlite3_column_int(sqlite3_stmt, 5);
-		item->is_editable = EINA_TRUE;
-		item->is_delete = EINA_FALSE;
+		snprintf(buf, sizeof(buf)-1, "Folder_%02d", i);
+		if (titles[i - 1] != buf)
+			break;
+	}
 
+	return EINA_TRUE;
+}
+
+Browser_Bookmark_DB::bookmark_item *Browser_Bookmark_DB::get_bookmark_item_by_id(int bookmark_id)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return NULL;
+
+	Browser_Bookmark_Tree::node *node = tree->get_node(bookmark_id);
+	if (!node)
+		return NULL;
+
+	return _new_bookmark_item(*node);
+}
+
+Eina_Bool Browser_Bookmark_DB::get_bookmark_list(std::vector<bookmark_item *> &list, int folder_id)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	return _get_tree_children(list, folder_id);
+}
+
+Eina_Bool Browser_Bookmark_DB::_get_tree_children(std::vector<bookmark_item *> &list, int folder_id)
+{
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return EINA_FALSE;
+
+	const std::vector<int> &children = tree->get_children(folder_id);
+	for (int i = 0 ; i < children.size() ; i++) {
+		bookmark_item *item = _new_bookmark_item(tree->get_node_at(children[i]));
+		if (!item)
+			return EINA_FALSE;
 		list.push_back(item);
 	}
 
-	error = sqlite3_finalize(sqlite3_stmt);
-	if (error != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed. (%d)\n", error);
+	return EINA_TRUE;
+}
+
+class Browser_Bookmark_DB::bookmark_list_job : public Browser_DB_Job {
+public:
+	bookmark_list_job(int folder_id, bookmark_list_cb callback, void *user_data)
+		: m_folder_id(folder_id), m_callback(callback), m_user_data(user_data), m_result(EINA_FALSE)
+		, m_is_tree_loaded(m_tree.is_loaded()), m_tree_generation(m_tree.get_generation()), m_is_read(EINA_FALSE) {}
+	~bookmark_list_job(void)
+	{
+		for (int i = 0 ; i < m_list.size() ; i++)
+			delete m_list[i];
+	}
+	void run(void)
+	{
+		/* m_tree itself is only touched on the main loop, in done(). */
+		if (m_is_tree_loaded)
+			return;
 
-	_close_db();
+		Browser_DB_Connection *db_connection = Browser_DB_Executor::get_instance()->get_worker_connection(BROWSER_BOOKMARK_DB_PATH);
+		if (db_connection)
+			m_is_read = _read_tree_nodes(db_connection, m_nodes);
+	}
+	void done(void)
+	{
+		/* The nodes are stale if the tree was changed or loaded meanwhile, then _get_tree() loads it again. */
+		if (m_is_read && !m_tree.is_loaded() && m_tree.get_generation() == m_tree_generation)
+			m_tree.set_nodes(m_nodes);
 
-	return (error == SQLITE_DONE || error == SQLITE_OK);
+		m_result = _get_tree_children(m_list, m_folder_id);
+		m_callback(m_result, m_list, m_user_data);
+		m_list.clear();
+	}
+
+	int m_folder_id;
+	bookmark_list_cb m_callback;
+	void *m_user_data;
+	Eina_Bool m_result;
+	Eina_Bool m_is_tree_loaded;
+	int m_tree_generation;
+	Eina_Bool m_is_read;
+	std::vector<Browser_Bookmark_Tree::node> m_nodes;
+	std::vector<bookmark_item *> m_list;
+};
+
+int Browser_Bookmark_DB::get_bookmark_list_async(int folder_id, bookmark_list_cb callback, void *user_data, int priority)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!callback)
+		return 0;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	if (!executor)
+		return 0;
+
+	bookmark_list_job *job = new(nothrow) bookmark_list_job(folder_id, callback, user_data);
+	if (!job) {
+		BROWSER_LOGE("new bookmark_list_job failed");
+		return 0;
+	}
+
+	int job_id = executor->post(job, priority);
+	if (!job_id)
+		delete job;
+
+	return job_id;
+}
+
+Eina_Bool Browser_Bookmark_DB::get_folder_list(std::vector<bookmark_item *> &list)
+{
+	Browser_Bookmark_Tree *tree = _get_tree();
+	if (!tree)
+		return EINA_FALSE;
+
+	const std::vector<int> &children = tree->get_children(BROWSER_BOOKMARK_MAIN_FOLDER_ID);
+	for (int i = 0 ; i < children.size() ; i++) {
+		Browser_Bookmark_Tree::node &node = tree->get_node_at(children[i]);
+		if (!node.is_folder)
+			continue;
+
+		bookmark_item *item = _new_bookmark_item(node);
+		if (!item)
+			return EINA_FALSE;
+		list.push_back(item);
+	}
+
+	return EINA_TRUE;
 }
 
 
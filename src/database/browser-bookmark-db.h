@@ -20,12 +20,19 @@
 #define BROWSER_BOOKMARK_DB_H
 
 #include "browser-config.h"
+#include "browser-db-connection.h"
+#include "browser-db-executor.h"
+#include "browser-favicon.h"
+#include "browser-bookmark-html.h"
+#include "browser-bookmark-tree.h"
+#include "browser-bookmark-url-set.h"
 
 extern "C" {
 #include "db-util.h"
 }
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -45,37 +52,89 @@ public:
 		int user_data_3;
 	};
 
-	struct bookmark_item_type {
-		int id;
-		bool is_folder;
-	};
+	/* folder_id is the folder whose content was changed. */
+	typedef Browser_Bookmark_Tree::changed_cb bookmark_changed_cb;
+	/* The items of list belong to the callback. */
+	typedef void (*bookmark_list_cb)(Eina_Bool result, std::vector<bookmark_item *> &list, void *user_data);
 
 	Browser_Bookmark_DB();
 	~Browser_Bookmark_DB();
 
 	Eina_Bool get_bookmark_list(std::vector<bookmark_item *> &list, int folder_id);
+	/* The same list, with the bookmarks loaded on the executor if they are not in memory yet.
+	  * Returns the job id for Browser_DB_Executor::cancel(), or 0 on failure. */
+	int get_bookmark_list_async(int folder_id, bookmark_list_cb callback, void *user_data,
+					int priority = BROWSER_DB_JOB_PRIORITY_NORMAL);
 	Eina_Bool get_folder_list(std::vector<bookmark_item *> &list);
 	Eina_Bool get_folder_id(int current_folder_id, const char *folder_name, int *folder_id);
 	std::string get_folder_name_by_id(const int folder_id);
+	/* A bookmark is looked up by a probe of the hashed addresses and must have the same title,
+	  * without url a folder is looked up by title. */
 	Eina_Bool get_bookmark_id_by_title_url(int folder_id, const char *title, const char *url, int *bookmark_id);
 	bookmark_item *get_bookmark_item_by_id(int bookmark_id);
 	Eina_Bool get_untitled_folder_count(int *count);
+	/* True if folder_id has a bookmark with the same title and url. */
 	Eina_Bool is_duplicated(int folder_id, const char *title, const char *url);
 	Eina_Bool is_duplicated(const char *folder_name);
 	Eina_Bool is_full(void);
+	/* Answered from memory, the addresses are read once per process. */
+	static Eina_Bool is_in_bookmark(const char *url, int *bookmark_id);
 	Eina_Bool save_bookmark(int folder_id, const char *title, const char *url);
 	Eina_Bool save_folder(const char *folder_name);
 	Eina_Bool delete_bookmark(int bookmark_id);
-	Eina_Bool delete_folder(int folder_id);
+	/* deleted_count returns the number of rows removed, including the contents of folders. */
+	Eina_Bool delete_folder(int folder_id, int *deleted_count = NULL);
+	Eina_Bool delete_bookmarks(const std::vector<int> &bookmark_ids, int *deleted_count = NULL);
 	Eina_Bool modify_bookmark_title(int bookmark_id, const char *title);
 	Eina_Bool modify_bookmark(int bookmark_id, int folder_id, const char *title, const char *url);
 	Eina_Bool modify_bookmark_order_index(int bookmark_id, int folder_id, int order_index);	
+	/* Moves the item to new_index and shifts the items in between by one. */
+	Eina_Bool move_bookmark(int bookmark_id, int folder_id, int new_index);
+	/* The icon is stored once for the host of url, all its bookmarks show it. */
+	static Eina_Bool save_favicon(const char *url, const Browser_Favicon &favicon);
+	/* The icons of the given bookmarks in one read. */
+	Eina_Bool get_favicons(const std::vector<int> &bookmark_ids, std::map<int, Browser_Favicon> &favicons);
+	/* Adds the content of a Netscape bookmark file to the main folder in one transaction.
+	  * A top level folder of the file is merged into the folder of the same name, the content of
+	  * deeper folders goes to their top level folder. The bookmarks already in their folder are skipped,
+	  * and the rest of the file is ignored once BROWSER_BOOKMARK_COUNT_LIMIT is reached. */
+	Eina_Bool import_bookmarks(const char *file_path, int *imported_count = NULL);
+	/* Writes all the bookmarks in a Netscape bookmark file. */
+	Eina_Bool export_bookmarks(const char *file_path);
+
+	/* Called after each change made through any Browser_Bookmark_DB. */
+	static void add_bookmark_changed_cb(bookmark_changed_cb callback, void *user_data);
+	static void remove_bookmark_changed_cb(bookmark_changed_cb callback, void *user_data);
+	/* Drops the in-memory copies if another process wrote to the bookmark file.
+	  * The callbacks are then called with BROWSER_BOOKMARK_MAIN_FOLDER_ID, as the changed folders are not known. */
+	static void check_external_change(void);
 private:
+	class bookmark_list_job;
+	class bookmark_importer;
+	struct title_length_compare;
+
 	Eina_Bool _open_db(void);
-	Eina_Bool _close_db(void);
 	Eina_Bool _get_last_index(int folder_id, int *last_index);
+	Eina_Bool _step_statement(const char *query, const int *value, int *changes);
+	/* The sequence column only, the tree is left to the caller. */
+	Eina_Bool _write_order_index(int bookmark_id, int folder_id, int order_index);
+	Eina_Bool _delete_items_with_descendants(const std::vector<int> &bookmark_ids, int *deleted_count);
+	static Eina_Bool _load_url_set(void);
+	/* The reads are answered from m_tree, which is loaded on the first one. */
+	static Eina_Bool _load_tree(void);
+	static Eina_Bool _read_tree_nodes(Browser_DB_Connection *db_connection,
+					std::vector<Browser_Bookmark_Tree::node> &nodes);
+	static Eina_Bool _get_tree_children(std::vector<bookmark_item *> &list, int folder_id);
+	static Browser_Bookmark_Tree *_get_tree(void);
+	static void _add_tree_node(int id, int parent, Eina_Bool is_folder,
+					const std::string &url, const std::string &title, int order_index);
+	static bookmark_item *_new_bookmark_item(const Browser_Bookmark_Tree::node &node);
+	static void _export_folder(Browser_Bookmark_Html_Writer &writer, Browser_Bookmark_Tree *tree, int folder_id);
 	
-	static sqlite3* m_db_descriptor;
+	Browser_DB_Connection *m_db_connection;
+
+	static Browser_Bookmark_Url_Set m_url_set;
+	static Browser_Bookmark_Tree m_tree;
 };
 
 #endif	/* BROWSER_BOOKMARK_DB_H */
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-bookmark-html.h"
+
+#include <unistd.h>
+
+Browser_Bookmark_Html_Reader::Browser_Bookmark_Html_Reader(entry_cb callback, void *user_data)
+:
+	m_callback(callback)
+	,m_user_data(user_data)
+	,m_parser(NULL)
+	,m_is_in_text(EINA_FALSE)
+	,m_has_folder_title(EINA_FALSE)
+	,m_is_stopped(EINA_FALSE)
+{
+}
+
+Browser_Bookmark_Html_Reader::~Browser_Bookmark_Html_Reader(void)
+{
+	if (m_parser)
+		htmlFreeParserCtxt(m_parser);
+}
+
+Eina_Bool Browser_Bookmark_Html_Reader::_call(entry_type type, const std::string &title, const std::string &url)
+{
+	if (m_is_stopped)
+		return EINA_FALSE;
+
+	if (!m_callback(type, title, url, m_user_data)) {
+		m_is_stopped = EINA_TRUE;
+		xmlStopParser(m_parser);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+void Browser_Bookmark_Html_Reader::_flush_folder(void)
+{
+	if (!m_has_folder_title)
+		return;
+
+	m_has_folder_title = EINA_FALSE;
+	if (_call(BOOKMARK_HTML_FOLDER_START, m_folder_title, std::string()))
+		_call(BOOKMARK_HTML_FOLDER_END, m_folder_title, std::string());
+}
+
+void Browser_Bookmark_Html_Reader::__start_element_cb(void *data, const xmlChar *name, const xmlChar **attributes)
+{
+	Browser_Bookmark_Html_Reader *reader = (Browser_Bookmark_Html_Reader *)data;
+	if (reader->m_is_stopped)
+		return;
+
+	/* The HTML parser gives the element names in lower case. */
+	const char *element = (const char *)name;
+	if (!strcmp(element, "dl")) {
+		reader->m_list_stack.push_back(reader->m_has_folder_title);
+		if (reader->m_has_folder_title) {
+			reader->m_has_folder_title = EINA_FALSE;
+			reader->_call(BOOKMARK_HTML_FOLDER_START, reader->m_folder_title, std::string());
+		}
+	} else if (!strcmp(element, "a") || !strcmp(element, "h3")) {
+		reader->_flush_folder();
+		reader->m_text.clear();
+		reader->m_url.clear();
+		reader->m_is_in_text = EINA_TRUE;
+		for (int i = 0 ; attributes && attributes[i] ; i += 2) {
+			if (!strcmp((const char *)attributes[i], "href") && attributes[i + 1])
+				reader->m_url = (const char *)attributes[i + 1];
+		}
+	}
+}
+
+void Browser_Bookmark_Html_Reader::__end_element_cb(void *data, const xmlChar *name)
+{
+	Browser_Bookmark_Html_Reader *reader = (Browser_Bookmark_Html_Reader *)data;
+	if (reader->m_is_stopped)
+		return;
+
+	const char *element = (const char *)name;
+	if (!strcmp(element, "dl")) {
+		reader->_flush_folder();
+		if (reader->m_list_stack.empty())
+			return;
+
+		Eina_Bool is_folder = reader->m_list_stack.back();
+		reader->m_list_stack.pop_back();
+		if (is_folder)
+			reader->_call(BOOKMARK_HTML_FOLDER_END, std::string(), std::string());
+	} else if (!strcmp(element, "a") && reader->m_is_in_text) {
+		reader->m_is_in_text = EINA_FALSE;
+		if (!reader->m_url.empty())
+			reader->_call(BOOKMARK_HTML_BOOKMARK, reader->m_text, reader->m_url);
+	} else if (!strcmp(element, "h3") && reader->m_is_in_text) {
+		reader->m_is_in_text = EINA_FALSE;
+		reader->m_folder_title = reader->m_text;
+		reader->m_has_folder_title = EINA_TRUE;
+	}
+}
+
+void Browser_Bookmark_Html_Reader::__characters_cb(void *data, const xmlChar *text, int length)
+{
+	Browser_Bookmark_Html_Reader *reader = (Browser_Bookmark_Html_Reader *)data;
+	if (reader->m_is_in_text)
+		reader->m_text.append((const char *)text, length);
+}
+
+Eina_Bool Browser_Bookmark_Html_Reader::read(const char *file_path)
+{
+	BROWSER_LOGD("[%s] %s", __func__, file_path);
+	if (!file_path || !m_callback)
+		return EINA_FALSE;
+
+	FILE *file = fopen(file_path, "rb");
+	if (!file) {
+		BROWSER_LOGE("fopen failed [%s]", file_path);
+		return EINA_FALSE;
+	}
+
+	htmlSAXHandler sax_handler;
+	memset(&sax_handler, 0x00, sizeof(htmlSAXHandler));
+	sax_handler.startElement = __start_element_cb;
+	sax_handler.endElement = __end_element_cb;
+	sax_handler.characters = __characters_cb;
+
+	m_parser = htmlCreatePushParserCtxt(&sax_handler, this, NULL, 0, file_path, XML_CHAR_ENCODING_UTF8);
+	if (!m_parser) {
+		BROWSER_LOGE("htmlCreatePushParserCtxt failed");
+		fclose(file);
+		return EINA_FALSE;
+	}
+	htmlCtxtUseOptions(m_parser, HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING | HTML_PARSE_NONET);
+
+	char buffer[BROWSER_BOOKMARK_HTML_CHUNK_SIZE];
+	size_t length;
+	while (!m_is_stopped && (length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		htmlParseChunk(m_parser, buffer, length, 0);
+
+	Eina_Bool is_read = !ferror(file);
+	fclose(file);
+
+	if (!m_is_stopped) {
+		htmlParseChunk(m_parser, buffer, 0, 1);
+		_flush_folder();
+	}
+
+	htmlFreeParserCtxt(m_parser);
+	m_parser = NULL;
+
+	return is_read;
+}
+
+Browser_Bookmark_Html_Writer::Browser_Bookmark_Html_Writer(void)
+:
+	m_file(NULL)
+	,m_depth(0)
+{
+}
+
+Browser_Bookmark_Html_Writer::~Browser_Bookmark_Html_Writer(void)
+{
+	/* Not closed, the file_path is left as it was. */
+	if (m_file) {
+		fclose(m_file);
+		unlink(m_temp_path.c_str());
+	}
+}
+
+Eina_Bool Browser_Bookmark_Html_Writer::open(const char *file_path)
+{
+	BROWSER_LOGD("[%s] %s", __func__, file_path);
+	if (!file_path || m_file)
+		return EINA_FALSE;
+
+	m_file_path = file_path;
+	m_temp_path = m_file_path + ".tmp";
+	m_file = fopen(m_temp_path.c_str(), "w");
+	if (!m_file) {
+		BROWSER_LOGE("fopen failed [%s]", m_temp_path.c_str());
+		return EINA_FALSE;
+	}
+
+	if (setvbuf(m_file, NULL, _IOFBF, BROWSER_BOOKMARK_HTML_BUFFER_SIZE))
+		BROWSER_LOGE("setvbuf failed");
+
+	fputs("<!DOCTYPE NETSCAPE-Bookmark-file-1>\n"
+		"<META HTTP-EQUIV=\"Content-Type\" CONTENT=\"text/html; charset=UTF-8\">\n"
+		"<TITLE>Bookmarks</TITLE>\n"
+		"<H1>Bookmarks</H1>\n"
+		"<DL><p>\n", m_file);
+	m_depth = 1;
+
+	return EINA_TRUE;
+}
+
+void Browser_Bookmark_Html_Writer::_write_indent(void)
+{
+	for (int i = 0 ; i < m_depth ; i++)
+		fputs("    ", m_file);
+}
+
+void Browser_Bookmark_Html_Writer::_write_escaped(const char *text)
+{
+	for (const char *c = text ; c && *c ; c++) {
+		switch (*c) {
+		case '&':
+			fputs("&amp;", m_file);
+			break;
+		case '<':
+			fputs("&lt;", m_file);
+			break;
+		case '>':
+			fputs("&gt;", m_file);
+			break;
+		case '"':
+			fputs("&quot;", m_file);
+			break;
+		default:
+			fputc(*c, m_file);
+			break;
+		}
+	}
+}
+
+void Browser_Bookmark_Html_Writer::add_folder_start(const char *title)
+{
+	if (!m_file)
+		return;
+
+	_write_indent();
+	fputs("<DT><H3>", m_file);
+	_write_escaped(title);
+	fputs("</H3>\n", m_file);
+	_write_indent();
+	fputs("<DL><p>\n", m_file);
+	m_depth++;
+}
+
+void Browser_Bookmark_Html_Writer::add_bookmark(const char *title, const char *url)
+{
+	if (!m_file)
+		return;
+
+	_write_indent();
+	fputs("<DT><A HREF=\"", m_file);
+	_write_escaped(url);
+	fputs("\">", m_file);
+	_write_escaped(title);
+	fputs("</A>\n", m_file);
+}
+
+void Browser_Bookmark_Html_Writer::add_folder_end(void)
+{
+	if (!m_file || m_depth <= 1)
+		return;
+
+	m_depth--;
+	_write_indent();
+	fputs("</DL><p>\n", m_file);
+}
+
+Eina_Bool Browser_Bookmark_Html_Writer::close(void)
+{
+	if (!m_file)
+		return EINA_FALSE;
+
+	while (m_depth > 1)
+		add_folder_end();
+	fputs("</DL><p>\n", m_file);
+
+	Eina_Bool is_written = !ferror(m_file);
+	if (fclose(m_file))
+		is_written = EINA_FALSE;
+	m_file = NULL;
+
+	if (!is_written || rename(m_temp_path.c_str(), m_file_path.c_str())) {
+		BROWSER_LOGE("writing [%s] failed", m_file_path.c_str());
+		unlink(m_temp_path.c_str());
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_BOOKMARK_HTML_H
+#define BROWSER_BOOKMARK_HTML_H
+
+#include "browser-config.h"
+
+#include <libxml/HTMLparser.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+/* Streaming reader of the Netscape bookmark file format, which most browsers import and export:
+  * <DT><H3>folder</H3> followed by a <DL> with its content, and <DT><A HREF="url">title</A> per bookmark.
+  * The file goes through the SAX interface of the libxml2 HTML parser chunk by chunk,
+  * so no document tree is built whatever the size of the file. */
+class Browser_Bookmark_Html_Reader {
+public:
+	typedef enum _entry_type {
+		BOOKMARK_HTML_FOLDER_START	= 0,
+		BOOKMARK_HTML_BOOKMARK,
+		BOOKMARK_HTML_FOLDER_END
+	} entry_type;
+	/* Called per entry in file order, url is empty for the folders. Return EINA_FALSE to stop reading. */
+	typedef Eina_Bool (*entry_cb)(entry_type type, const std::string &title, const std::string &url, void *user_data);
+
+	Browser_Bookmark_Html_Reader(entry_cb callback, void *user_data);
+	~Browser_Bookmark_Html_Reader(void);
+
+	/* Returns EINA_FALSE if the file cannot be read. Stopping from the callback is not a failure. */
+	Eina_Bool read(const char *file_path);
+private:
+	Eina_Bool _call(entry_type type, const std::string &title, const std::string &url);
+	/* A folder title which is not followed by a <DL> is an empty folder. */
+	void _flush_folder(void);
+
+	static void __start_element_cb(void *data, const xmlChar *name, const xmlChar **attributes);
+	static void __end_element_cb(void *data, const xmlChar *name);
+	static void __characters_cb(void *data, const xmlChar *text, int length);
+
+	entry_cb m_callback;
+	void *m_user_data;
+	htmlParserCtxtPtr m_parser;
+	/* One per open <DL>, whether it is the content of a folder. */
+	std::vector<Eina_Bool> m_list_stack;
+	std::string m_text;
+	std::string m_url;
+	std::string m_folder_title;
+	Eina_Bool m_is_in_text;
+	Eina_Bool m_has_folder_title;
+	Eina_Bool m_is_stopped;
+};
+
+/* Writes the Netscape bookmark file format through a stdio buffer of BROWSER_BOOKMARK_HTML_BUFFER_SIZE.
+  * The entries go to a temporary file, which replaces file_path on close(). */
+class Browser_Bookmark_Html_Writer {
+public:
+	Browser_Bookmark_Html_Writer(void);
+	~Browser_Bookmark_Html_Writer(void);
+
+	Eina_Bool open(const char *file_path);
+	void add_folder_start(const char *title);
+	void add_bookmark(const char *title, const char *url);
+	void add_folder_end(void);
+	Eina_Bool close(void);
+private:
+	void _write_indent(void);
+	void _write_escaped(const char *text);
+
+	FILE *m_file;
+	std::string m_file_path;
+	std::string m_temp_path;
+	int m_depth;
+};
+
+#endif	/* BROWSER_BOOKMARK_HTML_H */
+
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-bookmark-tree.h"
+
+#include <algorithm>
+#include <set>
+
+struct Browser_Bookmark_Tree::order_index_compare {
+	order_index_compare(const std::vector<node> &nodes) : m_nodes(nodes) {}
+	bool operator()(int a, int b) const
+	{
+		if (m_nodes[a].order_index != m_nodes[b].order_index)
+			return m_nodes[a].order_index < m_nodes[b].order_index;
+		return m_nodes[a].id < m_nodes[b].id;
+	}
+	const std::vector<node> &m_nodes;
+};
+
+Browser_Bookmark_Tree::Browser_Bookmark_Tree(void)
+:
+	m_generation(0)
+	,m_is_loaded(EINA_FALSE)
+{
+}
+
+Browser_Bookmark_Tree::~Browser_Bookmark_Tree(void)
+{
+}
+
+void Browser_Bookmark_Tree::set_nodes(std::vector<node> &nodes)
+{
+	m_nodes.swap(nodes);
+	reindex();
+	m_is_loaded = EINA_TRUE;
+}
+
+void Browser_Bookmark_Tree::unload(void)
+{
+	std::vector<node>().swap(m_nodes);
+	m_index_by_id.clear();
+	m_children.clear();
+	m_generation++;
+	m_is_loaded = EINA_FALSE;
+}
+
+void Browser_Bookmark_Tree::reindex(void)
+{
+	m_generation++;
+	m_index_by_id.clear();
+	m_children.clear();
+
+	for (int i = 0 ; i < m_nodes.size() ; i++) {
+		m_index_by_id[m_nodes[i].id] = i;
+		m_children[m_nodes[i].parent].push_back(i);
+	}
+
+	std::map<int, std::vector<int> >::iterator iter;
+	for (iter = m_children.begin() ; iter != m_children.end() ; iter++)
+		std::sort(iter->second.begin(), iter->second.end(), order_index_compare(m_nodes));
+}
+
+Browser_Bookmark_Tree::node *Browser_Bookmark_Tree::get_node(int id)
+{
+	std::map<int, int>::iterator iter = m_index_by_id.find(id);
+	if (iter == m_index_by_id.end())
+		return NULL;
+
+	return &m_nodes[iter->second];
+}
+
+const std::vector<int> &Browser_Bookmark_Tree::get_children(int folder_id)
+{
+	std::map<int, std::vector<int> >::iterator iter = m_children.find(folder_id);
+	if (iter == m_children.end())
+		return m_no_children;
+
+	return iter->second;
+}
+
+void Browser_Bookmark_Tree::add(const node &item)
+{
+	m_nodes.push_back(item);
+	reindex();
+}
+
+void Browser_Bookmark_Tree::remove(int id)
+{
+	std::map<int, int>::iterator iter = m_index_by_id.find(id);
+	if (iter == m_index_by_id.end())
+		return;
+
+	m_nodes.erase(m_nodes.begin() + iter->second);
+	reindex();
+}
+
+int Browser_Bookmark_Tree::remove_with_descendants(const std::vector<int> &ids)
+{
+	std::set<int> removed_ids;
+	std::vector<int> folders(ids);
+	while (!folders.empty()) {
+		int id = folders.back();
+		folders.pop_back();
+		if (!removed_ids.insert(id).second)
+			continue;
+
+		const std::vector<int> &children = get_children(id);
+		for (int i = 0 ; i < children.size() ; i++)
+			folders.push_back(m_nodes[children[i]].id);
+	}
+
+	std::vector<node> nodes;
+	nodes.reserve(m_nodes.size());
+	for (int i = 0 ; i < m_nodes.size() ; i++) {
+		if (removed_ids.find(m_nodes[i].id) == removed_ids.end())
+			nodes.push_back(m_nodes[i]);
+	}
+
+	int removed_count = m_nodes.size() - nodes.size();
+	m_nodes.swap(nodes);
+	reindex();
+
+	return removed_count;
+}
+
+void Browser_Bookmark_Tree::add_changed_cb(changed_cb callback, void *user_data)
+{
+	m_changed_cbs.push_back(std::make_pair(callback, user_data));
+}
+
+void Browser_Bookmark_Tree::remove_changed_cb(changed_cb callback, void *user_data)
+{
+	for (int i = 0 ; i < m_changed_cbs.size() ; i++) {
+		if (m_changed_cbs[i].first == callback && m_changed_cbs[i].second == user_data) {
+			m_changed_cbs.erase(m_changed_cbs.begin() + i);
+			return;
+		}
+	}
+}
+
+void Browser_Bookmark_Tree::notify_changed(int folder_id)
+{
+	/* Some changes such as a new title are made in place, without reindex(). */
+	m_generation++;
+
+	/* A callback may remove itself. */
+	std::vector<std::pair<changed_cb, void *> > changed_cbs(m_changed_cbs);
+	for (int i = 0 ; i < changed_cbs.size() ; i++)
+		changed_cbs[i].first(folder_id, changed_cbs[i].second);
+}
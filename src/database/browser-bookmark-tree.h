@@ -0,0 +1,83 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_BOOKMARK_TREE_H
+#define BROWSER_BOOKMARK_TREE_H
+
+#include "browser-config.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/* In memory copy of the bookmarks table.
+  * The nodes are stored in one array, the children of each folder are kept as
+  * indexes into it, ordered by order_index, so folder navigation needs no query. */
+class Browser_Bookmark_Tree {
+public:
+	struct node {
+		int id;
+		int parent;
+		Eina_Bool is_folder;
+		std::string url;
+		std::string title;
+		int order_index;
+	};
+
+	typedef void (*changed_cb)(int folder_id, void *user_data);
+
+	Browser_Bookmark_Tree(void);
+	~Browser_Bookmark_Tree(void);
+
+	/* Takes over the content of nodes. */
+	void set_nodes(std::vector<node> &nodes);
+	void unload(void);
+	Eina_Bool is_loaded(void) { return m_is_loaded; }
+
+	int get_count(void) { return m_nodes.size(); }
+	/* Changes with every reindex() and notify_changed(), so that the indexes built
+	  * on top of the nodes know when to rebuild. */
+	int get_generation(void) { return m_generation; }
+	node &get_node_at(int index) { return m_nodes[index]; }
+	/* NULL if there is no such id. Call reindex() after changing parent or order_index. */
+	node *get_node(int id);
+	const std::vector<int> &get_children(int folder_id);
+
+	void add(const node &item);
+	void remove(int id);
+	/* Removes ids and everything under them, returns the number of nodes removed. */
+	int remove_with_descendants(const std::vector<int> &ids);
+	void reindex(void);
+
+	void add_changed_cb(changed_cb callback, void *user_data);
+	void remove_changed_cb(changed_cb callback, void *user_data);
+	void notify_changed(int folder_id);
+private:
+	struct order_index_compare;
+
+	std::vector<node> m_nodes;
+	std::map<int, int> m_index_by_id;
+	std::map<int, std::vector<int> > m_children;
+	std::vector<int> m_no_children;
+	std::vector<std::pair<changed_cb, void *> > m_changed_cbs;
+	int m_generation;
+	Eina_Bool m_is_loaded;
+};
+
+#endif	/* BROWSER_BOOKMARK_TREE_H */
+
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-bookmark-url-set.h"
+
+#define BROWSER_BOOKMARK_URL_SET_MIN_BUCKETS	64
+
+Browser_Bookmark_Url_Set::Browser_Bookmark_Url_Set(void)
+:
+	m_count(0)
+	,m_is_loaded(EINA_FALSE)
+{
+}
+
+Browser_Bookmark_Url_Set::~Browser_Bookmark_Url_Set(void)
+{
+}
+
+void Browser_Bookmark_Url_Set::_rehash(int bucket_count)
+{
+	std::vector<std::vector<url_entry> > buckets(bucket_count);
+	for (int i = 0 ; i < m_buckets.size() ; i++) {
+		for (int j = 0 ; j < m_buckets[i].size() ; j++) {
+			url_entry &entry = m_buckets[i][j];
+			buckets[(unsigned long long)entry.url_key & (bucket_count - 1)].push_back(entry);
+		}
+	}
+
+	m_buckets.swap(buckets);
+}
+
+void Browser_Bookmark_Url_Set::unload(void)
+{
+	std::vector<std::vector<url_entry> >().swap(m_buckets);
+	m_count = 0;
+	m_is_loaded = EINA_FALSE;
+}
+
+void Browser_Bookmark_Url_Set::add(const char *url, int bookmark_id)
+{
+	if (!url || !strlen(url))
+		return;
+
+	if (m_buckets.empty())
+		_rehash(BROWSER_BOOKMARK_URL_SET_MIN_BUCKETS);
+	else if (m_count >= m_buckets.size())
+		_rehash(m_buckets.size() * 2);
+
+	url_entry entry;
+	entry.url_key = br_url_key(url);
+	entry.bookmark_id = bookmark_id;
+	m_buckets[_get_bucket(entry.url_key)].push_back(entry);
+	m_count++;
+}
+
+void Browser_Bookmark_Url_Set::remove(int bookmark_id)
+{
+	/* Only the id is known at delete time. Deleting is rare enough to walk the whole set. */
+	for (int i = 0 ; i < m_buckets.size() ; i++) {
+		std::vector<url_entry> &bucket = m_buckets[i];
+		for (int j = 0 ; j < bucket.size() ; j++) {
+			if (bucket[j].bookmark_id == bookmark_id) {
+				bucket.erase(bucket.begin() + j);
+				m_count--;
+				return;
+			}
+		}
+	}
+}
+
+Eina_Bool Browser_Bookmark_Url_Set::find(const char *url, int *bookmark_id)
+{
+	if (bookmark_id)
+		*bookmark_id = 0;
+
+	if (!url || m_buckets.empty())
+		return EINA_FALSE;
+
+	sqlite3_int64 url_key = br_url_key(url);
+	std::vector<url_entry> &bucket = m_buckets[_get_bucket(url_key)];
+	Eina_Bool is_found = EINA_FALSE;
+	for (int i = 0 ; i < bucket.size() ; i++) {
+		if (bucket[i].url_key != url_key)
+			continue;
+
+		if (bookmark_id && (!is_found || bucket[i].bookmark_id < *bookmark_id))
+			*bookmark_id = bucket[i].bookmark_id;
+		is_found = EINA_TRUE;
+	}
+
+	return is_found;
+}
+
+void Browser_Bookmark_Url_Set::get_bookmark_ids(const char *url, std::vector<int> &bookmark_ids)
+{
+	if (!url || m_buckets.empty())
+		return;
+
+	sqlite3_int64 url_key = br_url_key(url);
+	std::vector<url_entry> &bucket = m_buckets[_get_bucket(url_key)];
+	for (int i = 0 ; i < bucket.size() ; i++) {
+		if (bucket[i].url_key == url_key)
+			bookmark_ids.push_back(bucket[i].bookmark_id);
+	}
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_BOOKMARK_URL_SET_H
+#define BROWSER_BOOKMARK_URL_SET_H
+
+#include "browser-config.h"
+#include "browser-url-key.h"
+
+#include <vector>
+
+/* Hashed in memory set of the bookmarked addresses, so that is_in_bookmark()
+  * can be called per genlist item without touching the bookmark database.
+  * The addresses are compared by br_url_key(), "http://a.com/" is bookmarked if "https://a.com" is.
+  * The same address may be bookmarked in several folders, each one is an entry. */
+class Browser_Bookmark_Url_Set {
+public:
+	Browser_Bookmark_Url_Set(void);
+	~Browser_Bookmark_Url_Set(void);
+
+	void unload(void);
+	Eina_Bool is_loaded(void) { return m_is_loaded; }
+	/* Marks the set loaded, the entries are added with add() before. */
+	void set_loaded(void) { m_is_loaded = EINA_TRUE; }
+
+	void add(const char *url, int bookmark_id);
+	void remove(int bookmark_id);
+	/* bookmark_id returns the lowest id bookmarked with url, or 0. */
+	Eina_Bool find(const char *url, int *bookmark_id);
+	/* Every id bookmarked with url, probing only the entries of its key. */
+	void get_bookmark_ids(const char *url, std::vector<int> &bookmark_ids);
+private:
+	struct url_entry {
+		sqlite3_int64 url_key;
+		int bookmark_id;
+	};
+
+	int _get_bucket(sqlite3_int64 url_key) { return (int)((unsigned long long)url_key & (m_buckets.size() - 1)); }
+	void _rehash(int bucket_count);
+
+	std::vector<std::vector<url_entry> > m_buckets;
+	int m_count;
+	Eina_Bool m_is_loaded;
+};
+
+#endif	/* BROWSER_BOOKMARK_URL_SET_H */
+
@@ -0,0 +1,547 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+using namespace std;
+
+#include "browser-db-connection.h"
+#include "browser-favicon.h"
+#include "browser-frecency.h"
+#include "browser-url-key.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Offset of the big endian "file change counter" in the database header,
+  * incremented by every transaction committed with a rollback journal. */
+#define BROWSER_DB_CHANGE_COUNTER_OFFSET	24
+
+std::map<std::string, Browser_DB_Connection *> Browser_DB_Connection::m_connection_map;
+
+/* Schema changes applied in-app on top of the tables created at install time.
+  * Each database file records the last version it has in PRAGMA user_version.
+  * To change a schema, append entries with the next version number for that file.
+  * Never edit or reorder the existing ones, installed devices have already run them. */
+struct browser_db_migration {
+	const char *db_path;
+	int version;
+	const char *query;
+};
+
+static const browser_db_migration browser_db_migrations[] = {
+	{BROWSER_HISTORY_DB_PATH, 1, "create index if not exists idx_history_on_address on history(address)"},
+	{BROWSER_HISTORY_DB_PATH, 1, "create index if not exists idx_history_on_counter on history(counter desc)"},
+	{BROWSER_HISTORY_DB_PATH, 1, "create index if not exists idx_history_on_visitdate on history(visitdate desc)"},
+	{BROWSER_GEOLOCATION_DB_PATH, 1, "create index if not exists idx_geolocation_on_address on geolocation(address)"},
+#if defined(FEATURE_MOST_VISITED_SITES)
+	{BROWSER_MOST_VISITED_SITES_DB_PATH, 1, "create index if not exists idx_mostvisited_on_address on mostvisited(address)"},
+#endif
+	/* Version 2 : one row per address and a maintained row count for the eviction in save_history. */
+	{BROWSER_HISTORY_DB_PATH, 2, "delete from history where id not in (select max(id) from history group by address)"},
+	{BROWSER_HISTORY_DB_PATH, 2, "drop index if exists idx_history_on_address"},
+	{BROWSER_HISTORY_DB_PATH, 2, "create unique index idx_history_on_address on history(address)"},
+	{BROWSER_HISTORY_DB_PATH, 2, "create table if not exists history_stats(row_count integer not null)"},
+	{BROWSER_HISTORY_DB_PATH, 2, "delete from history_stats"},
+	{BROWSER_HISTORY_DB_PATH, 2, "insert into history_stats (row_count) select count(*) from history"},
+	{BROWSER_HISTORY_DB_PATH, 2, "create trigger if not exists history_stats_on_insert after insert on history"
+					" begin update history_stats set row_count = row_count + 1; end"},
+	{BROWSER_HISTORY_DB_PATH, 2, "create trigger if not exists history_stats_on_delete after delete on history"
+					" begin update history_stats set row_count = row_count - 1; end"},
+	/* Version 3 : frecency, the existing visits are counted at the last visit date. */
+	{BROWSER_HISTORY_DB_PATH, 3, "alter table history add column frecency real"},
+	{BROWSER_HISTORY_DB_PATH, 3, "update history set frecency = br_frecency(null, counter + 1, julianday(visitdate))"},
+	{BROWSER_HISTORY_DB_PATH, 3, "create index if not exists idx_history_on_frecency on history(frecency desc)"},
+	/* Version 4 : a unique order for the pages of get_history_page. */
+	{BROWSER_HISTORY_DB_PATH, 4, "drop index if exists idx_history_on_visitdate"},
+	{BROWSER_HISTORY_DB_PATH, 4, "create index if not exists idx_history_on_visitdate_id on history(visitdate desc, id desc)"},
+	{BROWSER_HISTORY_DB_PATH, 5, "create table if not exists maintenance_stats(id integer primary key autoincrement, rundate DATETIME, db, step, result, duration integer)"},
+	/* Version 6 : the addresses evicted from history are kept in an archive, see Browser_History_DB. */
+	{BROWSER_HISTORY_DB_PATH, 6, "create table if not exists history_hosts(id integer primary key, host text not null unique)"},
+	{BROWSER_HISTORY_DB_PATH, 6, "create table if not exists history_archive(id integer primary key, host_id integer not null,"
+					" path text not null, title, counter integer, visitdate DATETIME, frecency real)"},
+	{BROWSER_HISTORY_DB_PATH, 6, "create unique index if not exists idx_history_archive_on_host_path on history_archive(host_id, path)"},
+	{BROWSER_HISTORY_DB_PATH, 6, "create index if not exists idx_history_archive_on_frecency on history_archive(frecency desc)"},
+	{BROWSER_HISTORY_DB_PATH, 6, "create index if not exists idx_history_archive_on_visitdate_id on history_archive(visitdate desc, id desc)"},
+	/* Version 7 : a log of the visits with their local day, and its count per day and address.
+	  * The weight is the frecency of the visit, so that it can be taken out again. */
+	{BROWSER_HISTORY_DB_PATH, 7, "create table if not exists history_visits(id integer primary key, url_id integer not null,"
+					" visittime integer not null, transition integer not null, weight real not null, day text not null)"},
+	{BROWSER_HISTORY_DB_PATH, 7, "create index if not exists idx_history_visits_on_visittime on history_visits(visittime)"},
+	{BROWSER_HISTORY_DB_PATH, 7, "create index if not exists idx_history_visits_on_url_id on history_visits(url_id, visittime)"},
+	{BROWSER_HISTORY_DB_PATH, 7, "create table if not exists history_daily_visits(day text not null, url_id integer not null,"
+					" visit_count integer not null, last_visittime integer not null, primary key(day, url_id))"},
+	{BROWSER_HISTORY_DB_PATH, 7, "create trigger if not exists history_visits_on_insert after insert on history_visits begin"
+					" insert or ignore into history_daily_visits (day, url_id, visit_count, last_visittime)"
+						" values(new.day, new.url_id, 0, new.visittime);"
+					" update history_daily_visits set visit_count = visit_count + 1,"
+						" last_visittime = max(last_visittime, new.visittime) where day = new.day and url_id = new.url_id;"
+					" end"},
+	{BROWSER_HISTORY_DB_PATH, 7, "create trigger if not exists history_visits_on_delete after delete on history_visits begin"
+					" delete from history_daily_visits where day = old.day and url_id = old.url_id and visit_count <= 1;"
+					" update history_daily_visits set visit_count = visit_count - 1,"
+						" last_visittime = (select max(visittime) from history_visits where url_id = old.url_id and day = old.day)"
+						" where day = old.day and url_id = old.url_id;"
+					" end"},
+	/* Only the last visit of the existing addresses is known. */
+	{BROWSER_HISTORY_DB_PATH, 7, "insert into history_visits (url_id, visittime, transition, weight, day)"
+					" select id, strftime('%s', visitdate), 0, 1.0, date(visitdate, 'localtime') from history"},
+	{BROWSER_HISTORY_DB_PATH, 7, "insert into history_visits (url_id, visittime, transition, weight, day)"
+					" select id, strftime('%s', visitdate), 0, 1.0, date(visitdate, 'localtime') from history_archive"},
+	/* Version 8 : the key of the canonical address, see br_url_key().
+	  * The rows which are already duplicates by key are left as they are, the next visit goes to the newest one. */
+	{BROWSER_HISTORY_DB_PATH, 8, "alter table history add column url_key integer"},
+	{BROWSER_HISTORY_DB_PATH, 8, "update history set url_key = br_url_key(address)"},
+	{BROWSER_HISTORY_DB_PATH, 8, "create index if not exists idx_history_on_url_key on history(url_key)"},
+	/* Version 9 : the history pages are read by day and address, newest first. */
+	{BROWSER_HISTORY_DB_PATH, 9, "create index if not exists idx_history_daily_visits_on_last_visittime"
+					" on history_daily_visits(last_visittime desc, url_id desc)"},
+	/* Version 10 : the archived addresses are found by the key of their canonical address too. */
+	{BROWSER_HISTORY_DB_PATH, 10, "alter table history_archive add column url_key integer"},
+	{BROWSER_HISTORY_DB_PATH, 10, "update history_archive set url_key ="
+					" br_url_key((select host from history_hosts where id = host_id) || path)"},
+	{BROWSER_HISTORY_DB_PATH, 10, "create index if not exists idx_history_archive_on_url_key on history_archive(url_key)"},
+	/* Version 11 : the rows which other processes inserted since version 7 have no visit,
+	  * their last one is logged so that they are shown in the history pages. */
+	{BROWSER_HISTORY_DB_PATH, 11, "insert into history_visits (url_id, visittime, transition, weight, day)"
+					" select id, strftime('%s', ifnull(visitdate, 'now')), 0, 1.0, date(ifnull(visitdate, 'now'), 'localtime')"
+					" from history h where not exists (select 1 from history_visits v where v.url_id = h.id)"},
+	/* Version 12 : one icon per host instead of a copy in each row, see Browser_Favicon.
+	  * The favicon columns were only written by the browser, they are emptied. */
+	{BROWSER_HISTORY_DB_PATH, 12, "create table if not exists favicons(host text primary key, favicon blob not null,"
+					" favicon_w integer, favicon_h integer)"},
+	{BROWSER_HISTORY_DB_PATH, 12, "insert or ignore into favicons (host, favicon, favicon_w, favicon_h)"
+					" select br_favicon_host(address), favicon, favicon_w, favicon_h from history"
+					" where favicon is not null and address is not null"},
+	{BROWSER_HISTORY_DB_PATH, 12, "update history set favicon = null, favicon_length = null, favicon_w = null, favicon_h = null"
+					" where favicon is not null"},
+	{BROWSER_BOOKMARK_DB_PATH, 1, "create table if not exists favicons(host text primary key, favicon blob not null,"
+					" favicon_w integer, favicon_h integer)"},
+	{BROWSER_BOOKMARK_DB_PATH, 1, "insert or ignore into favicons (host, favicon, favicon_w, favicon_h)"
+					" select br_favicon_host(address), favicon, favicon_w, favicon_h from bookmarks"
+					" where favicon is not null and address is not null"},
+	{BROWSER_BOOKMARK_DB_PATH, 1, "update bookmarks set favicon = null, favicon_length = null, favicon_w = null, favicon_h = null"
+					" where favicon is not null"},
+};
+
+/* Durability of each file, applied whenever a connection is opened.
+  * The files are created with journal_mode=PERSIST and used with the default synchronous=FULL,
+  * an fsync of the journal and of the file per commit.
+  * In WAL mode with synchronous=NORMAL a commit is an append to the -wal file and the fsync
+  * happens only at checkpoint. A power loss may drop the last commits but does not corrupt the file,
+  * which is acceptable for the history and the most visited sites but not for the bookmarks.
+  * mmap_size 0 leaves the default. A sqlite older than 3.7.17 ignores the pragma. */
+struct browser_db_profile {
+	const char *db_path;
+	const char *journal_mode;
+	const char *synchronous;
+	int mmap_size;
+};
+
+static const browser_db_profile browser_db_profiles[] = {
+	{BROWSER_HISTORY_DB_PATH, "wal", "normal", BROWSER_DB_HISTORY_MMAP_SIZE},
+#if defined(FEATURE_MOST_VISITED_SITES)
+	{BROWSER_MOST_VISITED_SITES_DB_PATH, "wal", "normal", 0},
+#endif
+	{BROWSER_BOOKMARK_DB_PATH, "persist", "full", 0},
+};
+
+Browser_DB_Connection::Browser_DB_Connection(const char *db_path)
+:
+	m_db_path(db_path)
+	,m_db_descriptor(NULL)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	memset(&m_synced_stamp, 0x00, sizeof(file_stamp));
+}
+
+Browser_DB_Connection::~Browser_DB_Connection(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	_close_db();
+}
+
+Browser_DB_Connection *Browser_DB_Connection::get_connection(const char *db_path)
+{
+	if (!db_path || strlen(db_path) == 0) {
+		BROWSER_LOGE("db_path is empty");
+		return NULL;
+	}
+
+	std::map<std::string, Browser_DB_Connection *>::iterator iter = m_connection_map.find(db_path);
+	if (iter != m_connection_map.end())
+		return iter->second;
+
+	Browser_DB_Connection *connection = new(nothrow) Browser_DB_Connection(db_path);
+	if (!connection) {
+		BROWSER_LOGE("new Browser_DB_Connection failed");
+		return NULL;
+	}
+
+	/* Do not remember a failed open, so that the next caller can retry. */
+	if (!connection->_open_db()) {
+		BROWSER_LOGE("_open_db failed [%s]", db_path);
+		delete connection;
+		return NULL;
+	}
+
+	m_connection_map[db_path] = connection;
+
+	return connection;
+}
+
+void Browser_DB_Connection::close_all_connections(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	std::map<std::string, Browser_DB_Connection *>::iterator iter;
+	for (iter = m_connection_map.begin() ; iter != m_connection_map.end() ; iter++)
+		delete iter->second;
+
+	m_connection_map.clear();
+}
+
+void Browser_DB_Connection::mark_all_synced(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	std::map<std::string, Browser_DB_Connection *>::iterator iter;
+	for (iter = m_connection_map.begin() ; iter != m_connection_map.end() ; iter++)
+		iter->second->_get_file_stamp(&iter->second->m_synced_stamp);
+}
+
+/* The device sqlite has no PRAGMA data_version, so the files are looked at directly.
+  * A commit with a rollback journal bumps the change counter of the header,
+  * a commit in WAL mode only appends to or rewrites the -wal file. */
+void Browser_DB_Connection::_get_file_stamp(file_stamp *stamp)
+{
+	memset(stamp, 0x00, sizeof(file_stamp));
+
+	int fd = open(m_db_path.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		unsigned char counter[4] = {0, };
+		if (pread(fd, counter, sizeof(counter), BROWSER_DB_CHANGE_COUNTER_OFFSET) == sizeof(counter))
+			stamp->change_counter = (counter[0] << 24) | (counter[1] << 16) | (counter[2] << 8) | counter[3];
+		close(fd);
+	}
+
+	struct stat wal_stat;
+	std::string wal_path = m_db_path + "-wal";
+	if (stat(wal_path.c_str(), &wal_stat) == 0) {
+		stamp->wal_mtime = wal_stat.st_mtim.tv_sec;
+		stamp->wal_mtime_nsec = wal_stat.st_mtim.tv_nsec;
+		stamp->wal_size = wal_stat.st_size;
+	}
+}
+
+Eina_Bool Browser_DB_Connection::has_external_change(void)
+{
+	file_stamp stamp;
+	_get_file_stamp(&stamp);
+
+	if (stamp.change_counter == m_synced_stamp.change_counter
+	    && stamp.wal_mtime == m_synced_stamp.wal_mtime
+	    && stamp.wal_mtime_nsec == m_synced_stamp.wal_mtime_nsec
+	    && stamp.wal_size == m_synced_stamp.wal_size)
+		return EINA_FALSE;
+
+	BROWSER_LOGD("[%s] changed", m_db_path.c_str());
+	m_synced_stamp = stamp;
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_DB_Connection::_open_db(void)
+{
+	BROWSER_LOGD("[%s]", m_db_path.c_str());
+	int error = db_util_open(m_db_path.c_str(), &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
+	if (error != SQLITE_OK) {
+		db_util_close(m_db_descriptor);
+		m_db_descriptor = NULL;
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_busy_timeout(m_db_descriptor, BROWSER_DB_BUSY_TIMEOUT) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_busy_timeout failed");
+
+	if (!_apply_profile())
+		BROWSER_LOGE("_apply_profile failed [%s]", m_db_path.c_str());
+
+	/* Needed by the queries and the migrations. */
+	if (br_frecency_register_functions(m_db_descriptor) != SQLITE_OK)
+		BROWSER_LOGE("br_frecency_register_functions failed");
+	if (br_url_key_register_functions(m_db_descriptor) != SQLITE_OK)
+		BROWSER_LOGE("br_url_key_register_functions failed");
+	if (br_favicon_register_functions(m_db_descriptor) != SQLITE_OK)
+		BROWSER_LOGE("br_favicon_register_functions failed");
+
+	/* The database is still usable with the old schema, so a failed migration is not fatal. */
+	if (!_migrate())
+		BROWSER_LOGE("_migrate failed [%s]", m_db_path.c_str());
+
+	_get_file_stamp(&m_synced_stamp);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_DB_Connection::begin_transaction(void)
+{
+	char *error_message = NULL;
+	/* Take the write lock up front, so the transaction can not fail half way with SQLITE_BUSY. */
+	if (sqlite3_exec(m_db_descriptor, "begin immediate", NULL, NULL, &error_message) != SQLITE_OK) {
+		BROWSER_LOGE("begin immediate failed [%s]", error_message);
+		sqlite3_free(error_message);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_DB_Connection::commit_transaction(void)
+{
+	char *error_message = NULL;
+	if (sqlite3_exec(m_db_descriptor, "commit", NULL, NULL, &error_message) != SQLITE_OK) {
+		BROWSER_LOGE("commit failed [%s]", error_message);
+		sqlite3_free(error_message);
+		rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_DB_Connection::rollback_transaction(void)
+{
+	char *error_message = NULL;
+	if (sqlite3_exec(m_db_descriptor, "rollback", NULL, NULL, &error_message) != SQLITE_OK) {
+		BROWSER_LOGE("rollback failed [%s]", error_message);
+		sqlite3_free(error_message);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_DB_Connection::_apply_profile(void)
+{
+	const browser_db_profile *profile = NULL;
+	unsigned int count = sizeof(browser_db_profiles) / sizeof(browser_db_profiles[0]);
+	for (unsigned int i = 0 ; i < count ; i++) {
+		if (m_db_path == browser_db_profiles[i].db_path) {
+			profile = &browser_db_profiles[i];
+			break;
+		}
+	}
+
+	if (!profile)
+		return EINA_TRUE;
+
+	std::string journal_mode = _get_pragma_text((std::string("pragma journal_mode=") + profile->journal_mode).c_str());
+	/* Changing the journal mode fails while another process has the file open, it is retried on the next open. */
+	if (strcasecmp(journal_mode.c_str(), profile->journal_mode))
+		BROWSER_LOGE("[%s] journal_mode is %s", m_db_path.c_str(), journal_mode.c_str());
+
+	char *error_message = NULL;
+	std::string query = std::string("pragma synchronous=") + profile->synchronous;
+	if (sqlite3_exec(m_db_descriptor, query.c_str(), NULL, NULL, &error_message) != SQLITE_OK) {
+		BROWSER_LOGE("[%s] failed [%s]", query.c_str(), error_message);
+		sqlite3_free(error_message);
+		return EINA_FALSE;
+	}
+
+	if (profile->mmap_size > 0) {
+		char mmap_size[32] = {0, };
+		snprintf(mmap_size, sizeof(mmap_size) - 1, "%d", profile->mmap_size);
+		_get_pragma_text((std::string("pragma mmap_size=") + mmap_size).c_str());
+	}
+
+	return EINA_TRUE;
+}
+
+std::string Browser_DB_Connection::_get_pragma_text(const char *query)
+{
+	std::string result;
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = sqlite3_prepare_v2(m_db_descriptor, query, -1, &sqlite3_stmt, NULL);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return result;
+	}
+
+	if (sqlite3_step(sqlite3_stmt) == SQLITE_ROW) {
+		const char *text = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
+		if (text)
+			result = text;
+	}
+
+	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return result;
+}
+
+int Browser_DB_Connection::_get_user_version(void)
+{
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = sqlite3_prepare_v2(m_db_descriptor, "pragma user_version", -1, &sqlite3_stmt, NULL);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return -1;
+	}
+
+	int version = -1;
+	if (sqlite3_step(sqlite3_stmt) == SQLITE_ROW)
+		version = sqlite3_column_int(sqlite3_stmt, 0);
+
+	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return version;
+}
+
+Eina_Bool Browser_DB_Connection::_migrate(void)
+{
+	int current_version = _get_user_version();
+	if (current_version < 0)
+		return EINA_FALSE;
+
+	int target_version = current_version;
+	unsigned int count = sizeof(browser_db_migrations) / sizeof(browser_db_migrations[0]);
+	for (unsigned int i = 0 ; i < count ; i++) {
+		if (m_db_path == browser_db_migrations[i].db_path && browser_db_migrations[i].version > target_version)
+			target_version = browser_db_migrations[i].version;
+	}
+
+	if (target_version == current_version)
+		return EINA_TRUE;
+
+	BROWSER_LOGD("[%s] user_version %d -> %d", m_db_path.c_str(), current_version, target_version);
+
+	if (!begin_transaction())
+		return EINA_FALSE;
+
+	/* Another connection to the same file may have migrated it while waiting for the lock. */
+	current_version = _get_user_version();
+	if (current_version < 0 || current_version >= target_version)
+		return commit_transaction() && current_version >= 0;
+
+	char *error_message = NULL;
+
+	/* The steps of all pending versions are applied in one transaction,
+	  * so the file is either fully upgraded or left as it was. */
+	for (unsigned int i = 0 ; i < count ; i++) {
+		if (m_db_path != browser_db_migrations[i].db_path || browser_db_migrations[i].version <= current_version)
+			continue;
+
+		if (sqlite3_exec(m_db_descriptor, browser_db_migrations[i].query, NULL, NULL, &error_message) != SQLITE_OK) {
+			BROWSER_LOGE("[%s] failed [%s]", browser_db_migrations[i].query, error_message);
+			sqlite3_free(error_message);
+			rollback_transaction();
+			return EINA_FALSE;
+		}
+	}
+
+	char version_query[64] = {0, };
+	snprintf(version_query, sizeof(version_query), "pragma user_version = %d", target_version);
+	if (sqlite3_exec(m_db_descriptor, version_query, NULL, NULL, &error_message) != SQLITE_OK) {
+		BROWSER_LOGE("[%s] failed [%s]", version_query, error_message);
+		sqlite3_free(error_message);
+		rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	return commit_transaction();
+}
+
+Eina_Bool Browser_DB_Connection::_close_db(void)
+{
+	BROWSER_LOGD("[%s]", m_db_path.c_str());
+	std::map<std::string, sqlite3_stmt *>::iterator iter;
+	for (iter = m_statement_cache.begin() ; iter != m_statement_cache.end() ; iter++) {
+		if (sqlite3_finalize(iter->second) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	}
+	m_statement_cache.clear();
+	m_statements_in_use.clear();
+
+	if (m_db_descriptor) {
+		int error = db_util_close(m_db_descriptor);
+		if (error != SQLITE_OK) {
+			BROWSER_LOGE("db_util_close error");
+			m_db_descriptor = NULL;
+			return EINA_FALSE;
+		}
+		m_db_descriptor = NULL;
+	}
+
+	return EINA_TRUE;
+}
+
+int Browser_DB_Connection::prepare_statement(const char *query, sqlite3_stmt **statement)
+{
+	*statement = NULL;
+	if (!m_db_descriptor)
+		return SQLITE_MISUSE;
+
+	std::map<std::string, sqlite3_stmt *>::iterator iter = m_statement_cache.find(query);
+	if (iter != m_statement_cache.end()) {
+		/* A cached statement can be requested again while it is still stepping,
+		  * e.g. by a nested call. Hand out a private copy in that case. */
+		if (m_statements_in_use.find(iter->second) == m_statements_in_use.end()) {
+			*statement = iter->second;
+			m_statements_in_use.insert(*statement);
+			return SQLITE_OK;
+		}
+
+		return sqlite3_prepare_v2(m_db_descriptor, query, -1, statement, NULL);
+	}
+
+	int error = sqlite3_prepare_v2(m_db_descriptor, query, -1, statement, NULL);
+	if (error != SQLITE_OK)
+		return error;
+
+	if (m_statement_cache.size() < BROWSER_DB_STATEMENT_CACHE_MAX) {
+		m_statement_cache[query] = *statement;
+		m_statements_in_use.insert(*statement);
+	}
+
+	return SQLITE_OK;
+}
+
+int Browser_DB_Connection::release_statement(sqlite3_stmt *statement)
+{
+	if (!statement)
+		return SQLITE_OK;
+
+	if (m_statements_in_use.erase(statement) == 0) {
+		std::map<std::string, sqlite3_stmt *>::iterator iter = m_statement_cache.find(sqlite3_sql(statement));
+		if (iter == m_statement_cache.end() || iter->second != statement) {
+			/* Not owned by the cache. */
+			return sqlite3_finalize(statement);
+		}
+		BROWSER_LOGE("statement is released twice [%s]", sqlite3_sql(statement));
+	}
+
+	/* Same return value as sqlite3_finalize : the error of the last sqlite3_step, if any. */
+	int error = sqlite3_reset(statement);
+	sqlite3_clear_bindings(statement);
+
+	return error;
+}
+
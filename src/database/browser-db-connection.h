@@ -0,0 +1,97 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_DB_CONNECTION_H
+#define BROWSER_DB_CONNECTION_H
+
+#include "browser-config.h"
+
+extern "C" {
+#include "db-util.h"
+}
+
+#include <map>
+#include <set>
+#include <string>
+#include <sys/types.h>
+
+/* Statements which are built at run time (e.g. with a variable number of terms)
+  * are not worth caching. Once the cache holds this many entries, any new query
+  * is prepared and finalized per use as before. */
+#define BROWSER_DB_STATEMENT_CACHE_MAX	32
+/* The worker thread of Browser_DB_Executor has its own connections to the same files,
+  * so a statement may have to wait for the lock of the other side. */
+#define BROWSER_DB_BUSY_TIMEOUT	3000 // msec
+/* The history is read on every url entry change and history view page. */
+#define BROWSER_DB_HISTORY_MMAP_SIZE	(4 * 1024 * 1024)
+
+class Browser_DB_Connection {
+	friend class Browser_DB_Executor;
+public:
+	/* One connection is kept open per database file for the life time of the browser.
+	  * Every *_DB class gets its descriptor here instead of opening the file per query. */
+	static Browser_DB_Connection *get_connection(const char *db_path);
+	static void close_all_connections(void);
+	/* The bookmark and history files are shared with other applications.
+	  * mark_all_synced() remembers the state of every open file when the browser stops
+	  * writing (on pause), has_external_change() tells whether another process
+	  * has written to the file since then, so that the in-memory caches can be kept until it does. */
+	static void mark_all_synced(void);
+	Eina_Bool has_external_change(void);
+
+	sqlite3 *get_descriptor(void) { return m_db_descriptor; }
+
+	/* The returned statement is owned by the connection.
+	  * It is handed out reset and with all bindings cleared,
+	  * and must be given back with release_statement() instead of sqlite3_finalize(). */
+	int prepare_statement(const char *query, sqlite3_stmt **statement);
+	int release_statement(sqlite3_stmt *statement);
+
+	Eina_Bool begin_transaction(void);
+	Eina_Bool commit_transaction(void);
+	Eina_Bool rollback_transaction(void);
+private:
+	struct file_stamp {
+		unsigned int change_counter;
+		time_t wal_mtime;
+		long wal_mtime_nsec;
+		off_t wal_size;
+	};
+
+	Browser_DB_Connection(const char *db_path);
+	~Browser_DB_Connection(void);
+
+	Eina_Bool _open_db(void);
+	Eina_Bool _close_db(void);
+	Eina_Bool _apply_profile(void);
+	std::string _get_pragma_text(const char *query);
+	int _get_user_version(void);
+	Eina_Bool _migrate(void);
+	void _get_file_stamp(file_stamp *stamp);
+
+	std::string m_db_path;
+	sqlite3 *m_db_descriptor;
+	std::map<std::string, sqlite3_stmt *> m_statement_cache;
+	std::set<sqlite3_stmt *> m_statements_in_use;
+	file_stamp m_synced_stamp;
+
+	static std::map<std::string, Browser_DB_Connection *> m_connection_map;
+};
+
+#endif	/* BROWSER_DB_CONNECTION_H */
+
@@ -0,0 +1,290 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-db-executor.h"
+
+Browser_DB_Executor *Browser_DB_Executor::m_instance = NULL;
+
+Browser_DB_Job::Browser_DB_Job(void)
+:
+	m_id(0)
+	,m_priority(BROWSER_DB_JOB_PRIORITY_NORMAL)
+	,m_is_cancelled(EINA_FALSE)
+{
+}
+
+Browser_DB_Job::~Browser_DB_Job(void)
+{
+}
+
+Browser_DB_Executor::Browser_DB_Executor(void)
+:
+	m_thread(NULL)
+	,m_running_job_id(0)
+	,m_last_job_id(0)
+	,m_is_quitting(EINA_FALSE)
+	,m_is_thread_finished(EINA_FALSE)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	eina_lock_new(&m_lock);
+	eina_condition_new(&m_condition, &m_lock);
+}
+
+Browser_DB_Executor::~Browser_DB_Executor(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	_stop();
+
+	eina_condition_free(&m_condition);
+	eina_lock_free(&m_lock);
+}
+
+Browser_DB_Executor *Browser_DB_Executor::get_instance(void)
+{
+	if (m_instance)
+		return m_instance;
+
+	m_instance = new(nothrow) Browser_DB_Executor;
+	if (!m_instance) {
+		BROWSER_LOGE("new Browser_DB_Executor failed");
+		return NULL;
+	}
+
+	if (!m_instance->_start()) {
+		BROWSER_LOGE("_start failed");
+		delete m_instance;
+		m_instance = NULL;
+	}
+
+	return m_instance;
+}
+
+void Browser_DB_Executor::destroy_instance(void)
+{
+	if (m_instance) {
+		delete m_instance;
+		m_instance = NULL;
+	}
+}
+
+Eina_Bool Browser_DB_Executor::_start(void)
+{
+	/* try_no_queue : the worker lives as long as the browser, do not hold a thread of the pool. */
+	m_thread = ecore_thread_feedback_run(__worker_thread_cb, NULL, __worker_thread_end_cb,
+						__worker_thread_end_cb, this, EINA_TRUE);
+	if (!m_thread) {
+		BROWSER_LOGE("ecore_thread_feedback_run failed");
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+void Browser_DB_Executor::_stop(void)
+{
+	if (!m_thread)
+		return;
+
+	eina_lock_take(&m_lock);
+	m_is_quitting = EINA_TRUE;
+	eina_condition_broadcast(&m_condition);
+	/* The main loop may not run again at exit, so wait here instead of in the end callback. */
+	while (!m_is_thread_finished)
+		eina_condition_wait(&m_condition);
+
+	/* The done() of these were posted to the main loop but will not be called any more. */
+	std::map<int, Browser_DB_Job *>::iterator iter;
+	for (iter = m_jobs.begin() ; iter != m_jobs.end() ; iter++)
+		iter->second->m_is_cancelled = EINA_TRUE;
+	eina_lock_release(&m_lock);
+
+	m_thread = NULL;
+}
+
+int Browser_DB_Executor::post(Browser_DB_Job *job, int priority)
+{
+	if (!job)
+		return 0;
+
+	eina_lock_take(&m_lock);
+	if (m_is_quitting) {
+		eina_lock_release(&m_lock);
+		BROWSER_LOGE("executor is quitting");
+		return 0;
+	}
+
+	job->m_id = ++m_last_job_id;
+	job->m_priority = priority;
+
+	std::list<Browser_DB_Job *>::iterator iter = m_queue.begin();
+	while (iter != m_queue.end() && (*iter)->m_priority >= priority)
+		iter++;
+	m_queue.insert(iter, job);
+	m_jobs[job->m_id] = job;
+
+	int job_id = job->m_id;
+	eina_condition_broadcast(&m_condition);
+	eina_lock_release(&m_lock);
+
+	return job_id;
+}
+
+void Browser_DB_Executor::cancel(int job_id)
+{
+	eina_lock_take(&m_lock);
+	std::map<int, Browser_DB_Job *>::iterator iter = m_jobs.find(job_id);
+	if (iter == m_jobs.end()) {
+		eina_lock_release(&m_lock);
+		return;
+	}
+
+	Browser_DB_Job *job = iter->second;
+	job->m_is_cancelled = EINA_TRUE;
+
+	/* Not started yet : drop it. Otherwise __job_done_cb deletes it. */
+	std::list<Browser_DB_Job *>::iterator queue_iter;
+	for (queue_iter = m_queue.begin() ; queue_iter != m_queue.end() ; queue_iter++) {
+		if (*queue_iter == job) {
+			m_queue.erase(queue_iter);
+			m_jobs.erase(iter);
+			delete job;
+			break;
+		}
+	}
+
+	eina_condition_broadcast(&m_condition);
+	eina_lock_release(&m_lock);
+}
+
+void Browser_DB_Executor::wait(int job_id)
+{
+	eina_lock_take(&m_lock);
+	while (!m_is_thread_finished) {
+		Eina_Bool is_pending = (m_running_job_id == job_id);
+		std::list<Browser_DB_Job *>::iterator iter;
+		for (iter = m_queue.begin() ; iter != m_queue.end() && !is_pending ; iter++) {
+			if ((*iter)->m_id == job_id)
+				is_pending = EINA_TRUE;
+		}
+		if (!is_pending)
+			break;
+
+		eina_condition_wait(&m_condition);
+	}
+	eina_lock_release(&m_lock);
+}
+
+Browser_DB_Connection *Browser_DB_Executor::get_worker_connection(const char *db_path)
+{
+	std::map<std::string, Browser_DB_Connection *>::iterator iter = m_worker_connections.find(db_path);
+	if (iter != m_worker_connections.end())
+		return iter->second;
+
+	/* Separate from the connections of the main loop, a sqlite3 handle is not shared between threads. */
+	Browser_DB_Connection *connection = new(nothrow) Browser_DB_Connection(db_path);
+	if (!connection) {
+		BROWSER_LOGE("new Browser_DB_Connection failed");
+		return NULL;
+	}
+
+	if (!connection->_open_db()) {
+		BROWSER_LOGE("_open_db failed [%s]", db_path);
+		delete connection;
+		return NULL;
+	}
+
+	m_worker_connections[db_path] = connection;
+
+	return connection;
+}
+
+void Browser_DB_Executor::_close_worker_connections(void)
+{
+	std::map<std::string, Browser_DB_Connection *>::iterator iter;
+	for (iter = m_worker_connections.begin() ; iter != m_worker_connections.end() ; iter++)
+		delete iter->second;
+
+	m_worker_connections.clear();
+}
+
+void Browser_DB_Executor::__worker_thread_cb(void *data, Ecore_Thread *thread)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	Browser_DB_Executor *executor = (Browser_DB_Executor *)data;
+
+	eina_lock_take(&executor->m_lock);
+	while (1) {
+		while (executor->m_queue.empty() && !executor->m_is_quitting)
+			eina_condition_wait(&executor->m_condition);
+
+		/* The queue is run to the end at exit, so that no write is lost. */
+		if (executor->m_queue.empty())
+			break;
+
+		Browser_DB_Job *job = executor->m_queue.front();
+		executor->m_queue.pop_front();
+		executor->m_running_job_id = job->m_id;
+		eina_lock_release(&executor->m_lock);
+
+		job->run();
+
+		eina_lock_take(&executor->m_lock);
+		executor->m_running_job_id = 0;
+		if (job->m_is_cancelled || executor->m_is_quitting) {
+			executor->m_jobs.erase(job->m_id);
+			delete job;
+		} else
+			ecore_main_loop_thread_safe_call_async(__job_done_cb, job);
+		eina_condition_broadcast(&executor->m_condition);
+	}
+	eina_lock_release(&executor->m_lock);
+
+	executor->_close_worker_connections();
+
+	eina_lock_take(&executor->m_lock);
+	executor->m_is_thread_finished = EINA_TRUE;
+	eina_condition_broadcast(&executor->m_condition);
+	eina_lock_release(&executor->m_lock);
+}
+
+void Browser_DB_Executor::__worker_thread_end_cb(void *data, Ecore_Thread *thread)
+{
+	BROWSER_LOGD("[%s]", __func__);
+}
+
+void Browser_DB_Executor::__job_done_cb(void *data)
+{
+	Browser_DB_Job *job = (Browser_DB_Job *)data;
+	if (!m_instance) {
+		/* The executor is gone, the job was cancelled by _stop(). */
+		delete job;
+		return;
+	}
+
+	eina_lock_take(&m_instance->m_lock);
+	m_instance->m_jobs.erase(job->m_id);
+	eina_lock_release(&m_instance->m_lock);
+
+	if (!job->m_is_cancelled)
+		job->done();
+
+	delete job;
+}
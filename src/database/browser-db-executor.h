@@ -0,0 +1,105 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#ifndef BROWSER_DB_EXECUTOR_H
+#define BROWSER_DB_EXECUTOR_H
+
+#include "browser-config.h"
+#include "browser-db-connection.h"
+
+#include <list>
+#include <map>
+#include <string>
+
+typedef enum _browser_db_job_priority {
+	BROWSER_DB_JOB_PRIORITY_LOW	= 0,
+	BROWSER_DB_JOB_PRIORITY_NORMAL,
+	BROWSER_DB_JOB_PRIORITY_HIGH
+} browser_db_job_priority;
+
+class Browser_DB_Job {
+	friend class Browser_DB_Executor;
+public:
+	Browser_DB_Job(void);
+	virtual ~Browser_DB_Job(void);
+
+	/* Called on the worker thread. It must only use the connections of
+	  * Browser_DB_Executor::get_worker_connection(), never a *_DB object. */
+	virtual void run(void) = 0;
+	/* Called on the main loop after run(), unless the job was cancelled. */
+	virtual void done(void) = 0;
+
+	int get_id(void) { return m_id; }
+private:
+	int m_id;
+	int m_priority;
+	Eina_Bool m_is_cancelled;
+};
+
+/* Runs database jobs one by one on a dedicated Ecore_Thread, so that slow flash I/O
+  * does not block the main loop. Higher priority jobs run first, jobs of the same
+  * priority run in the order they were posted. */
+class Browser_DB_Executor {
+public:
+	static Browser_DB_Executor *get_instance(void);
+	/* Runs the jobs left in the queue, without their done(), and stops the thread. */
+	static void destroy_instance(void);
+	static Eina_Bool has_instance(void) { return m_instance != NULL; }
+
+	/* Takes the ownership of job and returns its id.
+	  * Returns 0 if the job could not be posted, the caller keeps it then. */
+	int post(Browser_DB_Job *job, int priority = BROWSER_DB_JOB_PRIORITY_NORMAL);
+	/* A cancelled job is not run if it is still queued, and its done() is never called. */
+	void cancel(int job_id);
+	/* Blocks until the job has run or was dropped. For callers which must read their own writes. */
+	void wait(int job_id);
+
+	Browser_DB_Connection *get_worker_connection(const char *db_path);
+private:
+	Browser_DB_Executor(void);
+	~Browser_DB_Executor(void);
+
+	Eina_Bool _start(void);
+	void _stop(void);
+	void _close_worker_connections(void);
+
+	static void __worker_thread_cb(void *data, Ecore_Thread *thread);
+	static void __worker_thread_end_cb(void *data, Ecore_Thread *thread);
+	static void __job_done_cb(void *data);
+
+	Ecore_Thread *m_thread;
+	Eina_Lock m_lock;
+	Eina_Condition m_condition;
+
+	/* All below are guarded by m_lock. */
+	std::list<Browser_DB_Job *> m_queue;
+	/* Jobs which are queued, running, or waiting for their done() on the main loop. */
+	std::map<int, Browser_DB_Job *> m_jobs;
+	int m_running_job_id;
+	int m_last_job_id;
+	Eina_Bool m_is_quitting;
+	Eina_Bool m_is_thread_finished;
+
+	/* Only touched by the worker thread. */
+	std::map<std::string, Browser_DB_Connection *> m_worker_connections;
+
+	static Browser_DB_Executor *m_instance;
+};
+
+#endif	/* BROWSER_DB_EXECUTOR_H */
@@ -0,0 +1,438 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-db-maintenance.h"
+#include "browser-db-executor.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <set>
+
+/* The progress handler is called every this many virtual machine instructions. */
+#define BROWSER_DB_MAINTENANCE_PROGRESS_STEPS	1000
+
+int Browser_DB_Maintenance::m_job_id = 0;
+volatile Eina_Bool Browser_DB_Maintenance::m_is_interrupted = EINA_FALSE;
+volatile Eina_Bool Browser_DB_Maintenance::m_has_written = EINA_FALSE;
+
+static const char *browser_db_maintenance_paths[] = {
+	BROWSER_HISTORY_DB_PATH,
+#if defined(FEATURE_MOST_VISITED_SITES)
+	BROWSER_MOST_VISITED_SITES_DB_PATH,
+#endif
+	BROWSER_GEOLOCATION_DB_PATH,
+};
+
+class Browser_DB_Maintenance::maintenance_job : public Browser_DB_Job {
+public:
+	maintenance_job(void) : m_deadline(0), m_stats_connection(NULL) {}
+	void run(void);
+	void done(void)
+	{
+		if (m_job_id == get_id())
+			m_job_id = 0;
+		/* The statistics and the vacuum are not changes by another application. */
+		if (m_has_written)
+			Browser_DB_Connection::mark_all_synced();
+	}
+private:
+	Eina_Bool _is_due(void);
+	Eina_Bool _is_over(void);
+	int _exec(Browser_DB_Connection *db_connection, const char *query);
+	std::string _get_value(Browser_DB_Connection *db_connection, const char *query);
+	void _record(const char *db_path, const char *step, const std::string &result, double start_time);
+
+	std::string _check_integrity(Browser_DB_Connection *db_connection);
+	std::string _analyze(Browser_DB_Connection *db_connection);
+	std::string _vacuum(Browser_DB_Connection *db_connection);
+	std::string _remove_orphan_screen_shots(Browser_DB_Connection *db_connection);
+	std::string _trim_history_archive(Browser_DB_Connection *db_connection);
+	Eina_Bool _get_most_visited_screen_shots(std::set<std::string> &names);
+
+	static int __progress_cb(void *data);
+
+	double m_deadline;
+	Browser_DB_Connection *m_stats_connection;
+};
+
+void Browser_DB_Maintenance::schedule(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (m_job_id)
+		return;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	if (!executor)
+		return;
+
+	maintenance_job *job = new(nothrow) maintenance_job;
+	if (!job) {
+		BROWSER_LOGE("new maintenance_job failed");
+		return;
+	}
+
+	m_is_interrupted = EINA_FALSE;
+	m_has_written = EINA_FALSE;
+	/* Behind any job of the browser. */
+	m_job_id = executor->post(job, BROWSER_DB_JOB_PRIORITY_LOW);
+	if (!m_job_id)
+		delete job;
+}
+
+void Browser_DB_Maintenance::cancel(void)
+{
+	if (!m_job_id)
+		return;
+
+	BROWSER_LOGD("[%s]", __func__);
+	m_is_interrupted = EINA_TRUE;
+	if (Browser_DB_Executor::has_instance()) {
+		Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+		executor->cancel(m_job_id);
+		/* The interrupted step ends at the next progress callback. The done() of a cancelled job
+		  * is never called, so its writes are taken as synced here, or the next
+		  * check_external_change() would take them for changes by another application. */
+		executor->wait(m_job_id);
+		if (m_has_written)
+			Browser_DB_Connection::mark_all_synced();
+	}
+	m_job_id = 0;
+}
+
+int Browser_DB_Maintenance::maintenance_job::__progress_cb(void *data)
+{
+	maintenance_job *job = (maintenance_job *)data;
+
+	/* Non zero interrupts the statement with SQLITE_INTERRUPT, a vacuum is rolled back. */
+	return job->_is_over() ? 1 : 0;
+}
+
+Eina_Bool Browser_DB_Maintenance::maintenance_job::_is_over(void)
+{
+	return (m_is_interrupted || ecore_time_get() > m_deadline);
+}
+
+int Browser_DB_Maintenance::maintenance_job::_exec(Browser_DB_Connection *db_connection, const char *query)
+{
+	sqlite3 *db_descriptor = db_connection->get_descriptor();
+	sqlite3_progress_handler(db_descriptor, BROWSER_DB_MAINTENANCE_PROGRESS_STEPS, __progress_cb, this);
+
+	char *error_message = NULL;
+	int error = sqlite3_exec(db_descriptor, query, NULL, NULL, &error_message);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGE("[%s] failed [%s]", query, error_message);
+		sqlite3_free(error_message);
+	}
+
+	sqlite3_progress_handler(db_descriptor, 0, NULL, NULL);
+
+	return error;
+}
+
+std::string Browser_DB_Maintenance::maintenance_job::_get_value(Browser_DB_Connection *db_connection, const char *query)
+{
+	std::string result;
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement(query, &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return result;
+	}
+
+	if (sqlite3_step(sqlite3_stmt) == SQLITE_ROW) {
+		const char *text = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
+		if (text)
+			result = text;
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return result;
+}
+
+Eina_Bool Browser_DB_Maintenance::maintenance_job::_is_due(void)
+{
+	std::string elapsed = _get_value(m_stats_connection,
+				"select julianday('now') - julianday(max(rundate)) from maintenance_stats");
+	if (elapsed.empty())
+		return EINA_TRUE;
+
+	return (atof(elapsed.c_str()) >= BROWSER_DB_MAINTENANCE_INTERVAL);
+}
+
+void Browser_DB_Maintenance::maintenance_job::_record(const char *db_path, const char *step,
+							const std::string &result, double start_time)
+{
+	BROWSER_LOGD("[%s] %s : %s", db_path, step, result.c_str());
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = m_stats_connection->prepare_statement("insert into maintenance_stats (rundate, db, step, result, duration)"
+							" values (DATETIME('now'), ?, ?, ?, ?)", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_stats_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, db_path, -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+	if (sqlite3_bind_text(sqlite3_stmt, 2, step, -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+	if (sqlite3_bind_text(sqlite3_stmt, 3, result.c_str(), -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+	/* msec */
+	if (sqlite3_bind_int(sqlite3_stmt, 4, (int)((ecore_time_get() - start_time) * 1000)) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	if (sqlite3_step(sqlite3_stmt) != SQLITE_DONE)
+		BROWSER_LOGE("sqlite3_step is failed.\n");
+
+	if (m_stats_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+}
+
+std::string Browser_DB_Maintenance::maintenance_job::_check_integrity(Browser_DB_Connection *db_connection)
+{
+	/* quick_check skips the index content verification of integrity_check, which is O(N log N). */
+	std::string result = _get_value(db_connection, "pragma quick_check");
+	if (result.empty())
+		return "failed";
+
+	return result;
+}
+
+std::string Browser_DB_Maintenance::maintenance_job::_analyze(Browser_DB_Connection *db_connection)
+{
+	int error = _exec(db_connection, "analyze");
+	if (error == SQLITE_INTERRUPT)
+		return "interrupted";
+
+	return (error == SQLITE_OK) ? "ok" : "failed";
+}
+
+std::string Browser_DB_Maintenance::maintenance_job::_vacuum(Browser_DB_Connection *db_connection)
+{
+	int page_count = atoi(_get_value(db_connection, "pragma page_count").c_str());
+	int free_count = atoi(_get_value(db_connection, "pragma freelist_count").c_str());
+	int auto_vacuum = atoi(_get_value(db_connection, "pragma auto_vacuum").c_str());
+
+	char buf[64] = {0, };
+	if (free_count == 0)
+		return "no free page";
+
+	int error = SQLITE_OK;
+	if (auto_vacuum == 2) {
+		/* incremental : give the free pages back to the file system. */
+		error = _exec(db_connection, "pragma incremental_vacuum");
+	} else if (free_count >= page_count * BROWSER_DB_MAINTENANCE_VACUUM_FREE_RATIO) {
+		/* The auto vacuum mode of an existing file only changes with a full vacuum. */
+		error = _exec(db_connection, "pragma auto_vacuum=incremental");
+		if (error == SQLITE_OK)
+			error = _exec(db_connection, "vacuum");
+	} else {
+		snprintf(buf, sizeof(buf) - 1, "%d of %d pages free", free_count, page_count);
+		return buf;
+	}
+
+	if (error == SQLITE_INTERRUPT)
+		return "interrupted";
+	if (error != SQLITE_OK)
+		return "failed";
+
+	int freed_count = free_count - atoi(_get_value(db_connection, "pragma freelist_count").c_str());
+	snprintf(buf, sizeof(buf) - 1, "%d of %d pages freed", freed_count, page_count);
+
+	return buf;
+}
+
+Eina_Bool Browser_DB_Maintenance::maintenance_job::_get_most_visited_screen_shots(std::set<std::string> &names)
+{
+#if defined(FEATURE_MOST_VISITED_SITES)
+	Browser_DB_Connection *most_visited_connection = Browser_DB_Executor::get_instance()->get_worker_connection(BROWSER_MOST_VISITED_SITES_DB_PATH);
+	if (!most_visited_connection)
+		return EINA_FALSE;
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = most_visited_connection->prepare_statement("select image from mostvisited", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (most_visited_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	while (sqlite3_step(sqlite3_stmt) == SQLITE_ROW) {
+		const char *image = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
+		if (image)
+			names.insert(image);
+	}
+
+	if (most_visited_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+#endif
+
+	return EINA_TRUE;
+}
+
+/* The retention policy of the history archive, see Browser_History_DB. */
+std::string Browser_DB_Maintenance::maintenance_job::_trim_history_archive(Browser_DB_Connection *db_connection)
+{
+	char query[256] = {0, };
+	snprintf(query, sizeof(query) - 1, "delete from history_archive where visitdate < DATETIME('now', '-%d days')",
+						BROWSER_HISTORY_ARCHIVE_MAX_AGE_DAYS);
+	int error = _exec(db_connection, query);
+
+	int excess_count = atoi(_get_value(db_connection, "select count(*) from history_archive").c_str())
+				- BROWSER_HISTORY_ARCHIVE_COUNT_LIMIT;
+	if (error == SQLITE_OK && excess_count > 0) {
+		/* The lowest frecency first. */
+		snprintf(query, sizeof(query) - 1, "delete from history_archive where id in"
+						" (select id from history_archive order by frecency limit %d)", excess_count);
+		error = _exec(db_connection, query);
+	}
+
+	if (error == SQLITE_OK)
+		error = _exec(db_connection, "delete from history_hosts where id not in (select host_id from history_archive)");
+
+	/* The visit log is kept as long as the archive, but for the last visit of each address
+	  * which lists it in the history pages. */
+	if (error == SQLITE_OK) {
+		snprintf(query, sizeof(query) - 1, "delete from history_visits where visittime < strftime('%%s', 'now', '-%d days')"
+						" and visittime < (select max(visittime) from history_visits v"
+							" where v.url_id = history_visits.url_id)",
+							BROWSER_HISTORY_ARCHIVE_MAX_AGE_DAYS);
+		error = _exec(db_connection, query);
+	}
+	if (error == SQLITE_OK)
+		error = _exec(db_connection, "delete from history_visits where url_id not in (select id from history)"
+							" and url_id not in (select id from history_archive)");
+
+	if (error == SQLITE_INTERRUPT)
+		return "interrupted";
+	if (error != SQLITE_OK)
+		return "failed";
+
+	return _get_value(db_connection, "select count(*) from history_archive") + " archived";
+}
+
+/* The screen shots of the most visited sites are named after the history id of the page.
+  * They are left behind when the history item is evicted or deleted. */
+std::string Browser_DB_Maintenance::maintenance_job::_remove_orphan_screen_shots(Browser_DB_Connection *db_connection)
+{
+	std::set<std::string> used_names;
+	if (!_get_most_visited_screen_shots(used_names))
+		return "failed";
+
+	DIR *dir = opendir(BROWSER_SCREEN_SHOT_DIR);
+	if (!dir)
+		return "no screen shot";
+
+	/* An archived item keeps its id and is moved back to history on its next visit, with its screen shot. */
+	sqlite3_stmt *history_stmt = NULL;
+	if (db_connection->prepare_statement("select 1 from history where id=?1"
+						" union all select 1 from history_archive where id=?1", &history_stmt) != SQLITE_OK) {
+		if (db_connection->release_statement(history_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		closedir(dir);
+		return "failed";
+	}
+
+	int removed_count = 0;
+	struct dirent *entry = NULL;
+	while (!_is_over() && (entry = readdir(dir)) != NULL) {
+		/* Only the history id names, not the default icons or the other captures. */
+		const char *name = entry->d_name;
+		int i = 0;
+		while (name[i] && isdigit(name[i]))
+			i++;
+		if (i == 0 || name[i] || used_names.find(name) != used_names.end())
+			continue;
+
+		sqlite3_reset(history_stmt);
+		if (sqlite3_bind_int(history_stmt, 1, atoi(name)) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+		if (sqlite3_step(history_stmt) != SQLITE_DONE)
+			continue;
+
+		std::string path = std::string(BROWSER_SCREEN_SHOT_DIR) + name;
+		if (!unlink(path.c_str()))
+			removed_count++;
+	}
+
+	if (db_connection->release_statement(history_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	closedir(dir);
+
+	char buf[32] = {0, };
+	snprintf(buf, sizeof(buf) - 1, "%d removed", removed_count);
+
+	return buf;
+}
+
+void Browser_DB_Maintenance::maintenance_job::run(void)
+{
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	m_stats_connection = executor->get_worker_connection(BROWSER_HISTORY_DB_PATH);
+	if (!m_stats_connection || !_is_due())
+		return;
+
+	m_deadline = ecore_time_get() + BROWSER_DB_MAINTENANCE_TIME_BUDGET;
+	m_has_written = EINA_TRUE;
+
+	/* Before the vacuum, which then frees the pages of the removed rows. */
+	double start_time = ecore_time_get();
+	_record(BROWSER_HISTORY_DB_PATH, "history_retention", _trim_history_archive(m_stats_connection), start_time);
+
+	unsigned int count = sizeof(browser_db_maintenance_paths) / sizeof(browser_db_maintenance_paths[0]);
+	for (unsigned int i = 0 ; i < count && !_is_over() ; i++) {
+		const char *db_path = browser_db_maintenance_paths[i];
+		Browser_DB_Connection *db_connection = executor->get_worker_connection(db_path);
+		if (!db_connection)
+			continue;
+
+		start_time = ecore_time_get();
+		_record(db_path, "quick_check", _check_integrity(db_connection), start_time);
+
+		if (!_is_over()) {
+			start_time = ecore_time_get();
+			_record(db_path, "analyze", _analyze(db_connection), start_time);
+		}
+
+		if (!_is_over()) {
+			start_time = ecore_time_get();
+			_record(db_path, "vacuum", _vacuum(db_connection), start_time);
+		}
+	}
+
+	if (!_is_over()) {
+		start_time = ecore_time_get();
+		_record(BROWSER_SCREEN_SHOT_DIR, "orphan_screen_shots", _remove_orphan_screen_shots(m_stats_connection), start_time);
+	}
+
+	char query[128] = {0, };
+	snprintf(query, sizeof(query) - 1, "delete from maintenance_stats where id <= (select max(id) from maintenance_stats) - %d",
+						BROWSER_DB_MAINTENANCE_STATS_MAX);
+	if (_exec(m_stats_connection, query) != SQLITE_OK)
+		BROWSER_LOGE("failed to trim maintenance_stats");
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_DB_MAINTENANCE_H
+#define BROWSER_DB_MAINTENANCE_H
+
+#include "browser-config.h"
+
+#define BROWSER_DB_MAINTENANCE_INTERVAL	1.0 // day
+#define BROWSER_DB_MAINTENANCE_TIME_BUDGET	2.0 // sec
+/* A file is vacuumed in full once, to switch it to incremental auto vacuum,
+  * when at least this part of its pages is free. */
+#define BROWSER_DB_MAINTENANCE_VACUUM_FREE_RATIO	0.25
+#define BROWSER_DB_MAINTENANCE_STATS_MAX	200
+
+/* Retention of the history archive, integrity check, ANALYZE and vacuum of the browser databases,
+  * and removal of the screen shots of evicted history items. It runs on the DB executor thread
+  * while the browser is in background, and each step and its result is recorded
+  * in the maintenance_stats table of the history database. */
+class Browser_DB_Maintenance {
+public:
+	/* Called when the browser is paused. Does nothing if the last run is more recent
+	  * than BROWSER_DB_MAINTENANCE_INTERVAL. */
+	static void schedule(void);
+	/* Called when the browser is resumed or closed. A running step is interrupted and waited for,
+	  * the next run starts over. */
+	static void cancel(void);
+private:
+	class maintenance_job;
+
+	static int m_job_id;
+	/* Set by the main loop, read by the progress handler on the worker thread. */
+	static volatile Eina_Bool m_is_interrupted;
+	/* Set by the worker thread once the run is due, when the files start to change. */
+	static volatile Eina_Bool m_has_written;
+};
+
+#endif	/* BROWSER_DB_MAINTENANCE_H */
+
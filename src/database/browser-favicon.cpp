@@ -0,0 +1,229 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-favicon.h"
+
+#include <string.h>
+
+Browser_Favicon::Browser_Favicon(void)
+:
+	m_width(0)
+	,m_height(0)
+{
+}
+
+Browser_Favicon::~Browser_Favicon(void)
+{
+}
+
+Eina_Bool Browser_Favicon::set_pixels(const unsigned int *pixels, int width, int height, int stride)
+{
+	clear();
+	if (!pixels || width <= 0 || height <= 0 || stride < width * (int)sizeof(unsigned int))
+		return EINA_FALSE;
+
+	int longer_side = width > height ? width : height;
+	if (longer_side > BROWSER_FAVICON_SIZE) {
+		m_width = width * BROWSER_FAVICON_SIZE / longer_side;
+		m_height = height * BROWSER_FAVICON_SIZE / longer_side;
+		if (m_width < 1)
+			m_width = 1;
+		if (m_height < 1)
+			m_height = 1;
+	} else {
+		m_width = width;
+		m_height = height;
+	}
+	m_pixels.resize(m_width * m_height);
+
+	/* Each target pixel is the average of the source pixels it covers, channel by channel. */
+	const unsigned char *rows = reinterpret_cast<const unsigned char *>(pixels);
+	for (int y = 0 ; y < m_height ; y++) {
+		int src_y_begin = y * height / m_height;
+		int src_y_end = (y + 1) * height / m_height;
+		for (int x = 0 ; x < m_width ; x++) {
+			int src_x_begin = x * width / m_width;
+			int src_x_end = (x + 1) * width / m_width;
+
+			unsigned int sum[4] = {0, };
+			for (int src_y = src_y_begin ; src_y < src_y_end ; src_y++) {
+				const unsigned int *row = reinterpret_cast<const unsigned int *>(rows + src_y * stride);
+				for (int src_x = src_x_begin ; src_x < src_x_end ; src_x++) {
+					unsigned int pixel = row[src_x];
+					sum[0] += pixel >> 24;
+					sum[1] += (pixel >> 16) & 0xff;
+					sum[2] += (pixel >> 8) & 0xff;
+					sum[3] += pixel & 0xff;
+				}
+			}
+
+			unsigned int count = (src_y_end - src_y_begin) * (src_x_end - src_x_begin);
+			m_pixels[y * m_width + x] = ((sum[0] / count) << 24) | ((sum[1] / count) << 16)
+							| ((sum[2] / count) << 8) | (sum[3] / count);
+		}
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_Favicon::set_data(const void *data, int length, int width, int height)
+{
+	clear();
+	if (!data || width <= 0 || height <= 0 || width > BROWSER_FAVICON_SIZE || height > BROWSER_FAVICON_SIZE
+	    || length != width * height * (int)sizeof(unsigned int))
+		return EINA_FALSE;
+
+	m_width = width;
+	m_height = height;
+	m_pixels.resize(width * height);
+	memcpy(&m_pixels[0], data, length);
+
+	return EINA_TRUE;
+}
+
+void Browser_Favicon::clear(void)
+{
+	m_pixels.clear();
+	m_width = 0;
+	m_height = 0;
+}
+
+std::string Browser_Favicon::get_host(const char *url)
+{
+	if (!url)
+		return std::string();
+
+	const char *authority = strstr(url, "://");
+	authority = authority ? authority + strlen("://") : url;
+
+	const char *end = authority + strcspn(authority, "/?#");
+	return std::string(url, end - url);
+}
+
+Eina_Bool Browser_Favicon::read_favicons(Browser_DB_Connection *db_connection, const char *table,
+					const std::vector<int> &ids, std::map<int, Browser_Favicon> &favicons)
+{
+	if (ids.empty())
+		return EINA_TRUE;
+
+	/* The same statement serves every batch of ids, the unused places of the last one stay null.
+	  * Each row finds the icon of its host by the primary key of favicons. */
+	std::string query = std::string("select t.id, f.favicon, f.favicon_w, f.favicon_h from ") + table + " t"
+				" join favicons f on f.host=br_favicon_host(t.address) where t.id in (?";
+	for (int i = 1 ; i < BROWSER_FAVICON_BATCH_SIZE ; i++)
+		query += ",?";
+	query += ")";
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement(query.c_str(), &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	for (int first = 0 ; first < ids.size() ; first += BROWSER_FAVICON_BATCH_SIZE) {
+		for (int i = 0 ; i < BROWSER_FAVICON_BATCH_SIZE && first + i < ids.size() ; i++) {
+			if (sqlite3_bind_int(sqlite3_stmt, i + 1, ids[first + i]) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+		}
+
+		while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+			int id = sqlite3_column_int(sqlite3_stmt, 0);
+			Browser_Favicon &favicon = favicons[id];
+			/* The file is shared, another application may have stored something else. */
+			if (!favicon.set_data(sqlite3_column_blob(sqlite3_stmt, 1), sqlite3_column_bytes(sqlite3_stmt, 1),
+						sqlite3_column_int(sqlite3_stmt, 2), sqlite3_column_int(sqlite3_stmt, 3)))
+				favicons.erase(id);
+		}
+
+		if (error != SQLITE_DONE) {
+			BROWSER_LOGD("SQL error=%d", error);
+			break;
+		}
+
+		sqlite3_reset(sqlite3_stmt);
+		sqlite3_clear_bindings(sqlite3_stmt);
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return (error == SQLITE_DONE);
+}
+
+Eina_Bool Browser_Favicon::write_favicon(Browser_DB_Connection *db_connection,
+					const std::string &host, const Browser_Favicon &favicon)
+{
+	if (host.empty() || favicon.is_empty())
+		return EINA_FALSE;
+
+	/* Most visits of a host bring the icon it has already, they leave the file as it is. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("insert or replace into favicons (host, favicon, favicon_w, favicon_h)"
+							" select ?1, ?2, ?3, ?4"
+							" where not exists (select 1 from favicons where host=?1 and favicon=?2)",
+						&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, host.c_str(), -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+	if (sqlite3_bind_blob(sqlite3_stmt, 2, favicon.get_pixels(), favicon.get_length(), NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_blob is failed.\n");
+	if (sqlite3_bind_int(sqlite3_stmt, 3, favicon.get_width()) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+	if (sqlite3_bind_int(sqlite3_stmt, 4, favicon.get_height()) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+static void __favicon_host_func(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL) {
+		sqlite3_result_null(context);
+		return;
+	}
+
+	std::string host = Browser_Favicon::get_host(reinterpret_cast<const char *>(sqlite3_value_text(argv[0])));
+	sqlite3_result_text(context, host.c_str(), host.length(), SQLITE_TRANSIENT);
+}
+
+int br_favicon_register_functions(sqlite3 *db_descriptor)
+{
+	return sqlite3_create_function(db_descriptor, "br_favicon_host", 1, SQLITE_UTF8, NULL,
+					__favicon_host_func, NULL, NULL);
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_FAVICON_H
+#define BROWSER_FAVICON_H
+
+#include "browser-config.h"
+#include "browser-db-connection.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/* A favicon as it is kept in the favicons table of the history and bookmark files :
+  * premultiplied ARGB pixels, row by row without padding, which is the layout of an evas image,
+  * scaled down to fit in BROWSER_FAVICON_SIZE.
+  * There is one icon per host, shared by all the items of the host. */
+class Browser_Favicon {
+public:
+	Browser_Favicon(void);
+	~Browser_Favicon(void);
+
+	/* Averages pixels down to BROWSER_FAVICON_SIZE keeping the aspect ratio, a smaller icon is copied as it is.
+	  * stride is the length of a source row in bytes. */
+	Eina_Bool set_pixels(const unsigned int *pixels, int width, int height, int stride);
+	/* Takes the content of the columns, length is in bytes. */
+	Eina_Bool set_data(const void *data, int length, int width, int height);
+	void clear(void);
+
+	Eina_Bool is_empty(void) const { return m_pixels.empty(); }
+	const unsigned int *get_pixels(void) const { return m_pixels.empty() ? NULL : &m_pixels[0]; }
+	int get_length(void) const { return m_pixels.size() * sizeof(unsigned int); }
+	int get_width(void) const { return m_width; }
+	int get_height(void) const { return m_height; }
+
+	/* The scheme and authority of url, e.g. "http://www.tizen.org" */
+	static std::string get_host(const char *url);
+
+	/* The icons of the hosts of the rows of table with the given ids, the rows without a valid icon are left out. */
+	static Eina_Bool read_favicons(Browser_DB_Connection *db_connection, const char *table,
+					const std::vector<int> &ids, std::map<int, Browser_Favicon> &favicons);
+	/* Stores favicon as the icon of host, nothing is written if it has it already. */
+	static Eina_Bool write_favicon(Browser_DB_Connection *db_connection,
+					const std::string &host, const Browser_Favicon &favicon);
+private:
+	std::vector<unsigned int> m_pixels;
+	int m_width;
+	int m_height;
+};
+
+/* Registers br_favicon_host(address), the get_host() of address, for the queries and the migrations. */
+int br_favicon_register_functions(sqlite3 *db_descriptor);
+
+#endif	/* BROWSER_FAVICON_H */
+
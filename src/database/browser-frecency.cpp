@@ -0,0 +1,83 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-frecency.h"
+
+#include <time.h>
+
+/* julianday() of 1970-01-01 00:00:00 UTC */
+#define BROWSER_FRECENCY_UNIX_EPOCH_JULIAN_DAY	2440587.5
+
+static double _get_decay_rate(void)
+{
+	return log(2.0) / BROWSER_FRECENCY_HALF_LIFE_DAYS;
+}
+
+double br_frecency_now(void)
+{
+	return time(NULL) / (24.0 * 60 * 60);
+}
+
+double br_frecency_add(double frecency, double weight, double now)
+{
+	/* Decay the old score to now, add the visit, and store it back relative to the epoch. */
+	double score = weight;
+	if (frecency != BROWSER_FRECENCY_NONE)
+		score += exp(frecency - _get_decay_rate() * now);
+
+	if (score <= 0)
+		return BROWSER_FRECENCY_NONE;
+
+	return log(score) + _get_decay_rate() * now;
+}
+
+double br_frecency_visit_weight(Eina_Bool is_typed, Eina_Bool is_bookmarked)
+{
+	double weight = 1.0;
+	if (is_typed)
+		weight += BROWSER_FRECENCY_TYPED_BONUS;
+	if (is_bookmarked)
+		weight += BROWSER_FRECENCY_BOOKMARKED_BONUS;
+
+	return weight;
+}
+
+static void __frecency_func(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+	double frecency = BROWSER_FRECENCY_NONE;
+	if (sqlite3_value_type(argv[0]) != SQLITE_NULL)
+		frecency = sqlite3_value_double(argv[0]);
+
+	double weight = sqlite3_value_double(argv[1]);
+	double now = sqlite3_value_double(argv[2]) - BROWSER_FRECENCY_UNIX_EPOCH_JULIAN_DAY;
+
+	double result = br_frecency_add(frecency, weight, now);
+	if (result == BROWSER_FRECENCY_NONE)
+		sqlite3_result_null(context);
+	else
+		sqlite3_result_double(context, result);
+}
+
+int br_frecency_register_functions(sqlite3 *db_descriptor)
+{
+	return sqlite3_create_function(db_descriptor, "br_frecency", 3, SQLITE_UTF8, NULL,
+					__frecency_func, NULL, NULL);
+}
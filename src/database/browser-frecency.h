@@ -0,0 +1,48 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#ifndef BROWSER_FRECENCY_H
+#define BROWSER_FRECENCY_H
+
+#include "browser-config.h"
+
+#include <math.h>
+
+extern "C" {
+#include "db-util.h"
+}
+
+/* Frecency is the visit count decayed by BROWSER_FRECENCY_HALF_LIFE_DAYS.
+  * It is stored as ln(score) + decay_rate * days, with days counted from the unix epoch.
+  * All the scores decay at the same rate, so the stored values sort the same way as
+  * the current scores, and a visit only updates its own row. */
+#define BROWSER_FRECENCY_NONE	(-HUGE_VAL)
+
+/* Days since the unix epoch. */
+double br_frecency_now(void);
+/* Adds a visit of the given weight at the time now (in days) to the stored value. */
+double br_frecency_add(double frecency, double weight, double now);
+/* Weight of one visit, including the bonuses for typed and bookmarked addresses. */
+double br_frecency_visit_weight(Eina_Bool is_typed, Eina_Bool is_bookmarked);
+
+/* Registers br_frecency(frecency, weight, julian_day) for the queries.
+  * A NULL frecency means the row has no visit yet. */
+int br_frecency_register_functions(sqlite3 *db_descriptor);
+
+#endif	/* BROWSER_FRECENCY_H */
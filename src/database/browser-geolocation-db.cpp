@@ -20,9 +20,9 @@ using namespace std;
 
 #include "browser-geolocation-db.h"
 
-sqlite3* Browser_Geolocation_DB::m_db_descriptor = NULL;
-
 Browser_Geolocation_DB::Browser_Geolocation_DB(void)
+:
+	m_db_connection(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -34,34 +34,15 @@ Browser_Geolocation_DB::~Browser_Geolocation_DB(void)
 
 Eina_Bool Browser_Geolocation_DB::_open_db(void)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	int error = db_util_open(BROWSER_GEOLOCATION_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	m_db_connection = Browser_DB_Connection::get_connection(BROWSER_GEOLOCATION_DB_PATH);
+	if (!m_db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
 	}
 
 	return EINA_TRUE;
 }
 
-Eina_Bool Browser_Geolocation_DB::_close_db(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_db_descriptor)
-	{
-		int error = db_util_close(m_db_descriptor);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGE("db_util_close error");
-			m_db_descriptor = NULL;
-			return EINA_FALSE;
-		}
-		m_db_descriptor = NULL;
-	}
-
-	return EINA_TRUE;
-}
-
 Eina_Bool Browser_Geolocation_DB::save_geolocation_host(const char *address, bool accept)
 {
 	BROWSER_LOGD("[%s]", address);
@@ -80,13 +61,12 @@ Eina_Bool Browser_Geolocation_DB::save_geolocation_host(const char *address, boo
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "INSERT INTO geolocation (address, accept) values (?, ?)",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("INSERT INTO geolocation (address, accept) values (?, ?)",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -99,16 +79,14 @@ Eina_Bool Browser_Geolocation_DB::save_geolocation_host(const char *address, boo
 	error = sqlite3_step(sqlite3_stmt);
 	if (error != SQLITE_OK && error != SQLITE_DONE) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
 
 	return (error == SQLITE_DONE || error == SQLITE_ROW);
 }
@@ -129,14 +107,18 @@ Eina_Bool Browser_Geolocation_DB::get_geolocation_host(const char *address, bool
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	std::string query = "select accept from geolocation where address like '%" + std::string(address) + "%'";
-
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select accept from geolocation where address like '%' || ? || '%'", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, address, -1, NULL) != SQLITE_OK) {
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -147,9 +129,8 @@ Eina_Bool Browser_Geolocation_DB::get_geolocation_host(const char *address, bool
 		BROWSER_LOGD("address: %s accept %d", address, accept);
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-	_close_db();
 	if (error == SQLITE_DONE || error == SQLITE_ROW)
 		return EINA_TRUE;
 	else
@@ -173,30 +154,32 @@ Eina_Bool Browser_Geolocation_DB::remove_geolocation_data(const char *address)
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	std::string query = "DELETE FROM geolocation WHERE address LIKE '%" + std::string(address) + "%'";
-
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("DELETE FROM geolocation WHERE address LIKE '%' || ? || '%'", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, address, -1, NULL) != SQLITE_OK) {
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
 	error = sqlite3_step(sqlite3_stmt);
 	if (error != SQLITE_OK && error != SQLITE_DONE) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
 
 	return (error == SQLITE_DONE || error == SQLITE_ROW);
 }
@@ -210,28 +193,25 @@ Eina_Bool Browser_Geolocation_DB::remove_all_geolocation_data(void)
 	sqlite3_stmt *sqlite3_stmt = NULL;
 	std::string query = "DELETE FROM geolocation";
 
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement(query.c_str(), &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
 	error = sqlite3_step(sqlite3_stmt);
 	if (error != SQLITE_OK && error != SQLITE_DONE) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
 
 	return (error == SQLITE_DONE || error == SQLITE_ROW);
 }
@@ -249,34 +229,35 @@ int Browser_Geolocation_DB::get_geolocation_host_count(const char *address)
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	std::string query = "select count(*) from geolocation where address like '%" + std::string(address) + "%'";
-
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select count(*) from geolocation where address like '%' || ? || '%'", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return -1;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, address, -1, NULL) != SQLITE_OK) {
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
 	error = sqlite3_step(sqlite3_stmt);
 	if (error != SQLITE_ROW) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
 	count = sqlite3_column_int(sqlite3_stmt, 0);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK) {
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
-	_close_db();
 	BROWSER_LOGD("count: %d\n", count);
 	return count;
 
@@ -291,13 +272,12 @@ Eina_Bool Browser_Geolocation_DB::get_geolocation_info_list(std::vector<geolocat
 	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select address,accept from geolocation",
-					-1,&sqlite3_stmt,NULL);
+	int error = m_db_connection->prepare_statement("select address,accept from geolocation",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -306,6 +286,7 @@ Eina_Bool Browser_Geolocation_DB::get_geolocation_info_list(std::vector<geolocat
 		item = new(nothrow) geolocation_info;
 		if (!item) {
 			BROWSER_LOGE("bookmark_item new is failed.\n");
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
 
@@ -322,16 +303,12 @@ Eina_Bool Browser_Geolocation_DB::get_geolocation_info_list(std::vector<geolocat
 		list.push_back(item);
 	}
 
-	error = sqlite3_finalize(sqlite3_stmt);
+	error = m_db_connection->release_statement(sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGE("sqlite3_finalize is failed. (%d)", error);
 		return EINA_FALSE;
 	}
 
-	if (_close_db() == EINA_FALSE) {
-		BROWSER_LOGE("_close_db is failed.");
-		return EINA_FALSE;
-	}
 
 	return EINA_TRUE;
 }
@@ -347,32 +324,28 @@ int Browser_Geolocation_DB::get_geolocation_info_count(void)
 	sqlite3_stmt *sqlite3_stmt = NULL;
 	std::string query = "select count(*) from geolocation";
 
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement(query.c_str(), &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
 	error = sqlite3_step(sqlite3_stmt);
 	if (error != SQLITE_ROW) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
 	count = sqlite3_column_int(sqlite3_stmt, 0);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK) {
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return -1;
 	}
 
-	_close_db();
 	BROWSER_LOGD("count: %d\n", count);
 	return count;
-}
+}
@@ -20,6 +20,7 @@
 #define BROWSER_GEOLOCATION_DB_H
 
 #include "browser-config.h"
+#include "browser-db-connection.h"
 
 extern "C" {
 #include "db-util.h"
@@ -53,9 +54,8 @@ public:
 	int get_geolocation_info_count(void);
 private:
 	Eina_Bool _open_db(void);
-	Eina_Bool _close_db(void);
-
-	static sqlite3* m_db_descriptor;
+
+	Browser_DB_Connection *m_db_connection;
 };
 
 #endif	/* BROWSER_GEOLOCATION_DB_H */
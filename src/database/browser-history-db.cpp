@@ -15,504 +15,1855 @@
  *
  */
 
-
 using namespace std;
 
 #include "browser-history-db.h"
+#include "browser-bookmark-db.h"
+#include "browser-frecency.h"
+#include "browser-search-text.h"
+#include "browser-url-key.h"
+
+#include <algorithm>
+
+std::vector<Browser_History_DB::pending_visit> Browser_History_DB::m_pending_visits;
+std::vector<Browser_History_DB::pending_favicon> Browser_History_DB::m_pending_favicons;
+Ecore_Timer *Browser_History_DB::m_flush_visits_timer = NULL;
+int Browser_History_DB::m_flush_job_id = 0;
+int Browser_History_DB::m_history_generation = 0;
+Browser_Url_Prefix_Index Browser_History_DB::m_url_prefix_index;
+Eina_Bool Browser_History_DB::m_is_private = EINA_FALSE;
+Browser_Private_History Browser_History_DB::m_private_history;
+
+Browser_History_DB::Browser_History_DB(void)
+:
+	m_db_connection(NULL)
+	,m_search_entries_descriptor(NULL)
+	,m_search_entries_changes(0)
+	,m_search_entries_generation(0)
+{
+	BROWSER_LOGD("[%s]", __func__);
+}
+
+Browser_History_DB::~Browser_History_DB(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+}
+
+Eina_Bool Browser_History_DB::_open_db(const char *db_path)
+{
+	m_db_connection = Browser_DB_Connection::get_connection(db_path);
+	if (!m_db_connection) {
+		BROWSER_LOGE("get_connection failed");
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::save_history(const char *url, const char *title, Eina_Bool *is_full,
+					Eina_Bool is_typed, Eina_Bool is_bookmarked)
+{
+	if (url == NULL || title == NULL || strlen(url) == 0 || strlen(title) == 0)
+		return EINA_FALSE;
+
+	/* The visit is written later by flush_visits(), a disk full error can not be reported here. */
+	if (is_full)
+		*is_full = EINA_FALSE;
+
+	double frecency_weight = br_frecency_visit_weight(is_typed, is_bookmarked);
+	if (m_is_private) {
+		m_private_history.add_visit(url, title, frecency_weight);
+		return EINA_TRUE;
+	}
+
+	m_url_prefix_index.add_visit(url, frecency_weight);
+
+	visit_event event;
+	event.time = time(NULL);
+	event.transition = is_typed ? BROWSER_HISTORY_TRANSITION_TYPED : BROWSER_HISTORY_TRANSITION_LINK;
+	event.frecency_weight = frecency_weight;
+
+	/* Redirect chains and frames report the same page several times in a row,
+	  * merge them into one pending visit. */
+	sqlite3_int64 url_key = br_url_key(url);
+	for (int i = 0 ; i < m_pending_visits.size() ; i++) {
+		if (m_pending_visits[i].url_key == url_key) {
+			m_pending_visits[i].title = std::string(title);
+			m_pending_visits[i].visit_count++;
+			m_pending_visits[i].frecency_weight += frecency_weight;
+			m_pending_visits[i].events.push_back(event);
+			return EINA_TRUE;
+		}
+	}
+
+	pending_visit visit;
+	visit.url = std::string(url);
+	visit.url_key = url_key;
+	visit.title = std::string(title);
+	visit.visit_count = 1;
+	visit.frecency_weight = frecency_weight;
+	visit.events.push_back(event);
+	m_pending_visits.push_back(visit);
+
+	if (!m_flush_visits_timer)
+		m_flush_visits_timer = ecore_timer_add(BROWSER_HISTORY_FLUSH_TIMEOUT, __flush_visits_timer_cb, NULL);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::save_favicon(const char *url, const Browser_Favicon &favicon)
+{
+	if (!url || !strlen(url) || favicon.is_empty())
+		return EINA_FALSE;
+
+	/* Nothing of a private page is written. */
+	if (m_is_private)
+		return EINA_TRUE;
+
+	std::string host = Browser_Favicon::get_host(url);
+	for (int i = 0 ; i < m_pending_favicons.size() ; i++) {
+		if (m_pending_favicons[i].host == host) {
+			m_pending_favicons[i].favicon = favicon;
+			return EINA_TRUE;
+		}
+	}
+
+	pending_favicon pending;
+	pending.host = host;
+	pending.favicon = favicon;
+	m_pending_favicons.push_back(pending);
+
+	if (!m_flush_visits_timer)
+		m_flush_visits_timer = ecore_timer_add(BROWSER_HISTORY_FLUSH_TIMEOUT, __flush_visits_timer_cb, NULL);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::get_favicons(const std::vector<int> &history_ids, std::map<int, Browser_Favicon> &favicons)
+{
+	BROWSER_LOGD("[%s] %d items", __func__, (int)history_ids.size());
+	/* The private items have no icon, the stored ones listed with them in private mode have. */
+	std::vector<int> stored_ids;
+	for (int i = 0 ; i < history_ids.size() ; i++) {
+		if (history_ids[i] > 0)
+			stored_ids.push_back(history_ids[i]);
+	}
+	if (stored_ids.empty())
+		return EINA_TRUE;
+
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	return Browser_Favicon::read_favicons(m_db_connection, "history", stored_ids, favicons);
+}
+
+Eina_Bool Browser_History_DB::__flush_visits_timer_cb(void *data)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	m_flush_visits_timer = NULL;
+
+	if (!_flush_visits_async())
+		BROWSER_LOGE("_flush_visits_async failed");
+
+	return ECORE_CALLBACK_CANCEL;
+}
+
+class Browser_History_DB::flush_visits_job : public Browser_DB_Job {
+public:
+	flush_visits_job(void) : m_is_evicted(EINA_FALSE) {}
+	void run(void)
+	{
+		Browser_DB_Connection *db_connection = Browser_DB_Executor::get_instance()->get_worker_connection(BROWSER_HISTORY_DB_PATH);
+		if (!db_connection || !_write_visits(db_connection, m_visits, m_favicons, &m_is_evicted))
+			BROWSER_LOGE("_write_visits failed");
+	}
+	void done(void)
+	{
+		if (m_is_evicted)
+			m_url_prefix_index.unload();
+		m_history_generation++;
+		if (m_flush_job_id == get_id())
+			m_flush_job_id = 0;
+	}
+
+	std::vector<pending_visit> m_visits;
+	std::vector<pending_favicon> m_favicons;
+	Eina_Bool m_is_evicted;
+};
+
+Eina_Bool Browser_History_DB::_flush_visits_async(void)
+{
+	if (m_flush_visits_timer) {
+		ecore_timer_del(m_flush_visits_timer);
+		m_flush_visits_timer = NULL;
+	}
+
+	if (m_pending_visits.empty() && m_pending_favicons.empty())
+		return EINA_TRUE;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	flush_visits_job *job = new(nothrow) flush_visits_job;
+	if (!executor || !job) {
+		BROWSER_LOGE("no executor, flush on the main loop");
+		if (job)
+			delete job;
+		return flush_visits();
+	}
+
+	job->m_visits.swap(m_pending_visits);
+	job->m_favicons.swap(m_pending_favicons);
+	/* Ahead of the reads, which expect to see these visits. */
+	int job_id = executor->post(job, BROWSER_DB_JOB_PRIORITY_HIGH);
+	if (!job_id) {
+		m_pending_visits.swap(job->m_visits);
+		m_pending_favicons.swap(job->m_favicons);
+		delete job;
+		return flush_visits();
+	}
+	m_flush_job_id = job_id;
+
+	return EINA_TRUE;
+}
+
+class Browser_History_DB::visits_flushed_job : public Browser_DB_Job {
+public:
+	visits_flushed_job(visits_flushed_cb callback, void *user_data)
+		: m_callback(callback), m_user_data(user_data) {}
+	void run(void) {}
+	void done(void)
+	{
+		m_callback(m_user_data);
+	}
+
+	visits_flushed_cb m_callback;
+	void *m_user_data;
+};
+
+int Browser_History_DB::flush_visits_async(visits_flushed_cb callback, void *user_data)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!_flush_visits_async()) {
+		BROWSER_LOGE("_flush_visits_async failed");
+		return 0;
+	}
+
+	if (!callback)
+		return m_flush_job_id;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	if (!executor)
+		return 0;
+
+	/* Behind the flush, which is posted with a higher priority. */
+	visits_flushed_job *job = new(nothrow) visits_flushed_job(callback, user_data);
+	if (!job) {
+		BROWSER_LOGE("new visits_flushed_job failed");
+		return 0;
+	}
+
+	int job_id = executor->post(job, BROWSER_DB_JOB_PRIORITY_NORMAL);
+	if (!job_id)
+		delete job;
+
+	return job_id;
+}
+
+/* The posted flush job must be over before the tables change under it.
+  * A discarded one is dropped if it is still queued, it can only be waited for once it runs. */
+void Browser_History_DB::_finish_flush_job(Eina_Bool is_discarded)
+{
+	if (!m_flush_job_id)
+		return;
+
+	if (Browser_DB_Executor::has_instance()) {
+		Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+		if (is_discarded)
+			executor->cancel(m_flush_job_id);
+		executor->wait(m_flush_job_id);
+	}
+
+	m_flush_job_id = 0;
+	m_history_generation++;
+}
+
+Eina_Bool Browser_History_DB::flush_visits(void)
+{
+	if (m_flush_visits_timer) {
+		ecore_timer_del(m_flush_visits_timer);
+		m_flush_visits_timer = NULL;
+	}
+
+	/* A flush still running on the executor must be committed before the caller reads or deletes. */
+	_finish_flush_job(EINA_FALSE);
+
+	if (m_pending_visits.empty() && m_pending_favicons.empty())
+		return EINA_TRUE;
+
+	BROWSER_LOGD("[%s] %d visits %d favicons", __func__, (int)m_pending_visits.size(), (int)m_pending_favicons.size());
+
+	std::vector<pending_visit> visits;
+	visits.swap(m_pending_visits);
+	std::vector<pending_favicon> favicons;
+	favicons.swap(m_pending_favicons);
+
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_HISTORY_DB_PATH);
+	if (!db_connection) {
+		BROWSER_LOGE("get_connection failed");
+		return EINA_FALSE;
+	}
+
+	Eina_Bool is_evicted = EINA_FALSE;
+	Eina_Bool ret = _write_visits(db_connection, visits, favicons, &is_evicted);
+	if (is_evicted)
+		m_url_prefix_index.unload();
+
+	return ret;
+}
+
+void Browser_History_DB::check_external_change(void)
+{
+	Browser_DB_Connection *db_connection = Browser_DB_Connection::get_connection(BROWSER_HISTORY_DB_PATH);
+	if (!db_connection || !db_connection->has_external_change())
+		return;
+
+	BROWSER_LOGD("[%s] reload", __func__);
+	if (!_adopt_external_rows(db_connection))
+		BROWSER_LOGE("_adopt_external_rows failed");
+	m_url_prefix_index.unload();
+	/* The search entries are read again on the next search. */
+	m_history_generation++;
+}
+
+void Browser_History_DB::set_private_mode(Eina_Bool is_private)
+{
+	BROWSER_LOGD("[%s] %d", __func__, is_private);
+	if (m_is_private == is_private)
+		return;
+
+	m_is_private = is_private;
+	m_private_history.clear();
+}
+
+Eina_Bool Browser_History_DB::_write_visits(Browser_DB_Connection *db_connection, const std::vector<pending_visit> &visits,
+						const std::vector<pending_favicon> &favicons, Eina_Bool *is_evicted)
+{
+	/* One transaction for the whole batch instead of one per statement. */
+	if (!db_connection->begin_transaction())
+		return EINA_FALSE;
+
+	if (!_adopt_external_rows(db_connection))
+		BROWSER_LOGE("_adopt_external_rows failed");
+
+	for (int i = 0 ; i < visits.size() ; i++) {
+		if (!_write_visit(db_connection, visits[i], is_evicted)) {
+			BROWSER_LOGE("_write_visit failed [%s]", visits[i].url.c_str());
+			db_connection->rollback_transaction();
+			return EINA_FALSE;
+		}
+	}
+
+	/* A lost icon is received again on the next visit, it does not cancel the visits. */
+	for (int i = 0 ; i < favicons.size() ; i++) {
+		if (!Browser_Favicon::write_favicon(db_connection, favicons[i].host, favicons[i].favicon))
+			BROWSER_LOGE("write_favicon failed [%s]", favicons[i].host.c_str());
+	}
+
+	return db_connection->commit_transaction();
+}
+
+int Browser_History_DB::_get_history_count(Browser_DB_Connection *db_connection)
+{
+	/* history_stats is kept up to date by triggers (see browser_db_migrations),
+	  * so the number of rows is known without scanning the table. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select row_count from history_stats", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return -1;
+	}
+
+	int count = -1;
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW)
+		count = sqlite3_column_int(sqlite3_stmt, 0);
+	else
+		BROWSER_LOGD("SQL error=%d", error);
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return count;
+}
+
+Eina_Bool Browser_History_DB::_step_statement(Browser_DB_Connection *db_connection, const char *query, const int *value)
+{
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement(query, &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (value && sqlite3_bind_int(sqlite3_stmt, 1, *value) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d [%s]", error, query);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+void Browser_History_DB::_split_url(const char *url, std::string &host, std::string &path)
+{
+	const char *authority = strstr(url, "://");
+	authority = authority ? authority + strlen("://") : url;
+
+	const char *slash = strchr(authority, '/');
+	if (!slash) {
+		host = url;
+		path.clear();
+		return;
+	}
+
+	host.assign(url, slash - url);
+	path = slash;
+}
+
+int Browser_History_DB::_get_host_id(Browser_DB_Connection *db_connection, const std::string &host)
+{
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select id from history_hosts where host=?", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return -1;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, host.c_str(), -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+
+	int host_id = -1;
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW)
+		host_id = sqlite3_column_int(sqlite3_stmt, 0);
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE)
+		return host_id;
+
+	error = db_connection->prepare_statement("insert into history_hosts (host) values(?)", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return -1;
+	}
+
+	if (sqlite3_bind_text(sqlite3_stmt, 1, host.c_str(), -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_DONE)
+		host_id = sqlite3_last_insert_rowid(db_connection->get_descriptor());
+	else
+		BROWSER_LOGD("SQL error=%d", error);
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return host_id;
+}
+
+Eina_Bool Browser_History_DB::_archive_oldest_items(Browser_DB_Connection *db_connection, int count)
+{
+	/* Oldest rows first, walking the primary key only. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select id from history order by id limit ?", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int(sqlite3_stmt, 1, count) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	std::vector<int> ids;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW)
+		ids.push_back(sqlite3_column_int(sqlite3_stmt, 0));
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	for (int i = 0 ; i < ids.size() ; i++) {
+		error = db_connection->prepare_statement("select address from history where id=?", &sqlite3_stmt);
+		if (error != SQLITE_OK) {
+			BROWSER_LOGD("SQL error=%d", error);
+			if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			return EINA_FALSE;
+		}
+
+		if (sqlite3_bind_int(sqlite3_stmt, 1, ids[i]) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+		std::string host;
+		std::string path;
+		error = sqlite3_step(sqlite3_stmt);
+		if (error == SQLITE_ROW) {
+			const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
+			_split_url(url ? url : "", host, path);
+		}
+
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+		if (error != SQLITE_ROW) {
+			BROWSER_LOGD("SQL error=%d", error);
+			return EINA_FALSE;
+		}
+
+		int host_id = _get_host_id(db_connection, host);
+		if (host_id < 0)
+			return EINA_FALSE;
+
+		/* Another application may have added the address to history while it was archived. */
+		error = db_connection->prepare_statement("insert or replace into history_archive"
+							" (id, host_id, path, title, counter, visitdate, frecency, url_key)"
+							" select id, ?, ?, title, counter, visitdate, frecency,"
+								" ifnull(url_key, br_url_key(address)) from history where id=?",
+						&sqlite3_stmt);
+		if (error != SQLITE_OK) {
+			BROWSER_LOGD("SQL error=%d", error);
+			if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			return EINA_FALSE;
+		}
+
+		if (sqlite3_bind_int(sqlite3_stmt, 1, host_id) != SQLITE_OK
+		    || sqlite3_bind_text(sqlite3_stmt, 2, path.c_str(), -1, NULL) != SQLITE_OK
+		    || sqlite3_bind_int(sqlite3_stmt, 3, ids[i]) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_bind is failed.\n");
+
+		error = sqlite3_step(sqlite3_stmt);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+		if (error != SQLITE_DONE) {
+			BROWSER_LOGD("SQL error=%d", error);
+			return EINA_FALSE;
+		}
+
+		if (!_step_statement(db_connection, "delete from history where id=?", &ids[i]))
+			return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::_take_archived_item(Browser_DB_Connection *db_connection, sqlite3_int64 url_key,
+						archived_item *item, Eina_Bool *is_found)
+{
+	*is_found = EINA_FALSE;
+
+	/* One probe of idx_history_archive_on_url_key, so that http://x/ finds an archived https://x too. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select id, counter, frecency from history_archive"
+						" where url_key=? order by id desc limit 1", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, url_key) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int64 is failed.\n");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW) {
+		item->id = sqlite3_column_int(sqlite3_stmt, 0);
+		item->counter = sqlite3_column_int(sqlite3_stmt, 1);
+		item->frecency = BROWSER_FRECENCY_NONE;
+		if (sqlite3_column_type(sqlite3_stmt, 2) != SQLITE_NULL)
+			item->frecency = sqlite3_column_double(sqlite3_stmt, 2);
+		*is_found = EINA_TRUE;
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_ROW && error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	if (!*is_found)
+		return EINA_TRUE;
+
+	return _step_statement(db_connection, "delete from history_archive where id=?", &item->id);
+}
+
+Eina_Bool Browser_History_DB::_adopt_external_rows(Browser_DB_Connection *db_connection)
+{
+	/* Only the rows without key are visited, through idx_history_on_url_key.
+	  * Their last visit is logged first, so that they are shown in the history pages,
+	  * the key is set once it is done. */
+	if (!_step_statement(db_connection, "insert into history_visits (url_id, visittime, transition, weight, day)"
+					" select id, strftime('%s', ifnull(visitdate, 'now')), 0, 1.0, date(ifnull(visitdate, 'now'), 'localtime')"
+					" from history h where url_key is null"
+						" and not exists (select 1 from history_visits v where v.url_id = h.id)", NULL))
+		return EINA_FALSE;
+
+	return _step_statement(db_connection, "update history set url_key=br_url_key(address) where url_key is null", NULL);
+}
+
+Eina_Bool Browser_History_DB::_write_visit(Browser_DB_Connection *db_connection, const pending_visit &visit,
+						Eina_Bool *is_evicted)
+{
+	const char *url = visit.url.c_str();
+	const char *title = visit.title.c_str();
+
+	/* Update in place first, which is the common case of a revisit.
+	  * The row of the page is found by its key. Rows stored before the key existed may share one,
+	  * then the one with the same address, or else the newest, gets the visit. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select id from history where url_key=? order by address=? desc, id desc limit 1",
+					&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, visit.url_key) != SQLITE_OK
+	    || sqlite3_bind_text(sqlite3_stmt, 2, url, -1, NULL) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
+
+	int url_id = 0;
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW)
+		url_id = sqlite3_column_int(sqlite3_stmt, 0);
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_ROW && error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	if (url_id) {
+		error = db_connection->prepare_statement("update history set counter=counter+?, title=?, visitdate=DATETIME('now'),"
+							" frecency=br_frecency(frecency, ?, julianday('now')) where id=?",
+						&sqlite3_stmt);
+		if (error != SQLITE_OK) {
+			BROWSER_LOGD("SQL error=%d", error);
+			if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			return EINA_FALSE;
+		}
+
+		if (sqlite3_bind_int(sqlite3_stmt, 1, visit.visit_count) != SQLITE_OK
+		    || sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK
+		    || sqlite3_bind_double(sqlite3_stmt, 3, visit.frecency_weight) != SQLITE_OK
+		    || sqlite3_bind_int(sqlite3_stmt, 4, url_id) != SQLITE_OK) {
+			BROWSER_LOGE("sqlite3_bind is failed.\n");
+			if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			return EINA_FALSE;
+		}
+
+		error = sqlite3_step(sqlite3_stmt);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK && error == SQLITE_DONE)
+			return EINA_FALSE;
+		if (error != SQLITE_DONE) {
+			BROWSER_LOGD("SQL error=%d", error);
+			return EINA_FALSE;
+		}
+
+		return _write_visit_events(db_connection, url_id, visit.events);
+	}
+
+	archived_item archived;
+	Eina_Bool is_archived = EINA_FALSE;
+	if (!_take_archived_item(db_connection, visit.url_key, &archived, &is_archived))
+		return EINA_FALSE;
+
+	int history_count = _get_history_count(db_connection);
+	if (history_count < 0)
+		return EINA_FALSE;
+
+	if (history_count >= BROWSER_HISTORY_COUNT_LIMIT) {
+		*is_evicted = EINA_TRUE;
+		if (!_archive_oldest_items(db_connection, history_count - BROWSER_HISTORY_COUNT_LIMIT + 1))
+			return EINA_FALSE;
+	}
+
+	/* A new id is above the ids of both tables, an archived item keeps its own. */
+	error = db_connection->prepare_statement("insert into history (id, address, title, counter, visitdate, frecency, url_key)"
+						" values(ifnull(?, (select max(id) + 1 from (select max(id) as id from history"
+						" union all select max(id) from history_archive))),"
+						" ?, ?, ?, DATETIME('now'), br_frecency(?, ?, julianday('now')), ?)",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	/* The first visit of an address is stored with counter 0. */
+	int counter = is_archived ? archived.counter + visit.visit_count : visit.visit_count - 1;
+	if ((is_archived && sqlite3_bind_int(sqlite3_stmt, 1, archived.id) != SQLITE_OK)
+	    || sqlite3_bind_text(sqlite3_stmt, 2, url, -1, NULL) != SQLITE_OK
+	    || sqlite3_bind_text(sqlite3_stmt, 3, title, -1, NULL) != SQLITE_OK
+	    || sqlite3_bind_int(sqlite3_stmt, 4, counter) != SQLITE_OK
+	    || (is_archived && archived.frecency != BROWSER_FRECENCY_NONE
+		&& sqlite3_bind_double(sqlite3_stmt, 5, archived.frecency) != SQLITE_OK)
+	    || sqlite3_bind_double(sqlite3_stmt, 6, visit.frecency_weight) != SQLITE_OK
+	    || sqlite3_bind_int64(sqlite3_stmt, 7, visit.url_key) != SQLITE_OK) {
+		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_FULL)
+		BROWSER_LOGE("history is full");
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK || error != SQLITE_DONE)
+		return EINA_FALSE;
+
+	return _write_visit_events(db_connection, sqlite3_last_insert_rowid(db_connection->get_descriptor()), visit.events);
+}
+
+Eina_Bool Browser_History_DB::_write_visit_events(Browser_DB_Connection *db_connection, int url_id,
+							const std::vector<visit_event> &events)
+{
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("insert into history_visits (url_id, visittime, transition, weight, day)"
+						" values(?, ?, ?, ?, date(?, 'unixepoch', 'localtime'))", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	for (int i = 0 ; i < events.size() ; i++) {
+		if (sqlite3_bind_int(sqlite3_stmt, 1, url_id) != SQLITE_OK
+		    || sqlite3_bind_int64(sqlite3_stmt, 2, events[i].time) != SQLITE_OK
+		    || sqlite3_bind_int(sqlite3_stmt, 3, events[i].transition) != SQLITE_OK
+		    || sqlite3_bind_double(sqlite3_stmt, 4, events[i].frecency_weight) != SQLITE_OK
+		    || sqlite3_bind_int64(sqlite3_stmt, 5, events[i].time) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_bind is failed.\n");
+
+		error = sqlite3_step(sqlite3_stmt);
+		if (error != SQLITE_DONE) {
+			BROWSER_LOGD("SQL error=%d", error);
+			break;
+		}
+		sqlite3_reset(sqlite3_stmt);
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return (error == SQLITE_DONE);
+}
+
+Eina_Bool Browser_History_DB::delete_history(const char *url)
+{
+	if (!url || strlen(url) == 0) {
+		BROWSER_LOGE("url is empty");
+		return EINA_FALSE;
+	}
+
+	/* Private mode shows the stored history too, the url is removed from both. */
+	m_private_history.remove(url);
+
+	/* Read your own writes : the pending visits must be in the table first. */
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	m_url_prefix_index.unload();
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	if (!m_db_connection->begin_transaction())
+		return EINA_FALSE;
+
+	/* Every row of the page goes, whichever of its addresses was stored. */
+	if (!_delete_url_key(m_db_connection, br_url_key(url))) {
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	return m_db_connection->commit_transaction();
+}
+
+Eina_Bool Browser_History_DB::_delete_url_key(Browser_DB_Connection *db_connection, sqlite3_int64 url_key)
+{
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("delete from history_visits where url_id in (select id from history where url_key=?)",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, url_key) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int64 is failed.");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	error = db_connection->prepare_statement("delete from history where url_key=?",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, url_key) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int64 is failed.");
+
+	error = sqlite3_step(sqlite3_stmt);
+	if (error != SQLITE_OK && error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	/* Rows archived before the key existed may share one. */
+	archived_item archived;
+	Eina_Bool is_archived = EINA_FALSE;
+	do {
+		if (!_take_archived_item(db_connection, url_key, &archived, &is_archived))
+			return EINA_FALSE;
+		if (is_archived && !_step_statement(db_connection, "delete from history_visits where url_id=?", &archived.id))
+			return EINA_FALSE;
+	} while (is_archived);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::delete_history(int history_id)
+{
+	/* The rows of the id and its visits go in one transaction. */
+	return delete_history(std::vector<int>(1, history_id));
+}
+
+Eina_Bool Browser_History_DB::delete_history(const std::vector<int> &history_ids)
+{
+	BROWSER_LOGD("[%s] %d items", __func__, (int)history_ids.size());
+	if (history_ids.empty())
+		return EINA_TRUE;
+
+	std::vector<int> stored_ids;
+	for (int i = 0 ; i < history_ids.size() ; i++) {
+		if (history_ids[i] < 0)
+			m_private_history.remove(history_ids[i]);
+		else
+			stored_ids.push_back(history_ids[i]);
+	}
+	if (stored_ids.empty())
+		return EINA_TRUE;
+	if (stored_ids.size() != history_ids.size())
+		return delete_history(stored_ids);
+
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	m_url_prefix_index.unload();
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	if (!m_db_connection->begin_transaction())
+		return EINA_FALSE;
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = m_db_connection->prepare_statement("delete from history where id=?",
+					&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		m_db_connection->rollback_transaction();
+		return EINA_FALSE;
+	}
+
+	/* The same statement is stepped once per id, all inside one transaction. */
+	for (int i = 0 ; i < history_ids.size() ; i++) {
+		if (sqlite3_bind_int(sqlite3_stmt, 1, history_ids[i]) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+		error = sqlite3_step(sqlite3_stmt);
+		if (error != SQLITE_DONE) {
+			BROWSER_LOGD("SQL error=%d", error);
+			if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			m_db_connection->rollback_transaction();
+			return EINA_FALSE;
+		}
+		sqlite3_reset(sqlite3_stmt);
+
+		if (!_step_statement(m_db_connection, "delete from history_archive where id=?", &history_ids[i])
+		    || !_step_statement(m_db_connection, "delete from history_visits where url_id=?", &history_ids[i])) {
+			if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+				BROWSER_LOGE("sqlite3_finalize is failed.\n");
+			m_db_connection->rollback_transaction();
+			return EINA_FALSE;
+		}
+	}
+
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return m_db_connection->commit_transaction();
+}
+
+Eina_Bool Browser_History_DB::get_most_visited_list(vector<most_visited_item> &list)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	/* Only filled in private mode, merged by frecency with the stored addresses. */
+	int count = atoi(BROWSER_MOST_VISITED_COUNT_TEXT);
+	std::vector<const Browser_Private_History::entry *> entries;
+	m_private_history.get_most_visited(count, entries);
+	std::set<sqlite3_int64> private_url_keys;
+	for (int i = 0 ; i < entries.size() ; i++)
+		private_url_keys.insert(entries[i]->url_key);
+
+	/* Read your own writes : the pending visits must be in the table first. */
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+
+	/* Each part reads the top of its frecency index only. */
+	int error = m_db_connection->prepare_statement("select id, address, title, frecency from (select * from ("
+						"select id, address, title, frecency from history order by frecency desc limit "BROWSER_MOST_VISITED_COUNT_TEXT")"
+					" union all select a.id, h.host || a.path, a.title, a.frecency from ("
+						"select id, host_id, path, title, frecency from history_archive order by frecency desc limit "BROWSER_MOST_VISITED_COUNT_TEXT") a"
+						" join history_hosts h on h.id=a.host_id"
+					" order by frecency desc limit "BROWSER_MOST_VISITED_COUNT_TEXT")",
+					&sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	most_visited_item item;
+	int added_count = 0;
+	int private_index = 0;
+	while (added_count < count && (error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		double frecency = BROWSER_FRECENCY_NONE;
+		if (sqlite3_column_type(sqlite3_stmt, 3) != SQLITE_NULL)
+			frecency = sqlite3_column_double(sqlite3_stmt, 3);
+
+		for (; private_index < entries.size() && entries[private_index]->frecency > frecency
+		       && added_count < count ; private_index++, added_count++) {
+			item.id = entries[private_index]->id;
+			item.url = entries[private_index]->url;
+			item.title = entries[private_index]->title;
+			list.push_back(item);
+		}
+
+		/* The file is shared, another application may have left the address or the title null. */
+		const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
+		if (!url || !strlen(url))
+			continue;
+
+		item.id = sqlite3_column_int(sqlite3_stmt, 0);
+		item.url = url;
+		const char *title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
+		item.title = title ? title : "";
+
+		/* An address visited in private mode is listed once, by the key of its page. */
+		if (added_count < count && !private_url_keys.count(br_url_key(url))) {
+			list.push_back(item);
+			added_count++;
+		}
+	}
+
+	for (; private_index < entries.size() && added_count < count ; private_index++, added_count++) {
+		item.id = entries[private_index]->id;
+		item.url = entries[private_index]->url;
+		item.title = entries[private_index]->title;
+		list.push_back(item);
+	}
+
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return (error == SQLITE_DONE || error == SQLITE_ROW);
+}
+
+Eina_Bool Browser_History_DB::_load_url_prefix_index(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	/* The visits still in the queue are added to the index by save_history() only once it is loaded. */
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
+
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = m_db_connection->prepare_statement("select address, frecency from history"
+					" union all select h.host || a.path, a.frecency from ("
+						"select host_id, path, frecency from history_archive order by frecency desc limit ?) a"
+						" join history_hosts h on h.id=a.host_id", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
+	}
+
+	if (sqlite3_bind_int(sqlite3_stmt, 1, BROWSER_HISTORY_ARCHIVE_PREFIX_COUNT) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+
+	std::vector<Browser_Url_Prefix_Index::url_entry> entries;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
+		if (!url)
+			continue;
+
+		Browser_Url_Prefix_Index::url_entry entry;
+		entry.key = Browser_Url_Prefix_Index::get_key(url);
+		entry.url = std::string(url);
+		entry.frecency = BROWSER_FRECENCY_NONE;
+		if (sqlite3_column_type(sqlite3_stmt, 1) != SQLITE_NULL)
+			entry.frecency = sqlite3_column_double(sqlite3_stmt, 1);
+		entries.push_back(entry);
+	}
+
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
+
+	m_url_prefix_index.set_entries(entries);
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::get_history_list_by_partial_url(const char *url, int count, std::vector<std::string> &list)
+{
+	if (!url || strlen(url) == 0) {
+		BROWSER_LOGE("partial_url is empty");
+		return EINA_FALSE;
+	}
+
+	/* Only filled in private mode, the addresses of the private session come first. */
+	std::vector<std::string> private_list;
+	m_private_history.get_matches(url, count, private_list);
+
+	/* Only the first call after start up or after a delete reads the table. */
+	if (!m_url_prefix_index.is_loaded() && !_load_url_prefix_index())
+		return EINA_FALSE;
+
+	if (private_list.empty()) {
+		m_url_prefix_index.get_matches(url, count, list);
+		return EINA_TRUE;
+	}
+
+	std::vector<std::string> stored_list;
+	m_url_prefix_index.get_matches(url, count, stored_list);
+	list.insert(list.end(), private_list.begin(), private_list.end());
+	for (int i = 0 ; i < stored_list.size() && private_list.size() < count ; i++) {
+		if (std::find(private_list.begin(), private_list.end(), stored_list[i]) != private_list.end())
+			continue;
+		private_list.push_back(stored_list[i]);
+		list.push_back(stored_list[i]);
+	}
+
+	return EINA_TRUE;
+}
+
+Eina_Bool Browser_History_DB::_step_history_items(sqlite3_stmt *sqlite3_stmt, std::vector<history_item *> &list,
+						std::vector<history_day_group> *groups)
+{
+	int error;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		history_item *item = new(nothrow) history_item;
+		if (!item) {
+			BROWSER_LOGD("new history_item is failed");
+			return EINA_FALSE;
+		}
+		item->id = sqlite3_column_int(sqlite3_stmt, 0);
+
+		const char* url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
+		if (url && strlen(url))
+			item->url = url;
+		else
+			item->url = "";
+
+		const char* title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
+		if (title && strlen(title))
+			item->title = title;
+		else
+			item->title = "";
+
+		item->visit_time = (time_t)sqlite3_column_int64(sqlite3_stmt, 3);
+		item->user_data = NULL;
+		item->is_delete = EINA_FALSE;
+
+		list.push_back(item);
+
+		if (groups)
+			_add_to_day_groups(groups, (time_t)sqlite3_column_int64(sqlite3_stmt, 4), list.size() - 1);
+	}
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error: %d", error);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
+}
+
+void Browser_History_DB::_add_to_day_groups(std::vector<history_day_group> *groups, time_t day, int index)
+{
+	if (groups->size() && groups->back().day == day) {
+		groups->back().count++;
+		return;
+	}
+
+	history_day_group group;
+	group.day = day;
+	group.first_index = index;
+	group.count = 1;
+	groups->push_back(group);
+}
+
+Eina_Bool Browser_History_DB::_add_private_items(const std::vector<const Browser_Private_History::entry *> &entries,
+						std::vector<history_item *> &list, std::vector<history_day_group> *groups)
+{
+	for (int i = 0 ; i < entries.size() ; i++) {
+		history_item *item = new(nothrow) history_item;
+		if (!item) {
+			BROWSER_LOGE("new history_item is failed");
+			return EINA_FALSE;
+		}
+		item->id = entries[i]->id;
+		item->url = entries[i]->url;
+		item->title = entries[i]->title;
+		item->visit_time = entries[i]->visit_times.back();
+		item->is_delete = EINA_FALSE;
+		item->user_data = NULL;
+
+		list.push_back(item);
 
-sqlite3* Browser_History_DB::m_db_descriptor = NULL;
+		if (groups) {
+			struct tm local_time;
+			localtime_r(&item->visit_time, &local_time);
+			local_time.tm_hour = 0;
+			local_time.tm_min = 0;
+			local_time.tm_sec = 0;
+			local_time.tm_isdst = -1;
+			_add_to_day_groups(groups, mktime(&local_time), list.size() - 1);
+		}
+	}
 
-Browser_History_DB::Browser_History_DB(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
+	return EINA_TRUE;
 }
 
-Browser_History_DB::~Browser_History_DB(void)
+Eina_Bool Browser_History_DB::_merge_private_items(std::vector<history_item *> &page,
+						const std::vector<history_day_group> &page_groups,
+						const std::vector<const Browser_Private_History::entry *> &entries, int limit,
+						std::vector<history_item *> &list, std::vector<history_day_group> *groups)
 {
-	BROWSER_LOGD("[%s]", __func__);
+	std::vector<history_item *> private_page;
+	std::vector<history_day_group> private_groups;
+	Eina_Bool ret = _add_private_items(entries, private_page, &private_groups);
+
+	/* The local midnight of each item, from the groups which cover all of them. */
+	std::vector<time_t> days;
+	std::vector<time_t> private_days;
+	for (int i = 0 ; i < page_groups.size() ; i++)
+		days.insert(days.end(), page_groups[i].count, page_groups[i].day);
+	for (int i = 0 ; i < private_groups.size() ; i++)
+		private_days.insert(private_days.end(), private_groups[i].count, private_groups[i].day);
+
+	int index = 0;
+	int private_index = 0;
+	int added_count = 0;
+	while (index < page.size() || private_index < private_page.size()) {
+		/* The private ids are negative, a private item goes after a stored one of the same time. */
+		Eina_Bool is_private = index == page.size()
+				|| (private_index < private_page.size()
+				    && private_page[private_index]->visit_time > page[index]->visit_time);
+		history_item *item = is_private ? private_page[private_index] : page[index];
+		time_t day = is_private ? private_days[private_index++] : days[index++];
+
+		if (added_count == limit) {
+			delete item;
+			continue;
+		}
+
+		list.push_back(item);
+		added_count++;
+		if (groups)
+			_add_to_day_groups(groups, day, list.size() - 1);
+	}
+	page.clear();
+
+	return ret;
 }
 
-Eina_Bool Browser_History_DB::_open_db(void)
+Eina_Bool Browser_History_DB::get_history_list(vector<history_item*> &list, std::vector<history_day_group> *groups)
 {
 	BROWSER_LOGD("[%s]", __func__);
-	int error = db_util_open(BROWSER_HISTORY_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	/* Read your own writes : the pending visits must be in the table first. */
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
-	}
 
-	return EINA_TRUE;
+	/* Only filled in private mode. */
+	if (m_private_history.is_empty())
+		return _read_history_list(m_db_connection, list, groups);
+
+	std::vector<history_item *> page;
+	std::vector<history_day_group> page_groups;
+	Eina_Bool ret = _read_history_list(m_db_connection, page, &page_groups);
+
+	std::vector<const Browser_Private_History::entry *> entries;
+	m_private_history.get_page(0, 0, BROWSER_HISTORY_COUNT_LIMIT, entries);
+	if (!_merge_private_items(page, page_groups, entries, page.size() + entries.size(), list, groups))
+		ret = EINA_FALSE;
+
+	return ret;
 }
 
-Eina_Bool Browser_History_DB::_close_db(void)
+Eina_Bool Browser_History_DB::_read_history_list(Browser_DB_Connection *db_connection, std::vector<history_item *> &list,
+						std::vector<history_day_group> *groups)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_db_descriptor)
-	{
-		int error = db_util_close(m_db_descriptor);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGE("db_util_close error");
-			m_db_descriptor = NULL;
-			return EINA_FALSE;
-		}
-		m_db_descriptor = NULL;
+	/* The dates are converted by sqlite, the callers only compare and format integers. */
+	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error = db_connection->prepare_statement("select id, address, title, strftime('%s', visitdate),"
+							" strftime('%s', visitdate, 'localtime', 'start of day', 'utc')"
+						" from history order by visitdate desc, id desc", &sqlite3_stmt);
+	if (error != SQLITE_OK) {
+		BROWSER_LOGD("SQL error=%d", error);
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+		return EINA_FALSE;
 	}
 
-	return EINA_TRUE;
+	Eina_Bool ret = _step_history_items(sqlite3_stmt, list, groups);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	return ret;
 }
 
-Eina_Bool Browser_History_DB::save_history(const char *url, const char *title, Eina_Bool *is_full)
+Eina_Bool Browser_History_DB::get_history_page(time_t before_visit_time, int before_id, int limit,
+						std::vector<history_item *> &list, std::vector<history_day_group> *groups)
 {
-	if (url == NULL || title == NULL || strlen(url) == 0 || strlen(title) == 0)
-		return EINA_FALSE;
+	BROWSER_LOGD("[%s] before %ld id=%d", __func__, (long)before_visit_time, before_id);
+	if (limit <= 0)
+		return EINA_TRUE;
+
+	/* Read your own writes : the pending visits must be in the table first. */
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
 
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
+	/* Only filled in private mode. */
+	if (m_private_history.is_empty())
+		return _read_history_page(m_db_connection, before_visit_time, before_id, limit, list, groups);
+
+	/* The same keyset pages both, the private ids being negative. */
+	std::vector<history_item *> page;
+	std::vector<history_day_group> page_groups;
+	Eina_Bool ret = _read_history_page(m_db_connection, before_visit_time, before_id, limit, page, &page_groups);
+
+	std::vector<const Browser_Private_History::entry *> entries;
+	m_private_history.get_page(before_visit_time, before_id, limit, entries);
+	if (!_merge_private_items(page, page_groups, entries, limit, list, groups))
+		ret = EINA_FALSE;
+
+	return ret;
+}
+
+Eina_Bool Browser_History_DB::_read_history_page(Browser_DB_Connection *db_connection, time_t before_visit_time,
+						int before_id, int limit, std::vector<history_item *> &list,
+						std::vector<history_day_group> *groups)
+{
+	/* One item per day and address, from history_daily_visits, so that an address is shown under every day
+	  * it was visited on. Keyset paging : a range read on idx_history_daily_visits_on_last_visittime
+	  * from the last item on, so the cost of a page does not grow with the number of pages before it.
+	  * The address is in history or, with the same id, in the archive. */
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select counter from history where address=?",
-					-1, &sqlite3_stmt, NULL);
+	int error;
+	if (!before_visit_time)
+		error = db_connection->prepare_statement("select d.url_id,"
+							" case when h.id is not null then h.address else s.host || a.path end,"
+							" case when h.id is not null then h.title else a.title end,"
+							" d.last_visittime, strftime('%s', d.day, 'utc')"
+						" from history_daily_visits d"
+							" left join history h on h.id=d.url_id"
+							" left join history_archive a on h.id is null and a.id=d.url_id"
+							" left join history_hosts s on s.id=a.host_id"
+						" where h.id is not null or s.id is not null"
+						" order by d.last_visittime desc, d.url_id desc limit ?1", &sqlite3_stmt);
+	else
+		error = db_connection->prepare_statement("select d.url_id,"
+							" case when h.id is not null then h.address else s.host || a.path end,"
+							" case when h.id is not null then h.title else a.title end,"
+							" d.last_visittime, strftime('%s', d.day, 'utc')"
+						" from history_daily_visits d"
+							" left join history h on h.id=d.url_id"
+							" left join history_archive a on h.id is null and a.id=d.url_id"
+							" left join history_hosts s on s.id=a.host_id"
+						" where d.last_visittime <= ?2 and (d.last_visittime < ?2 or d.url_id < ?3)"
+							" and (h.id is not null or s.id is not null)"
+						" order by d.last_visittime desc, d.url_id desc limit ?1", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	error = sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL);
+	error = sqlite3_bind_int(sqlite3_stmt, 1, limit);
+	if (before_visit_time && error == SQLITE_OK
+	    && (error = sqlite3_bind_int64(sqlite3_stmt, 2, before_visit_time)) == SQLITE_OK)
+		error = sqlite3_bind_int(sqlite3_stmt, 3, before_id);
+
 	if (error != SQLITE_OK) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	error = sqlite3_step(sqlite3_stmt);
-	if (error == SQLITE_ROW) {
-		int count = sqlite3_column_int(sqlite3_stmt, 0);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-			_close_db();
-			return EINA_FALSE;
-		}
-
-		error = sqlite3_prepare_v2(m_db_descriptor, "update history set counter=?, title=?, visitdate=DATETIME('now') where address=?",
-						-1, &sqlite3_stmt, NULL);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGD("SQL error=%d", error);
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
-
-		if (sqlite3_bind_int(sqlite3_stmt, 1, count + 1) != SQLITE_OK) {
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
-
-		if (sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK) {
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
-
-		if (sqlite3_bind_text(sqlite3_stmt, 3, url, -1, NULL) != SQLITE_OK) {
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
-
-		error = sqlite3_step(sqlite3_stmt);
-	} else {
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-			_close_db();
-			return EINA_FALSE;
-		}
+	Eina_Bool ret = _step_history_items(sqlite3_stmt, list, groups);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-		error = sqlite3_prepare_v2(m_db_descriptor, "select count(*) from history", -1, &sqlite3_stmt, NULL);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGD("SQL error=%d", error);
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
+	return ret;
+}
 
-		error = sqlite3_step(sqlite3_stmt);
-		if (error != SQLITE_ROW) {
-			BROWSER_LOGD("SQL error=%d", error);
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
+class Browser_History_DB::history_page_job : public Browser_DB_Job {
+public:
+	history_page_job(time_t before_visit_time, int before_id, int limit, history_page_cb callback, void *user_data)
+		: m_before_visit_time(before_visit_time), m_before_id(before_id), m_limit(limit)
+		, m_callback(callback), m_user_data(user_data), m_result(EINA_FALSE) {}
+	~history_page_job(void)
+	{
+		for (int i = 0 ; i < m_list.size() ; i++)
+			delete m_list[i];
+	}
+	void run(void)
+	{
+		Browser_DB_Connection *db_connection = Browser_DB_Executor::get_instance()->get_worker_connection(BROWSER_HISTORY_DB_PATH);
+		if (db_connection)
+			m_result = _read_history_page(db_connection, m_before_visit_time, m_before_id, m_limit, m_list, &m_groups);
+	}
+	void done(void)
+	{
+		/* The private history is only touched on the main loop, and only filled in private mode. */
+		if (!m_private_history.is_empty()) {
+			std::vector<history_item *> page;
+			std::vector<history_day_group> page_groups;
+			page.swap(m_list);
+			page_groups.swap(m_groups);
+
+			std::vector<const Browser_Private_History::entry *> entries;
+			m_private_history.get_page(m_before_visit_time, m_before_id, m_limit, entries);
+			if (!_merge_private_items(page, page_groups, entries, m_limit, m_list, &m_groups))
+				m_result = EINA_FALSE;
 		}
+		m_callback(m_result, m_list, m_groups, m_user_data);
+		m_list.clear();
+	}
 
-		unsigned history_count = sqlite3_column_int(sqlite3_stmt, 0);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-			_close_db();
-			return EINA_FALSE;
-		}
+	time_t m_before_visit_time;
+	int m_before_id;
+	int m_limit;
+	history_page_cb m_callback;
+	void *m_user_data;
+	Eina_Bool m_result;
+	std::vector<history_item *> m_list;
+	std::vector<history_day_group> m_groups;
+};
+
+int Browser_History_DB::get_history_page_async(time_t before_visit_time, int before_id, int limit,
+						history_page_cb callback, void *user_data, int priority)
+{
+	BROWSER_LOGD("[%s] before %ld id=%d", __func__, (long)before_visit_time, before_id);
+	if (!callback || limit <= 0)
+		return 0;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	if (!executor)
+		return 0;
+
+	/* The pending visits are posted first, so the read runs after them. */
+	if (!_flush_visits_async())
+		BROWSER_LOGE("_flush_visits_async failed");
+
+	history_page_job *job = new(nothrow) history_page_job(before_visit_time, before_id, limit, callback, user_data);
+	if (!job) {
+		BROWSER_LOGE("new history_page_job failed");
+		return 0;
+	}
 
-		if (history_count >= BROWSER_HISTORY_COUNT_LIMIT) {
-			string delete_query = "delete from history where id = (select min(id) from history)";
-			if (history_count > BROWSER_HISTORY_COUNT_LIMIT) {
-				unsigned delete_count = history_count - BROWSER_HISTORY_COUNT_LIMIT + 1;
-				char text[128] = {0, };
-				sprintf(text, "delete from history where id in (select id from history limit %d)", delete_count);
-				delete_query = text;
-			}
-
-			error = sqlite3_prepare_v2(m_db_descriptor, delete_query.c_str(), -1, &sqlite3_stmt, NULL);
-			if (error != SQLITE_OK) {
-				BROWSER_LOGD("SQL error=%d", error);
-				if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-					BROWSER_LOGE("sqlite3_finalize is failed.\n");
-				_close_db();
-				return EINA_FALSE;
-			}
-
-			error = sqlite3_step(sqlite3_stmt);
-			if (error != SQLITE_DONE) {
-				BROWSER_LOGD("SQL error=%d", error);
-				if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-					BROWSER_LOGE("sqlite3_finalize is failed.\n");
-				_close_db();
-				return EINA_FALSE;
-			}
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-				_close_db();
-				return EINA_FALSE;
-			}
-		}
+	int job_id = executor->post(job, priority);
+	if (!job_id)
+		delete job;
 
-		const string insert_url(url);
-		const string insert_title(title);
+	return job_id;
+}
 
-		const string statement = "insert into history (address, title, counter, visitdate) values('" + insert_url 
-						+ "','" + insert_title + "', 0, DATETIME('now'))";
-		error = sqlite3_prepare_v2(m_db_descriptor, statement.c_str(), -1, &sqlite3_stmt, NULL);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGD("SQL error=%d", error);
-			if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-				BROWSER_LOGE("sqlite3_finalize is failed.\n");
-			_close_db();
-			return EINA_FALSE;
-		}
+Eina_Bool Browser_History_DB::clear_history(void)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	/* Visits which are not written yet and the private ones are cleared as well. */
+	m_private_history.clear();
+	m_pending_visits.clear();
+	m_pending_favicons.clear();
+	m_url_prefix_index.unload();
+	if (m_flush_visits_timer) {
+		ecore_timer_del(m_flush_visits_timer);
+		m_flush_visits_timer = NULL;
+	}
+	/* Otherwise its visits would be written back after the delete. */
+	_finish_flush_job(EINA_TRUE);
 
-		error = sqlite3_step(sqlite3_stmt);
+	if (_open_db() == EINA_FALSE)
+		return EINA_FALSE;
 
-		if (error == SQLITE_FULL)
-			*is_full = EINA_TRUE;
-		else
-			*is_full = EINA_FALSE;
-	}
+	if (!m_db_connection->begin_transaction())
+		return EINA_FALSE;
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-		_close_db();
+	if (!_step_statement(m_db_connection, "delete from history", NULL)
+	    || !_step_statement(m_db_connection, "delete from history_archive", NULL)
+	    || !_step_statement(m_db_connection, "delete from history_hosts", NULL)
+	    || !_step_statement(m_db_connection, "delete from history_daily_visits", NULL)
+	    || !_step_statement(m_db_connection, "delete from history_visits", NULL)) {
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
 
-	_close_db();
-
-	return (error == SQLITE_DONE);
+	return m_db_connection->commit_transaction();
 }
 
-Eina_Bool Browser_History_DB::delete_history(const char *url)
+Eina_Bool Browser_History_DB::delete_history_by_time(time_t from, time_t to)
 {
-	if (!url || strlen(url) == 0) {
-		BROWSER_LOGE("url is empty");
-		return EINA_FALSE;
-	}
+	BROWSER_LOGD("[%s] %ld - %ld", __func__, (long)from, (long)to);
+	/* Private mode shows the stored history too, the visits are removed from both. */
+	m_private_history.remove_visits(from, to);
+
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	m_url_prefix_index.unload();
 
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
+	/* A range read on idx_history_visits_on_visittime, grouped by address. */
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "delete from history where address=?",
-								-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select url_id, visittime, transition, weight from history_visits"
+						" where visittime >= ? and visittime < ? order by url_id", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.");
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, from) != SQLITE_OK
+	    || sqlite3_bind_int64(sqlite3_stmt, 2, to) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
 
-	error = sqlite3_step(sqlite3_stmt);
-	if (error != SQLITE_OK && error != SQLITE_DONE) {
-		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
-		return EINA_FALSE;
+	std::vector<int> url_ids;
+	std::vector<std::vector<visit_event> > removed_events;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		int url_id = sqlite3_column_int(sqlite3_stmt, 0);
+		if (url_ids.empty() || url_ids.back() != url_id) {
+			url_ids.push_back(url_id);
+			removed_events.push_back(std::vector<visit_event>());
+		}
+
+		visit_event event;
+		event.time = sqlite3_column_int64(sqlite3_stmt, 1);
+		event.transition = sqlite3_column_int(sqlite3_stmt, 2);
+		event.frecency_weight = sqlite3_column_double(sqlite3_stmt, 3);
+		removed_events.back().push_back(event);
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		return EINA_FALSE;
+	}
 
-	return EINA_TRUE;
-}
+	if (url_ids.empty())
+		return EINA_TRUE;
 
-Eina_Bool Browser_History_DB::delete_history(int history_id)
-{
-	if (_open_db() == EINA_FALSE)
+	if (!m_db_connection->begin_transaction())
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "delete from history where id=?",
-					-1, &sqlite3_stmt, NULL);
+	error = m_db_connection->prepare_statement("delete from history_visits where visittime >= ? and visittime < ?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_int(sqlite3_stmt, 1, history_id) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, from) != SQLITE_OK
+	    || sqlite3_bind_int64(sqlite3_stmt, 2, to) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
+
 	error = sqlite3_step(sqlite3_stmt);
-	if (error != SQLITE_OK && error != SQLITE_DONE) {
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_finalize is failed.\n");
+
+	if (error != SQLITE_DONE) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
+		m_db_connection->rollback_transaction();
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	_close_db();
+	/* The address of a visit is either in history or in the archive. */
+	for (int i = 0 ; i < url_ids.size() ; i++) {
+		if (!_remove_visit_events(m_db_connection, EINA_FALSE, url_ids[i], removed_events[i])
+		    || !_remove_visit_events(m_db_connection, EINA_TRUE, url_ids[i], removed_events[i])) {
+			m_db_connection->rollback_transaction();
+			return EINA_FALSE;
+		}
+	}
 
-	return EINA_TRUE;
+	return m_db_connection->commit_transaction();
 }
 
-Eina_Bool Browser_History_DB::get_most_visited_list(vector<most_visited_item> &list)
+Eina_Bool Browser_History_DB::_remove_visit_events(Browser_DB_Connection *db_connection, Eina_Bool is_archive, int url_id,
+							const std::vector<visit_event> &events)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	if (_open_db() == EINA_FALSE)
-		return EINA_FALSE;
-
 	sqlite3_stmt *sqlite3_stmt = NULL;
-
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select address, title from history order by counter desc limit "BROWSER_MOST_VISITED_COUNT_TEXT,
-					-1, &sqlite3_stmt, NULL);
+	int error = db_connection->prepare_statement(is_archive ? "select frecency from history_archive where id=?"
+							: "select frecency from history where id=?", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
+	if (sqlite3_bind_int(sqlite3_stmt, 1, url_id) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
-	most_visited_item item;
-	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
-		item.url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
-		item.title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
-
-		list.push_back(item);
-	}
+	double frecency = BROWSER_FRECENCY_NONE;
+	error = sqlite3_step(sqlite3_stmt);
+	if (error == SQLITE_ROW && sqlite3_column_type(sqlite3_stmt, 0) != SQLITE_NULL)
+		frecency = sqlite3_column_double(sqlite3_stmt, 0);
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
-
-	return (error == SQLITE_DONE || error == SQLITE_ROW);
-}
-
-Eina_Bool Browser_History_DB::get_history_list_by_partial_url(const char *url, int count, std::vector<std::string> &list)
-{
-	if (!url || strlen(url) == 0) {
-		BROWSER_LOGE("partial_url is empty");
+	if (error == SQLITE_DONE)
+		return EINA_TRUE;
+	if (error != SQLITE_ROW) {
+		BROWSER_LOGD("SQL error=%d", error);
 		return EINA_FALSE;
 	}
 
-	if (_open_db() == EINA_FALSE)
-		return EINA_FALSE;
-
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	std::string query = "select address, counter from history where address like '%" + std::string(url) + "%'";
+	/* A negative weight takes the visit out of the score at the time it was made. */
+	for (int i = 0 ; i < events.size() && frecency != BROWSER_FRECENCY_NONE ; i++)
+		frecency = br_frecency_add(frecency, -events[i].frecency_weight, events[i].time / (24.0 * 60 * 60));
 
-	int error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+	int visit_count = events.size();
+	/* Deleted if no visit is left, otherwise dated by the last one left. */
+	if (is_archive)
+		error = db_connection->prepare_statement("update history_archive set counter=max(counter - ?, 0),"
+							" visitdate=(select datetime(max(visittime), 'unixepoch') from history_visits where url_id=?2),"
+							" frecency=? where id=?2", &sqlite3_stmt);
+	else
+		error = db_connection->prepare_statement("update history set counter=max(counter - ?, 0),"
+							" visitdate=(select datetime(max(visittime), 'unixepoch') from history_visits where url_id=?2),"
+							" frecency=? where id=?2", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	int i;
-	for (i = 0; i < count; i++) {
-		error = sqlite3_step(sqlite3_stmt);
-		if (error == SQLITE_ROW) {
-			std::string mark_up = std::string(reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0)));
-			size_t index = mark_up.find(BROWSER_HTTP_SCHEME);
-			if(index == 0) {
-				index = mark_up.find(url, strlen(BROWSER_HTTP_SCHEME));
-				if(index == -1)
-					continue;
-			}
-
-			index = mark_up.find(BROWSER_HTTPS_SCHEME);
-			if(index == 0) {
-				index = mark_up.find(url, strlen(BROWSER_HTTPS_SCHEME));
-				if(index == -1)
-					continue;
-			}
-
-			list.push_back(std::string(reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0))));
-		} else
-			break;
-	}
+	if (sqlite3_bind_int(sqlite3_stmt, 1, visit_count) != SQLITE_OK
+	    || sqlite3_bind_int(sqlite3_stmt, 2, url_id) != SQLITE_OK
+	    || (frecency != BROWSER_FRECENCY_NONE && sqlite3_bind_double(sqlite3_stmt, 3, frecency) != SQLITE_OK))
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	error = sqlite3_step(sqlite3_stmt);
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	_close_db();
 
-	if (error == SQLITE_DONE || error == SQLITE_ROW)
-		return EINA_TRUE;
-	else
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
 		return EINA_FALSE;
+	}
+
+	return _step_statement(db_connection, is_archive ? "delete from history_archive where id=? and visitdate is null"
+								: "delete from history where id=? and visitdate is null", &url_id);
 }
 
-Eina_Bool Browser_History_DB::get_history_list(vector<history_item*> &list)
+struct Browser_History_DB::search_match_compare {
+	search_match_compare(const std::vector<search_entry> &entries) : m_entries(entries) {}
+	bool operator()(const search_match &a, const search_match &b) const
+	{
+		if (a.rank != b.rank)
+			return a.rank > b.rank;
+		if (m_entries[a.index].counter != m_entries[b.index].counter)
+			return m_entries[a.index].counter > m_entries[b.index].counter;
+		return m_entries[a.index].id > m_entries[b.index].id;
+	}
+	const std::vector<search_entry> &m_entries;
+};
+
+Eina_Bool Browser_History_DB::_load_search_entries(void)
 {
+	/* Every write through the shared connection, from any *_DB class, changes total_changes. */
+	int changes = sqlite3_total_changes(m_db_connection->get_descriptor());
+	if (m_search_entries_descriptor == m_db_connection->get_descriptor() && m_search_entries_changes == changes
+	    && m_search_entries_generation == m_history_generation)
+		return EINA_TRUE;
+
 	BROWSER_LOGD("[%s]", __func__);
-	if (_open_db() == EINA_FALSE)
-		return EINA_FALSE;
+	m_search_entries.clear();
+	m_search_matches.clear();
+	m_search_keyword.clear();
+	m_search_entries_descriptor = NULL;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id, address, title, visitdate from history order by visitdate desc",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select id, address, title, strftime('%s', visitdate), counter from history order by visitdate desc",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
-	history_item *item;
-	while(1) {
-		error = sqlite3_step(sqlite3_stmt);
-		if (error == SQLITE_ROW) {
-			item = new(nothrow) history_item;
-			if (!item) {
-				BROWSER_LOGD("new history_item is failed");
-				return EINA_FALSE;
-			}
-			const char* id = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0));
-			if (id && strlen(id))
-				item->id = atoi(id);
-			else
-				item->id = 0;
-
-			const char* url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
-			if (url && strlen(url))
-				item->url = url;
-			else
-				item->url = "";
-			
-			const char* title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
-			if (title && strlen(title))
-				item->title = title;
-			else
-				item->title = "";
-
-			const char* date = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 3));
-			if (date && strlen(date))
-				item->date = date;
-			else
-				item->date = "";
-
-			item->user_data = NULL;
-			item->is_delete = EINA_FALSE;
+	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
+		search_entry entry;
+		entry.id = sqlite3_column_int(sqlite3_stmt, 0);
 
-			list.push_back(item);
-		} else
-			break;
+		const char *url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
+		entry.url = url ? url : "";
+
+		const char *title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
+		entry.title = title ? title : "";
+
+		entry.visit_time = (time_t)sqlite3_column_int64(sqlite3_stmt, 3);
+
+		entry.counter = sqlite3_column_int(sqlite3_stmt, 4);
+		entry.folded_url = br_search_text_fold(entry.url.c_str());
+		entry.folded_title = br_search_text_fold(entry.title.c_str());
+
+		m_search_entries.push_back(entry);
 	}
 
-	BROWSER_LOGD("SQL error: %d", error);\
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-	_close_db();
-	if (error == SQLITE_DONE || error == SQLITE_ROW)
-		return EINA_TRUE;
-	else
+
+	if (error != SQLITE_DONE) {
+		BROWSER_LOGD("SQL error=%d", error);
+		m_search_entries.clear();
 		return EINA_FALSE;
+	}
+
+	m_search_entries_descriptor = m_db_connection->get_descriptor();
+	m_search_entries_changes = changes;
+	m_search_entries_generation = m_history_generation;
+
+	return EINA_TRUE;
 }
 
-Eina_Bool Browser_History_DB::clear_history(void)
+Eina_Bool Browser_History_DB::search_history(const char *keyword, int limit, std::vector<history_item *> &list)
 {
-	BROWSER_LOGD("[%s]", __func__);
+	BROWSER_LOGD("[%s] keyword=[%s]", __func__, keyword);
+	if (!keyword || strlen(keyword) == 0 || limit <= 0)
+		return EINA_TRUE;
+
+	/* Only filled in private mode, the matches of the private session come first. */
+	if (!m_private_history.is_empty()) {
+		std::vector<const Browser_Private_History::entry *> entries;
+		m_private_history.search(keyword, limit, entries);
+		if (!_add_private_items(entries, list))
+			return EINA_FALSE;
+
+		limit -= entries.size();
+		if (limit <= 0)
+			return EINA_TRUE;
+	}
+
+	if (!flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "delete from history", -1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-			BROWSER_LOGE("sqlite3_finalize is failed.\n");
+	if (!_load_search_entries())
+		return EINA_FALSE;
+
+	std::string folded_keyword = br_search_text_fold(keyword);
+
+	/* Typing one more character can only remove matches. */
+	std::vector<int> candidates;
+	Eina_Bool is_narrowing = !m_search_keyword.empty()
+				&& !folded_keyword.compare(0, m_search_keyword.length(), m_search_keyword);
+	if (is_narrowing)
+		candidates.swap(m_search_matches);
+
+	std::vector<search_match> matches;
+	int count = is_narrowing ? candidates.size() : m_search_entries.size();
+	for (int i = 0 ; i < count ; i++) {
+		int index = is_narrowing ? candidates[i] : i;
+		int rank = br_search_text_rank(folded_keyword, m_search_entries[index].folded_title,
+							m_search_entries[index].folded_url);
+		if (rank > 0) {
+			search_match match;
+			match.index = index;
+			match.rank = rank;
+			matches.push_back(match);
+		}
 	}
 
-	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-	_close_db();
-	if (error == SQLITE_DONE || error == SQLITE_ROW)
-		return EINA_TRUE;
-	else
-		return EINA_FALSE;
+	m_search_keyword = folded_keyword;
+	m_search_matches.clear();
+	for (int i = 0 ; i < matches.size() ; i++)
+		m_search_matches.push_back(matches[i].index);
+
+	int result_count = matches.size() < limit ? matches.size() : limit;
+	std::partial_sort(matches.begin(), matches.begin() + result_count, matches.end(),
+				search_match_compare(m_search_entries));
+
+	for (int i = 0 ; i < result_count ; i++) {
+		const search_entry &entry = m_search_entries[matches[i].index];
+		history_item *item = new(nothrow) history_item;
+		if (!item) {
+			BROWSER_LOGE("new history_item is failed");
+			return EINA_FALSE;
+		}
+		item->id = entry.id;
+		item->url = entry.url;
+		item->title = entry.title;
+		item->visit_time = entry.visit_time;
+		item->is_delete = EINA_FALSE;
+		item->user_data = NULL;
+
+		list.push_back(item);
+	}
+
+	if (result_count < limit)
+		return _search_archive(keyword, limit - result_count, list);
+
+	return EINA_TRUE;
 }
 
-Eina_Bool Browser_History_DB::is_in_bookmark(const char* url, int *bookmark_id)
+Eina_Bool Browser_History_DB::_search_archive(const char *keyword, int limit, std::vector<history_item *> &list)
 {
-	int error = db_util_open(BROWSER_BOOKMARK_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
-		return EINA_FALSE;
+	std::string pattern = "%";
+	for (const char *c = keyword ; *c ; c++) {
+		if (*c == '%' || *c == '_' || *c == '\\')
+			pattern += '\\';
+		pattern += *c;
 	}
+	pattern += "%";
 
+	/* A scan of the archive, only done when the history table has too few matches. */
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "select id from bookmarks where address=?",
-									-1, &sqlite3_stmt, NULL);
+	/* The hosts are matched once, not concatenated to every path.
+	  * "+frecency" makes it one pass over the table and a sort of the matches instead of a walk of the
+	  * frecency index, which reads the rows in random order and is slowest when there are few matches. */
+	int error = m_db_connection->prepare_statement("select a.id, h.host || a.path, a.title, strftime('%s', a.visitdate) from ("
+							"select id, host_id, path, title, visitdate from history_archive"
+							" where title like ?1 escape '\\' or path like ?1 escape '\\'"
+							" or host_id in (select id from history_hosts where host like ?1 escape '\\')"
+							" order by +frecency desc limit ?2) a"
+						" join history_hosts h on h.id=a.host_id", &sqlite3_stmt);
 	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+		BROWSER_LOGD("SQL error=%d", error);
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
+			BROWSER_LOGE("sqlite3_finalize is failed.\n");
 		return EINA_FALSE;
 	}
 
-	if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
-
-	error = sqlite3_step(sqlite3_stmt);
-
-	if (bookmark_id)
-		*bookmark_id = sqlite3_column_int(sqlite3_stmt, 0);
+	if (sqlite3_bind_text(sqlite3_stmt, 1, pattern.c_str(), -1, NULL) != SQLITE_OK
+	    || sqlite3_bind_int(sqlite3_stmt, 2, limit) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind is failed.\n");
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	Eina_Bool ret = _step_history_items(sqlite3_stmt, list);
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	db_util_close(m_db_descriptor);
+	return ret;
+}
 
-	return (error == SQLITE_ROW);
+Eina_Bool Browser_History_DB::is_in_bookmark(const char* url, int *bookmark_id)
+{
+	return Browser_Bookmark_DB::is_in_bookmark(url, bookmark_id);
 }
 
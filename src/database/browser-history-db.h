@@ -20,47 +20,234 @@
 #define BROWSER_HISTORY_DB_H
 
 #include "browser-config.h"
+#include "browser-db-connection.h"
+#include "browser-db-executor.h"
+#include "browser-favicon.h"
+#include "browser-private-history.h"
+#include "browser-url-prefix-index.h"
 
 extern "C" {
 #include "db-util.h"
 }
 
 #include <iostream>
+#include <map>
 #include <string>
+#include <time.h>
 #include <vector>
 
+/* How the user got to the address, recorded per visit in history_visits. */
+typedef enum _browser_history_transition {
+	BROWSER_HISTORY_TRANSITION_LINK	= 0,
+	BROWSER_HISTORY_TRANSITION_TYPED
+} browser_history_transition;
+
+/* The history table keeps the BROWSER_HISTORY_COUNT_LIMIT most recently added addresses.
+  * Older ones are moved to history_archive, one row per address with its host in history_hosts,
+  * until they are older than BROWSER_HISTORY_ARCHIVE_MAX_AGE_DAYS or beyond BROWSER_HISTORY_ARCHIVE_COUNT_LIMIT
+  * (see Browser_DB_Maintenance). An archived item keeps its id and comes back to the history table on a visit.
+  * Every visit is also logged in history_visits by the id of its address, and counted per local day
+  * and address in history_daily_visits by the triggers of the table. The history pages are read from it.
+  * In private mode the visits go to a Browser_Private_History in memory instead. The reads merge its
+  * entries, whose ids are negative, with the stored ones, and the deletes of urls and times apply to both. */
 class Browser_History_DB {
 public:
 	struct history_item {
 		int id;
 		std::string url;
 		std::string title;
-		std::string date;
+		time_t visit_time;
 		Eina_Bool is_delete;
 
 		void *user_data;
 	};
+	/* The items list[first_index] to list[first_index + count - 1], visited on the same local day. */
+	struct history_day_group {
+		time_t day;	/* local midnight */
+		int first_index;
+		int count;
+	};
 	struct most_visited_item {
+		int id;
 		std::string url;
 		std::string title;
 	};
 
+	/* The items of list belong to the callback. */
+	typedef void (*history_page_cb)(Eina_Bool result, std::vector<history_item *> &list,
+					std::vector<history_day_group> &groups, void *user_data);
+	typedef void (*visits_flushed_cb)(void *user_data);
+
 	Browser_History_DB();
 	~Browser_History_DB();
 
-	Eina_Bool get_history_list(std::vector<history_item*> &list);
+	/* The history table only, the archive is reached by get_history_page().
+	  * The items are grouped by day in groups if it is given. */
+	Eina_Bool get_history_list(std::vector<history_item*> &list, std::vector<history_day_group> *groups = NULL);
+	/* At most limit items, newest first, visited before the given item.
+	  * An item is an address and a day it was visited on, with the last visit of that day,
+	  * so the same id is listed once per day. The archived addresses are listed with the others.
+	  * 0 before_visit_time returns the first page. Pass the visit_time and id of
+	  * the last item of the previous page to get the next one.
+	  * The groups of a page may continue the last group of the previous page. */
+	Eina_Bool get_history_page(time_t before_visit_time, int before_id, int limit,
+					std::vector<history_item *> &list, std::vector<history_day_group> *groups = NULL);
+	/* The same page, read on the executor after the pending visits.
+	  * Returns the job id for Browser_DB_Executor::cancel(), or 0 on failure. */
+	int get_history_page_async(time_t before_visit_time, int before_id, int limit,
+					history_page_cb callback, void *user_data,
+					int priority = BROWSER_DB_JOB_PRIORITY_NORMAL);
+	/* The count most visited addresses starting with url, the scheme and "www." are ignored. */
 	Eina_Bool get_history_list_by_partial_url(const char *url, int count, std::vector<std::string> &list);
 	Eina_Bool get_most_visited_list(std::vector<most_visited_item> &list);
-	Eina_Bool save_history(const char *url, const char *title, Eina_Bool *is_full);
+	/* A typed or bookmarked address gets a higher frecency for the visit. */
+	Eina_Bool save_history(const char *url, const char *title, Eina_Bool *is_full,
+				Eina_Bool is_typed = EINA_FALSE, Eina_Bool is_bookmarked = EINA_FALSE);
+	/* Queued with the visits, the icon is stored once for the host of url. */
+	Eina_Bool save_favicon(const char *url, const Browser_Favicon &favicon);
+	/* The icons of the given items in one read, the archived and the private items have none. */
+	Eina_Bool get_favicons(const std::vector<int> &history_ids, std::map<int, Browser_Favicon> &favicons);
 	Eina_Bool delete_history(int history_id);
 	Eina_Bool delete_history(const char *url);
+	Eina_Bool delete_history(const std::vector<int> &history_ids);
 	Eina_Bool clear_history(void);
+	/* Removes the visits made from from until before to, in seconds since the epoch.
+	  * An address without any visit left is deleted, the others lose the removed visits
+	  * from their counter, date and frecency. */
+	Eina_Bool delete_history_by_time(time_t from, time_t to);
 	Eina_Bool is_in_bookmark(const char* url, int *bookmark_id);
+	/* Ranked, case and accent insensitive search on title and url, at most limit items.
+	  * When keyword extends the previous keyword, only the previous matches are scanned.
+	  * If the history table has less than limit matches, the archive is searched for the rest
+	  * with LIKE, which is only case insensitive for ASCII. */
+	Eina_Bool search_history(const char *keyword, int limit, std::vector<history_item *> &list);
+
+	/* save_history() only queues the visit in memory.
+	  * The queue is written in one transaction on the DB executor thread on a timer,
+	  * and synchronously when the browser is paused and at exit.
+	  * Every read of the history table flushes it first. */
+	static Eina_Bool flush_visits(void);
+	/* Writes the queue on the executor and calls callback, if given, on the main loop after it,
+	  * so that the reads made from callback do not wait for the write.
+	  * Returns the id of the job to wait for, or 0 on failure or if there is none. */
+	static int flush_visits_async(visits_flushed_cb callback = NULL, void *user_data = NULL);
+	/* Drops the in-memory indexes if another process wrote to the history file. */
+	static void check_external_change(void);
+	/* Turning private mode on or off drops the private history. */
+	static void set_private_mode(Eina_Bool is_private);
 private:
-	Eina_Bool _open_db(void);
-	Eina_Bool _close_db(void);
-	
-	static sqlite3* m_db_descriptor;
+	struct visit_event {
+		time_t time;
+		int transition;
+		double frecency_weight;
+	};
+	struct pending_visit {
+		std::string url;
+		sqlite3_int64 url_key;
+		std::string title;
+		int visit_count;
+		double frecency_weight;
+		std::vector<visit_event> events;
+	};
+	struct pending_favicon {
+		std::string host;
+		Browser_Favicon favicon;
+	};
+	struct archived_item {
+		int id;
+		int counter;
+		double frecency;
+	};
+	struct search_entry {
+		int id;
+		std::string url;
+		std::string title;
+		time_t visit_time;
+		int counter;
+		std::string folded_url;
+		std::string folded_title;
+	};
+	struct search_match {
+		int index;
+		int rank;
+	};
+	struct search_match_compare;
+	class flush_visits_job;
+	class history_page_job;
+	class visits_flushed_job;
+
+	Eina_Bool _open_db(const char *db_path = BROWSER_HISTORY_DB_PATH);
+	static int _get_history_count(Browser_DB_Connection *db_connection);
+	static Eina_Bool _step_statement(Browser_DB_Connection *db_connection, const char *query, const int *value);
+	/* host is the scheme and authority, path the rest of the url. */
+	static void _split_url(const char *url, std::string &host, std::string &path);
+	static int _get_host_id(Browser_DB_Connection *db_connection, const std::string &host);
+	static Eina_Bool _write_visit_events(Browser_DB_Connection *db_connection, int url_id,
+					const std::vector<visit_event> &events);
+	static Eina_Bool _remove_visit_events(Browser_DB_Connection *db_connection, Eina_Bool is_archive, int url_id,
+					const std::vector<visit_event> &events);
+	static Eina_Bool _archive_oldest_items(Browser_DB_Connection *db_connection, int count);
+	/* Removes the newest archived row with url_key, see br_url_key(), is_found tells whether item was filled. */
+	static Eina_Bool _take_archived_item(Browser_DB_Connection *db_connection, sqlite3_int64 url_key,
+					archived_item *item, Eina_Bool *is_found);
+	/* The history and archived rows of the page of url_key and their visits, in the caller's transaction. */
+	static Eina_Bool _delete_url_key(Browser_DB_Connection *db_connection, sqlite3_int64 url_key);
+	/* Fills the keys of the rows inserted by other processes, which do not know br_url_key(),
+	  * and logs a visit at their visitdate for the ones which have none. */
+	static Eina_Bool _adopt_external_rows(Browser_DB_Connection *db_connection);
+	static Eina_Bool _write_visit(Browser_DB_Connection *db_connection, const pending_visit &visit,
+					Eina_Bool *is_evicted);
+	/* The visits and the favicons in one transaction. */
+	static Eina_Bool _write_visits(Browser_DB_Connection *db_connection, const std::vector<pending_visit> &visits,
+					const std::vector<pending_favicon> &favicons, Eina_Bool *is_evicted);
+	static Eina_Bool _flush_visits_async(void);
+	static void _finish_flush_job(Eina_Bool is_discarded);
+	static Eina_Bool _read_history_list(Browser_DB_Connection *db_connection, std::vector<history_item *> &list,
+					std::vector<history_day_group> *groups);
+	static Eina_Bool _read_history_page(Browser_DB_Connection *db_connection, time_t before_visit_time,
+					int before_id, int limit, std::vector<history_item *> &list,
+					std::vector<history_day_group> *groups);
+	/* The columns are id, url, title, visit time and, if groups is given, the local midnight of the visit. */
+	static Eina_Bool _step_history_items(sqlite3_stmt *sqlite3_stmt, std::vector<history_item *> &list,
+					std::vector<history_day_group> *groups = NULL);
+	/* Counts the last item of list in the last group if it is of the same day, or starts a new group. */
+	static void _add_to_day_groups(std::vector<history_day_group> *groups, time_t day, int index);
+	static Eina_Bool _add_private_items(const std::vector<const Browser_Private_History::entry *> &entries,
+					std::vector<history_item *> &list, std::vector<history_day_group> *groups = NULL);
+	/* Appends to list the items of page and of the private entries, both sorted as get_history_page(),
+	  * in that order and at most limit of them. The items of page are given to list or deleted. */
+	static Eina_Bool _merge_private_items(std::vector<history_item *> &page, const std::vector<history_day_group> &page_groups,
+					const std::vector<const Browser_Private_History::entry *> &entries, int limit,
+					std::vector<history_item *> &list, std::vector<history_day_group> *groups);
+
+	Eina_Bool _load_search_entries(void);
+	Eina_Bool _search_archive(const char *keyword, int limit, std::vector<history_item *> &list);
+	Eina_Bool _load_url_prefix_index(void);
+
+	static Eina_Bool __flush_visits_timer_cb(void *data);
+
+	Browser_DB_Connection *m_db_connection;
+
+	/* In memory copy of the history table for search_history(), loaded on demand. */
+	std::vector<search_entry> m_search_entries;
+	sqlite3 *m_search_entries_descriptor;
+	int m_search_entries_changes;
+	int m_search_entries_generation;
+	std::string m_search_keyword;
+	std::vector<int> m_search_matches;
+
+	static std::vector<pending_visit> m_pending_visits;
+	/* One per host, the last icon received. */
+	static std::vector<pending_favicon> m_pending_favicons;
+	static Ecore_Timer *m_flush_visits_timer;
+	/* The last flush posted to the executor, 0 once it is done. */
+	static int m_flush_job_id;
+	/* Counts the flushes done on the executor, whose writes the main connection does not see. */
+	static int m_history_generation;
+	/* Kept up to date by save_history(), dropped and reloaded on demand after deletes. */
+	static Browser_Url_Prefix_Index m_url_prefix_index;
+	static Eina_Bool m_is_private;
+	static Browser_Private_History m_private_history;
 };
 
 #endif	/* BROWSER_HISTORY_DB_H */
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-private-history.h"
+#include "browser-frecency.h"
+#include "browser-search-text.h"
+
+#include <algorithm>
+
+struct Browser_Private_History::visit_time_compare {
+	bool operator()(const entry *a, const entry *b) const
+	{
+		if (a->visit_times.back() != b->visit_times.back())
+			return a->visit_times.back() > b->visit_times.back();
+		return a->id > b->id;
+	}
+};
+
+struct Browser_Private_History::frecency_compare {
+	bool operator()(const entry *a, const entry *b) const
+	{
+		return a->frecency > b->frecency;
+	}
+};
+
+struct Browser_Private_History::search_match_compare {
+	bool operator()(const std::pair<int, const entry *> &a, const std::pair<int, const entry *> &b) const
+	{
+		if (a.first != b.first)
+			return a.first > b.first;
+		if (a.second->visit_times.size() != b.second->visit_times.size())
+			return a.second->visit_times.size() > b.second->visit_times.size();
+		return visit_time_compare()(a.second, b.second);
+	}
+};
+
+Browser_Private_History::Browser_Private_History(void)
+:
+	m_last_id(0)
+{
+	std::vector<Browser_Url_Prefix_Index::url_entry> no_entries;
+	m_url_prefix_index.set_entries(no_entries);
+}
+
+Browser_Private_History::~Browser_Private_History(void)
+{
+}
+
+void Browser_Private_History::add_visit(const char *url, const char *title, double frecency_weight)
+{
+	if (!url || !title)
+		return;
+
+	time_t now = time(NULL);
+	m_url_prefix_index.add_visit(url, frecency_weight);
+
+	sqlite3_int64 url_key = br_url_key(url);
+	std::map<sqlite3_int64, int>::iterator id_iter = m_ids_by_key.find(url_key);
+	if (id_iter != m_ids_by_key.end()) {
+		entry &visited = m_entries[id_iter->second];
+		visited.title = std::string(title);
+		visited.folded_title = br_search_text_fold(title);
+		visited.visit_times.push_back(now);
+		visited.frecency = br_frecency_add(visited.frecency, frecency_weight, br_frecency_now());
+		return;
+	}
+
+	entry &added = m_entries[--m_last_id];
+	added.id = m_last_id;
+	added.url = std::string(url);
+	added.url_key = url_key;
+	added.title = std::string(title);
+	added.visit_times.push_back(now);
+	added.frecency = br_frecency_add(BROWSER_FRECENCY_NONE, frecency_weight, br_frecency_now());
+	added.folded_url = br_search_text_fold(url);
+	added.folded_title = br_search_text_fold(title);
+	m_ids_by_key[url_key] = added.id;
+}
+
+void Browser_Private_History::get_page(time_t before_visit_time, int before_id, int limit,
+					std::vector<const entry *> &page)
+{
+	std::vector<const entry *> entries;
+	for (std::map<int, entry>::iterator iter = m_entries.begin() ; iter != m_entries.end() ; iter++) {
+		time_t visit_time = iter->second.visit_times.back();
+		if (!before_visit_time || visit_time < before_visit_time
+		    || (visit_time == before_visit_time && iter->second.id < before_id))
+			entries.push_back(&iter->second);
+	}
+
+	int count = entries.size() < limit ? entries.size() : limit;
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), visit_time_compare());
+	page.insert(page.end(), entries.begin(), entries.begin() + count);
+}
+
+void Browser_Private_History::get_most_visited(int count, std::vector<const entry *> &list)
+{
+	std::vector<const entry *> entries;
+	for (std::map<int, entry>::iterator iter = m_entries.begin() ; iter != m_entries.end() ; iter++)
+		entries.push_back(&iter->second);
+
+	if (count > entries.size())
+		count = entries.size();
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), frecency_compare());
+	list.insert(list.end(), entries.begin(), entries.begin() + count);
+}
+
+void Browser_Private_History::get_matches(const char *prefix, int count, std::vector<std::string> &list)
+{
+	m_url_prefix_index.get_matches(prefix, count, list);
+}
+
+void Browser_Private_History::search(const char *keyword, int limit, std::vector<const entry *> &list)
+{
+	if (!keyword || limit <= 0)
+		return;
+
+	std::string folded_keyword = br_search_text_fold(keyword);
+	std::vector<std::pair<int, const entry *> > matches;
+	for (std::map<int, entry>::iterator iter = m_entries.begin() ; iter != m_entries.end() ; iter++) {
+		int rank = br_search_text_rank(folded_keyword, iter->second.folded_title, iter->second.folded_url);
+		if (rank > 0)
+			matches.push_back(std::make_pair(rank, &iter->second));
+	}
+
+	int count = matches.size() < limit ? matches.size() : limit;
+	std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), search_match_compare());
+	for (int i = 0 ; i < count ; i++)
+		list.push_back(matches[i].second);
+}
+
+void Browser_Private_History::remove(int id)
+{
+	std::map<int, entry>::iterator iter = m_entries.find(id);
+	if (iter == m_entries.end())
+		return;
+
+	_erase(iter);
+	_rebuild_url_prefix_index();
+}
+
+void Browser_Private_History::remove(const char *url)
+{
+	if (!url)
+		return;
+
+	std::map<sqlite3_int64, int>::iterator id_iter = m_ids_by_key.find(br_url_key(url));
+	if (id_iter != m_ids_by_key.end())
+		remove(id_iter->second);
+}
+
+void Browser_Private_History::remove_visits(time_t from, time_t to)
+{
+	std::map<int, entry>::iterator iter = m_entries.begin();
+	while (iter != m_entries.end()) {
+		std::vector<time_t> &visit_times = iter->second.visit_times;
+		std::vector<time_t> kept;
+		for (int i = 0 ; i < visit_times.size() ; i++) {
+			if (visit_times[i] < from || visit_times[i] >= to)
+				kept.push_back(visit_times[i]);
+		}
+
+		if (kept.empty()) {
+			_erase(iter++);
+			continue;
+		}
+
+		/* The frecency of the removed visits is not known any more, it is counted again from the rest. */
+		if (kept.size() != visit_times.size()) {
+			visit_times.swap(kept);
+			iter->second.frecency = br_frecency_add(BROWSER_FRECENCY_NONE, visit_times.size(), br_frecency_now());
+		}
+		iter++;
+	}
+
+	_rebuild_url_prefix_index();
+}
+
+void Browser_Private_History::clear(void)
+{
+	m_entries.clear();
+	m_ids_by_key.clear();
+	std::vector<Browser_Url_Prefix_Index::url_entry> no_entries;
+	m_url_prefix_index.set_entries(no_entries);
+}
+
+void Browser_Private_History::_erase(std::map<int, entry>::iterator iter)
+{
+	m_ids_by_key.erase(iter->second.url_key);
+	m_entries.erase(iter);
+}
+
+void Browser_Private_History::_rebuild_url_prefix_index(void)
+{
+	std::vector<Browser_Url_Prefix_Index::url_entry> url_entries;
+	for (std::map<int, entry>::iterator iter = m_entries.begin() ; iter != m_entries.end() ; iter++) {
+		Browser_Url_Prefix_Index::url_entry url_entry;
+		url_entry.key = Browser_Url_Prefix_Index::get_key(iter->second.url.c_str());
+		url_entry.url = iter->second.url;
+		url_entry.frecency = iter->second.frecency;
+		url_entries.push_back(url_entry);
+	}
+	m_url_prefix_index.set_entries(url_entries);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_PRIVATE_HISTORY_H
+#define BROWSER_PRIVATE_HISTORY_H
+
+#include "browser-config.h"
+#include "browser-url-key.h"
+#include "browser-url-prefix-index.h"
+
+#include <map>
+#include <string>
+#include <time.h>
+#include <vector>
+
+/* The history of private browsing, kept in memory only so that nothing of it reaches the flash.
+  * While private browsing is on, Browser_History_DB records the visits here and answers its reads from here.
+  * The ids are negative, so that they never meet the ones of the history table. */
+class Browser_Private_History {
+public:
+	struct entry {
+		int id;
+		std::string url;
+		sqlite3_int64 url_key;
+		std::string title;
+		/* Oldest first, never empty. */
+		std::vector<time_t> visit_times;
+		double frecency;
+		std::string folded_url;
+		std::string folded_title;
+	};
+
+	Browser_Private_History(void);
+	~Browser_Private_History(void);
+
+	void add_visit(const char *url, const char *title, double frecency_weight);
+	/* At most limit entries, newest first, visited before the given entry as in get_history_page().
+	  * 0 before_visit_time returns the first page. */
+	void get_page(time_t before_visit_time, int before_id, int limit, std::vector<const entry *> &page);
+	/* The count entries of the highest frecency. */
+	void get_most_visited(int count, std::vector<const entry *> &list);
+	void get_matches(const char *prefix, int count, std::vector<std::string> &list);
+	/* Ranked as search_history(), at most limit entries. */
+	void search(const char *keyword, int limit, std::vector<const entry *> &list);
+	void remove(int id);
+	void remove(const char *url);
+	/* Removes the visits made from from until before to, and the entries without any visit left. */
+	void remove_visits(time_t from, time_t to);
+	void clear(void);
+	Eina_Bool is_empty(void) { return m_entries.empty(); }
+private:
+	struct visit_time_compare;
+	struct frecency_compare;
+	struct search_match_compare;
+
+	void _erase(std::map<int, entry>::iterator iter);
+	void _rebuild_url_prefix_index(void);
+
+	std::map<int, entry> m_entries;
+	/* By br_url_key(), the addresses of one page share their entry. */
+	std::map<sqlite3_int64, int> m_ids_by_key;
+	int m_last_id;
+	Browser_Url_Prefix_Index m_url_prefix_index;
+};
+
+#endif	/* BROWSER_PRIVATE_HISTORY_H */
+
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+using namespace std;
+
+#include "browser-search-text.h"
+
+/* Base letters of U+00C0 ~ U+00FF, '*' keeps the character as it is. */
+static const char *latin_1_base = "aaaaaaaceeeeiiiidnooooo*ouuuuy*s"
+				"aaaaaaaceeeeiiiidnooooo*ouuuuy*y";
+/* Base letters of U+0100 ~ U+017F (Latin Extended-A). */
+static const char *latin_extended_a_base = "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiiiii"
+				"jjkkkllllllllllnnnnnnnnnoooooooorrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+
+std::string br_search_text_fold(const char *text)
+{
+	std::string folded;
+	if (!text)
+		return folded;
+
+	const unsigned char *p = (const unsigned char *)text;
+	folded.reserve(strlen(text));
+	while (*p) {
+		if (*p < 0x80) {
+			folded += (char)tolower(*p);
+			p++;
+			continue;
+		}
+
+		/* Only the two byte sequences of U+00C0 ~ U+017F are folded. */
+		if ((p[0] == 0xC3 || p[0] == 0xC4 || p[0] == 0xC5) && (p[1] & 0xC0) == 0x80) {
+			unsigned int code = ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+			char base = '*';
+			if (code >= 0xC0 && code < 0x100)
+				base = latin_1_base[code - 0xC0];
+			else if (code >= 0x100 && code < 0x180)
+				base = latin_extended_a_base[code - 0x100];
+
+			if (base != '*') {
+				folded += base;
+				p += 2;
+				continue;
+			}
+		}
+
+		folded += (char)*p;
+		p++;
+	}
+
+	return folded;
+}
+
+static Eina_Bool _is_word_start(const std::string &text, size_t pos)
+{
+	if (pos == 0)
+		return EINA_TRUE;
+
+	return !isalnum((unsigned char)text[pos - 1]) && !((unsigned char)text[pos - 1] & 0x80);
+}
+
+int br_search_text_rank(const std::string &keyword, const std::string &title, const std::string &url)
+{
+	if (keyword.empty())
+		return 0;
+
+	int rank = 0;
+
+	size_t pos = title.find(keyword);
+	if (pos == 0)
+		rank = 4;
+	else if (pos != std::string::npos)
+		rank = _is_word_start(title, pos) ? 3 : 1;
+
+	if (rank >= 3)
+		return rank;
+
+	/* Skip the scheme and "www." so that typing the host name ranks as a prefix match. */
+	size_t host = url.find("://");
+	host = (host == std::string::npos) ? 0 : host + strlen("://");
+	if (!url.compare(host, strlen("www."), "www."))
+		host += strlen("www.");
+
+	pos = url.find(keyword);
+	if (pos == host)
+		return 3;
+	else if (pos != std::string::npos) {
+		if (_is_word_start(url, pos))
+			return rank > 2 ? rank : 2;
+		return rank > 1 ? rank : 1;
+	}
+
+	return rank;
+}
+
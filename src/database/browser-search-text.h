@@ -0,0 +1,36 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_SEARCH_TEXT_H
+#define BROWSER_SEARCH_TEXT_H
+
+#include "browser-config.h"
+
+#include <string>
+
+/* Returns the UTF-8 text lower cased and with the accents of latin letters removed,
+  * e.g. "Crème Brûlée" -> "creme brulee", so that searches match regardless of both.
+  * Other characters are copied as they are. */
+std::string br_search_text_fold(const char *text);
+
+/* Ranks a folded keyword against a folded title and url. 0 means no match,
+  * a match at the beginning of the title or of the host ranks higher than one in the middle. */
+int br_search_text_rank(const std::string &keyword, const std::string &title, const std::string &url);
+
+#endif	/* BROWSER_SEARCH_TEXT_H */
+
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-url-key.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#define BROWSER_URL_KEY_FNV_OFFSET_BASIS	14695981039346656037ULL
+#define BROWSER_URL_KEY_FNV_PRIME	1099511628211ULL
+
+/* The canonical form is written and hashed one character at a time,
+  * so that the key does not need a copy of the address. */
+struct url_writer {
+	char *buffer;
+	size_t buffer_size;
+	size_t length;
+	unsigned long long hash;
+};
+
+static void _put(url_writer *writer, char c)
+{
+	if (writer->length + 1 < writer->buffer_size)
+		writer->buffer[writer->length] = c;
+	writer->length++;
+
+	writer->hash ^= (unsigned char)c;
+	writer->hash *= BROWSER_URL_KEY_FNV_PRIME;
+}
+
+static void _put_lower(url_writer *writer, const char *begin, const char *end)
+{
+	for (const char *c = begin ; c < end ; c++)
+		_put(writer, tolower((unsigned char)*c));
+}
+
+/* Copies a path or a query, "%2f" and "%2F" are the same escape. */
+static void _put_escaped(url_writer *writer, const char *begin, const char *end)
+{
+	for (const char *c = begin ; c < end ; c++) {
+		if (*c == '%' && c + 2 < end
+		    && isxdigit((unsigned char)c[1]) && isxdigit((unsigned char)c[2])) {
+			_put(writer, '%');
+			_put(writer, toupper((unsigned char)c[1]));
+			_put(writer, toupper((unsigned char)c[2]));
+			c += 2;
+		} else
+			_put(writer, *c);
+	}
+}
+
+static Eina_Bool _is_equal_nocase(const char *begin, const char *end, const char *text)
+{
+	size_t length = strlen(text);
+	return ((size_t)(end - begin) == length && !strncasecmp(begin, text, length));
+}
+
+static const char *_find_first_of(const char *begin, const char *end, const char *characters)
+{
+	for (const char *c = begin ; c < end ; c++) {
+		if (strchr(characters, *c))
+			return c;
+	}
+
+	return end;
+}
+
+static void _canonicalize(const char *url, url_writer *writer)
+{
+	const char *begin = url;
+	while (*begin && isspace((unsigned char)*begin))
+		begin++;
+	const char *end = begin + strlen(begin);
+	while (end > begin && isspace((unsigned char)end[-1]))
+		end--;
+
+	/* "localhost:8080/" has no scheme, a scheme is never followed by a port. */
+	const char *scheme_end = NULL;
+	if (begin < end && isalpha((unsigned char)*begin)) {
+		const char *c = begin + 1;
+		while (c < end && (isalnum((unsigned char)*c) || *c == '+' || *c == '-' || *c == '.'))
+			c++;
+		if (c < end && *c == ':' && !(c + 1 < end && isdigit((unsigned char)c[1])))
+			scheme_end = c;
+	}
+
+	const char *default_port = "80";
+	const char *authority = begin;
+	if (scheme_end) {
+		if (end - scheme_end < 3 || strncmp(scheme_end, "://", 3)) {
+			/* about:, data:, javascript: and the like are compared as they are. */
+			_put_lower(writer, begin, scheme_end);
+			for (const char *c = scheme_end ; c < end ; c++)
+				_put(writer, *c);
+			return;
+		}
+
+		if (_is_equal_nocase(begin, scheme_end, "https"))
+			default_port = "443";
+		else if (!_is_equal_nocase(begin, scheme_end, "http")) {
+			default_port = _is_equal_nocase(begin, scheme_end, "ftp") ? "21" : NULL;
+			_put_lower(writer, begin, scheme_end);
+			_put(writer, ':');
+			_put(writer, '/');
+			_put(writer, '/');
+		}
+		authority = scheme_end + 3;
+	}
+
+	const char *authority_end = _find_first_of(authority, end, "/?#");
+
+	const char *host = authority;
+	for (const char *c = authority ; c < authority_end ; c++) {
+		if (*c == '@')
+			host = c + 1;
+	}
+	for (const char *c = authority ; c < host ; c++)
+		_put(writer, *c);
+
+	/* The last colon which is not inside an IPv6 address starts the port. */
+	const char *host_end = authority_end;
+	for (const char *c = authority_end - 1 ; c >= host && *c != ']' ; c--) {
+		if (*c == ':') {
+			host_end = c;
+			break;
+		}
+	}
+
+	const char *port = host_end < authority_end ? host_end + 1 : authority_end;
+	if (host_end > host && host_end[-1] == '.')
+		host_end--;
+	_put_lower(writer, host, host_end);
+
+	if (port < authority_end && !(default_port && _is_equal_nocase(port, authority_end, default_port))) {
+		_put(writer, ':');
+		for (const char *c = port ; c < authority_end ; c++)
+			_put(writer, *c);
+	}
+
+	const char *path_end = _find_first_of(authority_end, end, "?#");
+	const char *path_last = path_end;
+	if (path_last > authority_end && path_last[-1] == '/')
+		path_last--;
+	_put_escaped(writer, authority_end, path_last);
+
+	if (path_end < end && *path_end == '?') {
+		const char *query_end = _find_first_of(path_end, end, "#");
+		if (query_end - path_end > 1)
+			_put_escaped(writer, path_end, query_end);
+	}
+}
+
+size_t br_url_canonicalize(const char *url, char *buffer, size_t buffer_size)
+{
+	url_writer writer = {buffer, buffer_size, 0, BROWSER_URL_KEY_FNV_OFFSET_BASIS};
+	if (url)
+		_canonicalize(url, &writer);
+
+	if (buffer_size > 0)
+		buffer[writer.length < buffer_size ? writer.length : buffer_size - 1] = '\0';
+
+	return writer.length;
+}
+
+sqlite3_int64 br_url_key(const char *url)
+{
+	url_writer writer = {NULL, 0, 0, BROWSER_URL_KEY_FNV_OFFSET_BASIS};
+	if (url)
+		_canonicalize(url, &writer);
+
+	return (sqlite3_int64)writer.hash;
+}
+
+static void __url_key_func(sqlite3_context *context, int argc, sqlite3_value **argv)
+{
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL) {
+		sqlite3_result_null(context);
+		return;
+	}
+
+	sqlite3_result_int64(context, br_url_key(reinterpret_cast<const char *>(sqlite3_value_text(argv[0]))));
+}
+
+int br_url_key_register_functions(sqlite3 *db_descriptor)
+{
+	return sqlite3_create_function(db_descriptor, "br_url_key", 1, SQLITE_UTF8, NULL,
+					__url_key_func, NULL, NULL);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BROWSER_URL_KEY_H
+#define BROWSER_URL_KEY_H
+
+#include "browser-config.h"
+
+extern "C" {
+#include "db-util.h"
+}
+
+#include <stddef.h>
+
+/* Writes the canonical form of url, which is the same for the addresses of one page:
+  * http and https are dropped, the host is lower cased and its default port removed,
+  * a trailing slash of the path, an empty query and the fragment are removed,
+  * and the hex digits of %-escapes are upper cased. An address without scheme is taken as http.
+  * e.g. "HTTPS://Example.com:443/a/?#top" -> "example.com/a"
+  * Returns the length of the canonical form, at most buffer_size - 1 of it is written
+  * with a terminating NUL. Nothing is allocated. */
+size_t br_url_canonicalize(const char *url, char *buffer, size_t buffer_size);
+
+/* 64 bit FNV-1a of the canonical form, computed in the same pass without a buffer.
+  * The addresses of one page have the same key, it is what the duplicate checks compare. */
+sqlite3_int64 br_url_key(const char *url);
+
+/* Registers br_url_key(address) for the queries and the migrations. */
+int br_url_key_register_functions(sqlite3 *db_descriptor);
+
+#endif	/* BROWSER_URL_KEY_H */
+
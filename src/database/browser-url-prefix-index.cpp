@@ -0,0 +1,134 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+using namespace std;
+
+#include "browser-url-prefix-index.h"
+#include "browser-frecency.h"
+
+#include <algorithm>
+#include <ctype.h>
+
+struct Browser_Url_Prefix_Index::url_entry_compare {
+	bool operator()(const url_entry &a, const url_entry &b) const
+	{
+		int result = a.key.compare(b.key);
+		if (result != 0)
+			return result < 0;
+		return a.url < b.url;
+	}
+};
+
+struct Browser_Url_Prefix_Index::frecency_compare {
+	frecency_compare(const std::vector<url_entry> &entries) : m_entries(entries) {}
+	bool operator()(int a, int b) const
+	{
+		return m_entries[a].frecency > m_entries[b].frecency;
+	}
+	const std::vector<url_entry> &m_entries;
+};
+
+Browser_Url_Prefix_Index::Browser_Url_Prefix_Index(void)
+:
+	m_is_loaded(EINA_FALSE)
+{
+}
+
+Browser_Url_Prefix_Index::~Browser_Url_Prefix_Index(void)
+{
+}
+
+std::string Browser_Url_Prefix_Index::get_key(const char *url)
+{
+	if (!url)
+		return std::string();
+
+	if (!strncasecmp(url, BROWSER_HTTP_SCHEME, strlen(BROWSER_HTTP_SCHEME)))
+		url += strlen(BROWSER_HTTP_SCHEME);
+	else if (!strncasecmp(url, BROWSER_HTTPS_SCHEME, strlen(BROWSER_HTTPS_SCHEME)))
+		url += strlen(BROWSER_HTTPS_SCHEME);
+
+	if (!strncasecmp(url, "www.", strlen("www.")))
+		url += strlen("www.");
+
+	std::string key(url);
+	for (int i = 0 ; i < key.length() ; i++)
+		key[i] = tolower(key[i]);
+
+	return key;
+}
+
+void Browser_Url_Prefix_Index::set_entries(std::vector<url_entry> &entries)
+{
+	m_entries.swap(entries);
+	std::sort(m_entries.begin(), m_entries.end(), url_entry_compare());
+	m_is_loaded = EINA_TRUE;
+}
+
+void Browser_Url_Prefix_Index::unload(void)
+{
+	m_entries.clear();
+	m_is_loaded = EINA_FALSE;
+}
+
+void Browser_Url_Prefix_Index::add_visit(const char *url, double frecency_weight)
+{
+	if (!m_is_loaded || !url || strlen(url) == 0)
+		return;
+
+	url_entry entry;
+	entry.key = get_key(url);
+	entry.url = std::string(url);
+	entry.frecency = br_frecency_add(BROWSER_FRECENCY_NONE, frecency_weight, br_frecency_now());
+
+	std::vector<url_entry>::iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(),
+								entry, url_entry_compare());
+	if (iter != m_entries.end() && iter->url == entry.url)
+		iter->frecency = br_frecency_add(iter->frecency, frecency_weight, br_frecency_now());
+	else
+		m_entries.insert(iter, entry);
+}
+
+void Browser_Url_Prefix_Index::get_matches(const char *prefix, int count, std::vector<std::string> &list)
+{
+	if (!m_is_loaded || count <= 0)
+		return;
+
+	url_entry entry;
+	entry.key = get_key(prefix);
+	if (entry.key.empty())
+		return;
+
+	/* All the keys starting with the prefix are next to each other from lower_bound on. */
+	std::vector<url_entry>::iterator iter = std::lower_bound(m_entries.begin(), m_entries.end(),
+								entry, url_entry_compare());
+	std::vector<int> matches;
+	for (; iter != m_entries.end() ; iter++) {
+		if (iter->key.compare(0, entry.key.length(), entry.key))
+			break;
+		matches.push_back(iter - m_entries.begin());
+	}
+
+	int match_count = matches.size() < count ? matches.size() : count;
+	std::partial_sort(matches.begin(), matches.begin() + match_count, matches.end(),
+				frecency_compare(m_entries));
+
+	for (int i = 0 ; i < match_count ; i++)
+		list.push_back(m_entries[matches[i]].url);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2012  Samsung Electronics Co., Ltd
+ *
+ * Licensed under the Flora License, Version 1.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.tizenopensource.org/license
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+
+#ifndef BROWSER_URL_PREFIX_INDEX_H
+#define BROWSER_URL_PREFIX_INDEX_H
+
+#include "browser-config.h"
+
+#include <string>
+#include <vector>
+
+/* Sorted in memory index of the history addresses for the url entry suggestions.
+  * The key of an address is its lower cased host and path without scheme and "www.",
+  * so "http://www.Tizen.org/" and "https://tizen.org/" are both found by "tiz". */
+class Browser_Url_Prefix_Index {
+public:
+	struct url_entry {
+		std::string key;
+		std::string url;
+		double frecency;
+	};
+
+	Browser_Url_Prefix_Index(void);
+	~Browser_Url_Prefix_Index(void);
+
+	static std::string get_key(const char *url);
+
+	/* Takes over the content of entries, the keys must be filled. */
+	void set_entries(std::vector<url_entry> &entries);
+	void unload(void);
+	Eina_Bool is_loaded(void) { return m_is_loaded; }
+
+	void add_visit(const char *url, double frecency_weight);
+	/* The count addresses of the highest frecency whose key starts with the key of prefix. */
+	void get_matches(const char *prefix, int count, std::vector<std::string> &list);
+private:
+	struct url_entry_compare;
+	struct frecency_compare;
+
+	std::vector<url_entry> m_entries;
+	Eina_Bool m_is_loaded;
+};
+
+#endif	/* BROWSER_URL_PREFIX_INDEX_H */
@@ -19,9 +19,9 @@ using namespace std;
 
 #include "browser-user-agent-db.h"
 
-sqlite3* Browser_User_Agent_DB::m_db_descriptor = NULL;
-
 Browser_User_Agent_DB::Browser_User_Agent_DB(void)
+:
+	m_db_connection(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -33,34 +33,15 @@ Browser_User_Agent_DB::~Browser_User_Agent_DB(void)
 
 Eina_Bool Browser_User_Agent_DB::_open_db(void)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	int error = db_util_open(BROWSER_USER_AGENT_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	m_db_connection = Browser_DB_Connection::get_connection(BROWSER_USER_AGENT_DB_PATH);
+	if (!m_db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
 	}
 
 	return EINA_TRUE;
 }
 
-Eina_Bool Browser_User_Agent_DB::_close_db(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_db_descriptor)
-	{
-		int error = db_util_close(m_db_descriptor);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGE("db_util_close error");
-			m_db_descriptor = NULL;
-			return EINA_FALSE;
-		}
-		m_db_descriptor = NULL;
-	}
-
-	return EINA_TRUE;
-}
-
 Eina_Bool Browser_User_Agent_DB::get_user_agent(const char *title, char *&user_agent)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -78,13 +59,12 @@ Eina_Bool Browser_User_Agent_DB::get_user_agent(const char *title, char *&user_a
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select value from user_agents where name=?",
-					-1, &sqlite3_stmt, NULL);
+	int error = m_db_connection->prepare_statement("select value from user_agents where name=?",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
@@ -97,7 +77,7 @@ Eina_Bool Browser_User_Agent_DB::get_user_agent(const char *title, char *&user_a
 	if (error == SQLITE_ROW)
 		value = reinterpret_cast<const char*>(sqlite3_column_text(sqlite3_stmt, 0));
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
 	if (!value.empty())
@@ -105,7 +85,6 @@ Eina_Bool Browser_User_Agent_DB::get_user_agent(const char *title, char *&user_a
 	else
 		user_agent = NULL;
 
-	_close_db();
 
 	return (error == SQLITE_DONE || error == SQLITE_ROW);
 }
@@ -20,6 +20,7 @@
 #define BROWSER_USER_AGENT_DB_H
 
 #include "browser-config.h"
+#include "browser-db-connection.h"
 
 extern "C" {
 #include "db-util.h"
@@ -37,9 +38,8 @@ public:
 	Eina_Bool get_user_agent(const char *title, char *&user_agent);
 private:
 	Eina_Bool _open_db(void);
-	Eina_Bool _close_db(void);
-
-	static sqlite3* m_db_descriptor;
+
+	Browser_DB_Connection *m_db_connection;
 };
 
 #endif	/* BROWSER_USER_AGENT_DB_H */
@@ -18,10 +18,13 @@
 using namespace std;
 
 #include "most-visited-sites-db.h"
-
-sqlite3* Most_Visited_Sites_DB::m_db_descriptor = NULL;
+#include "browser-bookmark-db.h"
+#include "browser-history-db.h"
+#include "browser-url-key.h"
 
 Most_Visited_Sites_DB::Most_Visited_Sites_DB(void)
+:
+	m_db_connection(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
 }
@@ -31,155 +34,81 @@ Most_Visited_Sites_DB::~Most_Visited_Sites_DB(void)
 	BROWSER_LOGD("[%s]", __func__);
 }
 
-Eina_Bool Most_Visited_Sites_DB::_open_db(void)
+Eina_Bool Most_Visited_Sites_DB::_open_db(const char *db_path)
 {
-	BROWSER_LOGD("[%s]", __func__);
-	int error = db_util_open(BROWSER_MOST_VISITED_SITES_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	m_db_connection = Browser_DB_Connection::get_connection(db_path);
+	if (!m_db_connection) {
+		BROWSER_LOGE("get_connection failed");
 		return EINA_FALSE;
 	}
 
 	return EINA_TRUE;
 }
 
-Eina_Bool Most_Visited_Sites_DB::_close_db(void)
-{
-	BROWSER_LOGD("[%s]", __func__);
-	if (m_db_descriptor)
-	{
-		int error = db_util_close(m_db_descriptor);
-		if (error != SQLITE_OK) {
-			BROWSER_LOGE("db_util_close error");
-			m_db_descriptor = NULL;
-			return EINA_FALSE;
-		}
-		m_db_descriptor = NULL;
-	}
-
-	return EINA_TRUE;
-}
-
 Eina_Bool Most_Visited_Sites_DB::is_in_bookmark(const char* url, int *bookmark_id)
 {
-	int error = db_util_open(BROWSER_BOOKMARK_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
-		return EINA_FALSE;
-	}
-
-	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "select id from bookmarks where address=?",
-									-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		return EINA_FALSE;
-	}
-
-	if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
-
-	error = sqlite3_step(sqlite3_stmt);
-
-	if (bookmark_id)
-		*bookmark_id = sqlite3_column_int(sqlite3_stmt, 0);
-
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	db_util_close(m_db_descriptor);
-
-	return (error == SQLITE_ROW);
+	return Browser_Bookmark_DB::is_in_bookmark(url, bookmark_id);
 }
 
 Eina_Bool Most_Visited_Sites_DB::delete_most_visited_sites_item(const char * url)
 {
-	int error = db_util_open(BROWSER_MOST_VISITED_SITES_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
-		BROWSER_LOGD("check here");
+	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
-	}
 
+	/* The table holds at most BROWSER_MOST_VISITED_SITES_ITEM_MAX rows, their keys are computed on the fly. */
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "delete from mostvisited where address=?",
-								-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("delete from mostvisited where br_url_key(address)=?",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return EINA_FALSE;
-	}
 
-	if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_int is failed.");
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, br_url_key(url)) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int64 is failed.");
 
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.");
 
-	db_util_close(m_db_descriptor);
-
 	return (error == SQLITE_OK || error == SQLITE_DONE);
 }
 
 Eina_Bool Most_Visited_Sites_DB::delete_most_visited_sites_item(int index)
 {
-	int error = db_util_open(BROWSER_MOST_VISITED_SITES_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
-		BROWSER_LOGD("check here");
+	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
-	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "delete from mostvisited where id=?",
-								-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("delete from mostvisited where id=?",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return EINA_FALSE;
-	}
 
 	if (sqlite3_bind_int(sqlite3_stmt, 1, index) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.");
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.");
-
-	db_util_close(m_db_descriptor);
 
 	return (error == SQLITE_OK || error == SQLITE_DONE);
 }
 
 Eina_Bool Most_Visited_Sites_DB::delete_most_visited_sites_history_item(int history_id)
 {
-	int error = db_util_open(BROWSER_HISTORY_DB_PATH, &m_db_descriptor,
-						DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		BROWSER_LOGE("db_util_open failed");
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	if (_open_db(BROWSER_HISTORY_DB_PATH) == EINA_FALSE)
 		return EINA_FALSE;
-	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "delete from history where id=?",
-							-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("delete from history where id=?",
+							&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return EINA_FALSE;
-	}
 
 	if (sqlite3_bind_int(sqlite3_stmt, 1, history_id) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	db_util_close(m_db_descriptor);
-
 	return (error == SQLITE_OK || error == SQLITE_DONE);
 }
 
@@ -200,80 +129,66 @@ Eina_Bool Most_Visited_Sites_DB::save_most_visited_sites_item(int index, const c
 		return EINA_FALSE;
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select * from mostvisited where id=?",
-								-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("select * from mostvisited where id=?",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return EINA_FALSE;
-	}
 	error = sqlite3_bind_int(sqlite3_stmt, 1, index);
 	if (error != SQLITE_OK) {
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-			db_util_close(m_db_descriptor);
-			return EINA_FALSE;
-		}
+		m_db_connection->release_statement(sqlite3_stmt);
+		return EINA_FALSE;
 	}
 
 	error = sqlite3_step(sqlite3_stmt);
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		return EINA_FALSE;
-	}
 	if (error == SQLITE_ROW) {  // already charged slot
-		error = sqlite3_prepare_v2(m_db_descriptor, "update mostvisited set address=?, title=?, image=? where id=?",
-											-1, &sqlite3_stmt, NULL);
-		if (error != SQLITE_OK) {
-			db_util_close(m_db_descriptor);
+		error = m_db_connection->prepare_statement("update mostvisited set address=?, title=?, image=? where id=?",
+											&sqlite3_stmt);
+		if (error != SQLITE_OK)
 			return EINA_FALSE;
-		}
 		if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL) != SQLITE_OK) {
-			db_util_close(m_db_descriptor);
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_text(sqlite3_stmt, 2, title, -1, NULL) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_text(sqlite3_stmt, 3, screen_shot, -1, NULL) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_text(sqlite3_stmt, 3, screen_shot, -1, NULL) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_int(sqlite3_stmt, 4, index) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_int(sqlite3_stmt, 4, index) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
 		error = sqlite3_step(sqlite3_stmt);
 	} else {
-		error = sqlite3_prepare_v2(m_db_descriptor, "insert into mostvisited (id, address, title, image) values(?,?,?,?)",
-									-1, &sqlite3_stmt, NULL);
-		if (error != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		error = m_db_connection->prepare_statement("insert into mostvisited (id, address, title, image) values(?,?,?,?)",
+									&sqlite3_stmt);
+		if (error != SQLITE_OK)
 			return EINA_FALSE;
-		}
-		if (sqlite3_bind_int(sqlite3_stmt, 1, index) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_int(sqlite3_stmt, 1, index) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_text(sqlite3_stmt, 2, url, -1, NULL) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_text(sqlite3_stmt, 2, url, -1, NULL) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_text(sqlite3_stmt, 3, title, -1, NULL) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_text(sqlite3_stmt, 3, title, -1, NULL) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
-		if (sqlite3_bind_text(sqlite3_stmt, 4, screen_shot, -1, NULL) != SQLITE_OK){
-			db_util_close(m_db_descriptor);
+		if (sqlite3_bind_text(sqlite3_stmt, 4, screen_shot, -1, NULL) != SQLITE_OK) {
+			m_db_connection->release_statement(sqlite3_stmt);
 			return EINA_FALSE;
 		}
 		error = sqlite3_step(sqlite3_stmt);
 	}
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		return EINA_FALSE;
-	}
-
-	db_util_close(m_db_descriptor);
 
 	return (error == SQLITE_DONE);
 }
@@ -281,21 +196,14 @@ Eina_Bool Most_Visited_Sites_DB::save_most_visited_sites_item(int index, const c
 std::string Most_Visited_Sites_DB::get_history_title_by_id(const char* id)
 {
 	std::string title;
-	int error = db_util_open(BROWSER_HISTORY_DB_PATH, &m_db_descriptor,
-						DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	if (_open_db(BROWSER_HISTORY_DB_PATH) == EINA_FALSE)
 		return title;
-	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "select title from history where id=?",
-								-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("select title from history where id=?",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return title;
-	}
 
 	if (sqlite3_bind_text(sqlite3_stmt, 1, id, -1, NULL) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
@@ -304,11 +212,9 @@ std::string Most_Visited_Sites_DB::get_history_title_by_id(const char* id)
 	if (error == SQLITE_ROW)
 		title = std::string(reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0)));
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	db_util_close(m_db_descriptor);
-
 	return title;
 }
 
@@ -317,49 +223,52 @@ std::string Most_Visited_Sites_DB::get_history_id_by_url(const char* url)
 	std::string history_id;
 	history_id.clear();
 
-	int error = db_util_open(BROWSER_HISTORY_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	if (!Browser_History_DB::flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db(BROWSER_HISTORY_DB_PATH) == EINA_FALSE)
 		return history_id;
-	}
 
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	error = sqlite3_prepare_v2(m_db_descriptor, "select id from history where address=?",
-								-1, &sqlite3_stmt, NULL);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
+	int error = m_db_connection->prepare_statement("select id from history where url_key=? order by id desc limit 1",
+								&sqlite3_stmt);
+	if (error != SQLITE_OK)
 		return history_id;
-	}
 
-	if (sqlite3_bind_text(sqlite3_stmt, 1, url, -1, NULL ) != SQLITE_OK)
-		BROWSER_LOGE("sqlite3_bind_text is failed.\n");
+	if (sqlite3_bind_int64(sqlite3_stmt, 1, br_url_key(url)) != SQLITE_OK)
+		BROWSER_LOGE("sqlite3_bind_int64 is failed.\n");
 
 	error = sqlite3_step(sqlite3_stmt);
 	if (error == SQLITE_ROW)
 		history_id = std::string(reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 0)));
 
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (m_db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	db_util_close(m_db_descriptor);
 	return history_id;
 }
 
 Eina_Bool Most_Visited_Sites_DB::get_most_visited_list(std::vector<most_visited_sites_entry> &list,
 							std::vector<most_visited_sites_entry> &duplicate_list, int count)
 {
-	int error = db_util_open(BROWSER_HISTORY_DB_PATH, &m_db_descriptor, DB_UTIL_REGISTER_HOOK_METHOD);
-	if (error != SQLITE_OK) {
-		db_util_close(m_db_descriptor);
-		m_db_descriptor = NULL;
+	if (!Browser_History_DB::flush_visits())
+		BROWSER_LOGE("flush_visits failed");
+
+	if (_open_db(BROWSER_HISTORY_DB_PATH) == EINA_FALSE)
 		return EINA_FALSE;
-	}
 
+	return _read_most_visited_list(m_db_connection, list, duplicate_list, count);
+}
+
+Eina_Bool Most_Visited_Sites_DB::_read_most_visited_list(Browser_DB_Connection *db_connection,
+						std::vector<most_visited_sites_entry> &list,
+						std::vector<most_visited_sites_entry> &duplicate_list, int count)
+{
 	sqlite3_stmt *sqlite3_stmt = NULL;
+	int error;
 	if (duplicate_list.size() == 0)
-		error = sqlite3_prepare_v2(m_db_descriptor, "select address, title, id from history order by counter desc limit ?",
-						-1, &sqlite3_stmt, NULL);
+		error = db_connection->prepare_statement("select address, title, id from history order by frecency desc limit ?",
+						&sqlite3_stmt);
 	else {
 		string query = "select address, title, id from history";
 		Eina_Bool is_attach_where = EINA_FALSE;
@@ -379,38 +288,31 @@ Eina_Bool Most_Visited_Sites_DB::get_most_visited_list(std::vector<most_visited_
 			query.append("id != ");
 			query.append(duplicate_list[i].id);
 		}
-		query.append(" order by counter desc limit ?");
-		error = sqlite3_prepare_v2(m_db_descriptor, query.c_str(), -1, &sqlite3_stmt, NULL);
+		query.append(" order by frecency desc limit ?");
+		error = db_connection->prepare_statement(query.c_str(), &sqlite3_stmt);
 	}
-	if (error != SQLITE_OK) {
-		_close_db();
+	if (error != SQLITE_OK)
 		return EINA_FALSE;
-	}
 	if (sqlite3_bind_int(sqlite3_stmt, 1, count) != SQLITE_OK)
 				BROWSER_LOGE("sqlite3_bind_int is failed.\n");
 
+	/* The pages of duplicate_list and the ones already listed are skipped by key. */
+	std::set<sqlite3_int64> url_keys;
+	for (int i = 0 ; i < duplicate_list.size() ; i++)
+		url_keys.insert(br_url_key(duplicate_list[i].url.c_str()));
+
 	most_visited_sites_entry item;
 	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
 		item.url = reinterpret_cast<const char *> (sqlite3_column_text(sqlite3_stmt, 0));
 		item.title = reinterpret_cast<const char *> (sqlite3_column_text(sqlite3_stmt, 1));
 		item.id = reinterpret_cast<const char *> (sqlite3_column_text(sqlite3_stmt, 2));
 
-		Eina_Bool is_duplicated = EINA_FALSE;
-		for (int i = 0 ; i < duplicate_list.size() ; i++) {
-			if (!strcmp(item.url.c_str(), duplicate_list[i].url.c_str())) {
-				is_duplicated = EINA_TRUE;
-				break;
-			}
-		}
-
-		if (!is_duplicated)
+		if (url_keys.insert(br_url_key(item.url.c_str())).second)
 			list.push_back(item);
 	}
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
 
-	_close_db();
-
 	return (error == SQLITE_DONE);
 }
 
@@ -419,44 +321,97 @@ Eina_Bool Most_Visited_Sites_DB::get_most_visited_sites_list(std::vector<most_vi
 	if (_open_db() == EINA_FALSE)
 		return EINA_FALSE;
 
+	return _read_most_visited_sites_list(m_db_connection, list);
+}
+
+class Most_Visited_Sites_DB::most_visited_sites_job : public Browser_DB_Job {
+public:
+	most_visited_sites_job(most_visited_sites_cb callback, void *user_data)
+		: m_callback(callback), m_user_data(user_data), m_result(EINA_FALSE) {}
+	void run(void)
+	{
+		Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+		Browser_DB_Connection *db_connection = executor->get_worker_connection(BROWSER_MOST_VISITED_SITES_DB_PATH);
+		if (!db_connection || !_read_most_visited_sites_list(db_connection, m_entry_list))
+			return;
+
+		/* The rest of the items are the most visited pages which are not pinned. */
+		db_connection = executor->get_worker_connection(BROWSER_HISTORY_DB_PATH);
+		if (db_connection)
+			m_result = _read_most_visited_list(db_connection, m_most_visited_list, m_entry_list,
+						BROWSER_MOST_VISITED_SITES_ITEM_MAX - m_entry_list.size());
+	}
+	void done(void)
+	{
+		m_callback(m_result, m_entry_list, m_most_visited_list, m_user_data);
+	}
+
+	most_visited_sites_cb m_callback;
+	void *m_user_data;
+	Eina_Bool m_result;
+	std::vector<most_visited_sites_entry> m_entry_list;
+	std::vector<most_visited_sites_entry> m_most_visited_list;
+};
+
+int Most_Visited_Sites_DB::get_most_visited_sites_async(most_visited_sites_cb callback, void *user_data, int priority)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	if (!callback)
+		return 0;
+
+	Browser_DB_Executor *executor = Browser_DB_Executor::get_instance();
+	if (!executor)
+		return 0;
+
+	/* The pending visits are posted first, so the read runs after them. */
+	Browser_History_DB::flush_visits_async();
+
+	most_visited_sites_job *job = new(nothrow) most_visited_sites_job(callback, user_data);
+	if (!job) {
+		BROWSER_LOGE("new most_visited_sites_job failed");
+		return 0;
+	}
+
+	int job_id = executor->post(job, priority);
+	if (!job_id)
+		delete job;
+
+	return job_id;
+}
+
+Eina_Bool Most_Visited_Sites_DB::_read_most_visited_sites_list(Browser_DB_Connection *db_connection,
+						std::vector<most_visited_sites_entry> &list)
+{
 	sqlite3_stmt *sqlite3_stmt = NULL;
-	int error = sqlite3_prepare_v2(m_db_descriptor, "select id, address, title, image from mostvisited order by id asc",
-					-1, &sqlite3_stmt, NULL);
+	int error = db_connection->prepare_statement("select id, address, title, image from mostvisited order by id asc",
+					&sqlite3_stmt);
 	if (error != SQLITE_OK) {
 		BROWSER_LOGD("SQL error=%d", error);
-		if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+		if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 			BROWSER_LOGE("sqlite3_finalize is failed.\n");
-		_close_db();
 		return EINA_FALSE;
 	}
 
 	most_visited_sites_entry item;
 	int count = 0;
+	std::set<sqlite3_int64> url_keys;
+	for (int i = 0 ; i < list.size() ; i++)
+		url_keys.insert(br_url_key(list[i].url.c_str()));
 	while ((error = sqlite3_step(sqlite3_stmt)) == SQLITE_ROW) {
 		item.index = sqlite3_column_int(sqlite3_stmt, 0);
 		item.url = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 1));
 		item.title = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt, 2));
 		item.id = reinterpret_cast<const char *>(sqlite3_column_text(sqlite3_stmt,3));
 
-		Eina_Bool is_duplicated = EINA_FALSE;
-		for (int i = 0 ; i < list.size() ; i++) {
-			if (!strcmp(item.url.c_str(), list[i].url.c_str())) {
-				is_duplicated = EINA_TRUE;
-				break;
-			}
-		}
-
-		if (!is_duplicated) {
+		if (url_keys.insert(br_url_key(item.url.c_str())).second) {
 			list.push_back(item);
 			count++;
 			if (count >= BROWSER_MOST_VISITED_SITES_ITEM_MAX)
 				break;
 		}
 	}
-	if (sqlite3_finalize(sqlite3_stmt) != SQLITE_OK)
+	if (db_connection->release_statement(sqlite3_stmt) != SQLITE_OK)
 		BROWSER_LOGE("sqlite3_finalize is failed.\n");
-
-	_close_db();
 
 	return (error == SQLITE_DONE || error == SQLITE_ROW);
 }
@@ -19,12 +19,15 @@
 #define BROWSER_MOST_VISITED_SITES_DB_H
 
 #include "browser-config.h"
+#include "browser-db-connection.h"
+#include "browser-db-executor.h"
 
 extern "C" {
 #include "db-util.h"
 }
 
 #include <iostream>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -37,12 +40,20 @@ public:
 		std::string id;
 	};
 
+	/* entry_list is the pinned items, most_visited_list the pages of history which fill the rest. */
+	typedef void (*most_visited_sites_cb)(Eina_Bool result, std::vector<most_visited_sites_entry> &entry_list,
+					std::vector<most_visited_sites_entry> &most_visited_list, void *user_data);
+
 	Most_Visited_Sites_DB(void);
 	~Most_Visited_Sites_DB(void);
 
 	Eina_Bool get_most_visited_sites_list(std::vector<most_visited_sites_entry> &list);
 	Eina_Bool get_most_visited_list(std::vector<most_visited_sites_entry> &list,
 				std::vector<most_visited_sites_entry> &duplicate_list, int count);
+	/* Both of the lists above, read on the executor after the pending visits.
+	  * Returns the job id for Browser_DB_Executor::cancel(), or 0 on failure. */
+	int get_most_visited_sites_async(most_visited_sites_cb callback, void *user_data,
+					int priority = BROWSER_DB_JOB_PRIORITY_NORMAL);
 	Eina_Bool save_most_visited_sites_item(int index, const char *url,
 						const char *title, const char *screen_shot);
 	Eina_Bool delete_most_visited_sites_item(int index);
@@ -52,10 +63,16 @@ public:
 	std::string get_history_title_by_id(const char* id);
 	Eina_Bool is_in_bookmark(const char* url, int *bookmark_id);
 private:
-	Eina_Bool _open_db(void);
-	Eina_Bool _close_db(void);
+	class most_visited_sites_job;
+
+	static Eina_Bool _read_most_visited_sites_list(Browser_DB_Connection *db_connection,
+					std::vector<most_visited_sites_entry> &list);
+	static Eina_Bool _read_most_visited_list(Browser_DB_Connection *db_connection,
+					std::vector<most_visited_sites_entry> &list,
+					std::vector<most_visited_sites_entry> &duplicate_list, int count);
+	Eina_Bool _open_db(const char *db_path = BROWSER_MOST_VISITED_SITES_DB_PATH);
 
-	static sqlite3* m_db_descriptor;
+	Browser_DB_Connection *m_db_connection;
 };
 
 #endif	/* BROWSER_SPEED_DIAL_DB_H */
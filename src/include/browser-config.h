@@ -145,12 +145,35 @@
 #define BROWSER_MAX_TITLE_LEN	1024
 #define BROWSER_MAX_URL_LEN	2048
 #define BROWSER_BOOKMARK_PROCESS_BLOCK_COUNT	100
+/* Bookmark files are read and written in blocks of these sizes. */
+#define BROWSER_BOOKMARK_HTML_CHUNK_SIZE	(16 * 1024)
+#define BROWSER_BOOKMARK_HTML_BUFFER_SIZE	(64 * 1024)
+/* The bookmark file imported and exported from the settings. */
+#define BROWSER_BOOKMARK_HTML_FILE_PATH	"/opt/media/Downloads/bookmarks.html"
 
 /* history definition */
 #define BROWSER_HISTORY_DB_PATH	"/opt/dbspace/.browser-history.db"
 #define BROWSER_HISTORY_COUNT_LIMIT	1000
+#define BROWSER_HISTORY_ARCHIVE_COUNT_LIMIT	100000
+#define BROWSER_HISTORY_ARCHIVE_MAX_AGE_DAYS	365
+/* The archived addresses of the highest frecency which are suggested in the url entry. */
+#define BROWSER_HISTORY_ARCHIVE_PREFIX_COUNT	5000
 #define BROWSER_MAX_DATE_LEN	40
+/* Holds about 25 date labels of the history genlists. */
+#define BROWSER_DATE_LABEL_BLOCK_SIZE	1024
 #define BROWSER_PREDICTIVE_HISTORY_COUNT	2
+#define BROWSER_HISTORY_FLUSH_TIMEOUT	3.0 // sec
+#define BROWSER_HISTORY_SEARCH_RESULT_MAX	100
+#define BROWSER_HISTORY_PAGE_SIZE	30
+#define BROWSER_FRECENCY_HALF_LIFE_DAYS	30.0
+#define BROWSER_FRECENCY_TYPED_BONUS	1.0
+#define BROWSER_FRECENCY_BOOKMARKED_BONUS	1.0
+
+/* favicon definition */
+/* The icons stored in the history and bookmark files fit in this many pixels, 4 KB at most. */
+#define BROWSER_FAVICON_SIZE	32
+/* get_favicons() reads this many ids per statement. */
+#define BROWSER_FAVICON_BATCH_SIZE	32
 
 /* multi window definition */
 #define BROWSER_MULTI_WINDOW_MAX_COUNT	9
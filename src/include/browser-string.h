@@ -135,6 +135,8 @@
 #define BR_STRING_CLEAR_ALL_CACHE_DATA_Q      _("Clear all cache data?")//stms, new text
 #define BR_STRING_CLEAR_HISTORY         _("IDS_BR_BODY_CLEAR_HISTORY")
 #define BR_STRING_CLEAR_ALL_HISTORY_DATA_Q  _("Clear all history?")//stms, new text
+#define BR_STRING_LAST_HOUR             _("Last hour")//stms, new text
+#define BR_STRING_TODAY                 _("Today")//stms, new text
 #define BR_STRING_SHOW_SECURITY_WARNINGS        _("IDS_BR_BODY_SHOW_SECURITY_WARNINGS")
 #define BR_STRING_COOKIES               _("IDS_BR_BODY_COOKIES")
 #define BR_STRING_ACCEPT_COOKIES        _("IDS_BR_BODY_ACCEPT_COOKIES")
@@ -159,6 +161,8 @@
 #define BR_STRING_WEBSITE_SETTINGS      _("IDS_BR_BODY_WEBSITE_SETTINGS")//stms, new text
 #define BR_STRING_RESET_TO_DEFAULT      _("IDS_BR_BODY_RESET_TO_DEFAULT")
 #define BR_STRING_RESET_TO_DEFAULT_Q    _("Reset all settings to default?")//stms, new text
+#define BR_STRING_IMPORT_BOOKMARKS      _("Import bookmarks")//stms, new text
+#define BR_STRING_EXPORT_BOOKMARKS      _("Export bookmarks")//stms, new text
 #define BR_STRING_RESET_ALL_SETTINGS_TO_DEFAULT_Q	_("IDS_BR_POP_ALL_SETTINGS_TO_DEFAULT_CONTINUE_Q")
 #define BR_STRING_USER_AGENT            _("IDS_BR_HEADER_USER_AGENT")
 
@@ -17,6 +17,7 @@
 
 #include "add-to-most-visited-sites-view.h"
 #include "browser-data-manager.h"
+#include "browser-url-key.h"
 
 Add_To_Most_Visited_Sites_View::Add_To_Most_Visited_Sites_View(Most_Visited_Sites *most_visited_sites)
 :	m_conformant(NULL)
@@ -38,12 +39,6 @@ Add_To_Most_Visited_Sites_View::~Add_To_Most_Visited_Sites_View(void)
 		if (m_history_list[i])
 			delete m_history_list[i];
 	}
-
-	for(int i = 0 ; i < m_history_date_label_list.size() ; i++ ) {
-		if (m_history_date_label_list[i])
-			delete m_history_date_label_list[i];
-	}
-	m_history_date_label_list.clear();
 }
 
 Eina_Bool Add_To_Most_Visited_Sites_View::init(void)
@@ -106,38 +101,9 @@ char *Add_To_Most_Visited_Sites_View::__genlist_date_label_get_cb(void *data, Ev
 	if (!data)
 		return NULL;
 
-	char *date_label = (char *)data;
-	if (!strncmp(part, "elm.text", strlen("elm.text"))) {
-		Date date;
-		char buffer[BROWSER_MAX_DATE_LEN] = {0, };
-
-		sscanf(date_label, "%d-%d-%d",
-			&date.year, &date.month, &date.day);
-		BROWSER_LOGD("%d %d %d\n", date.day, date.month, date.year);
-		time_t raw_time;
-		struct tm *time_info;
-		time(&raw_time);
-		time_info = localtime(&raw_time);
-		int day_gap = -1;
-		BROWSER_LOGD("\ncurrent time : %d %d %d\n", time_info->tm_mday, (time_info->tm_mon+1),
-									(time_info->tm_year+1900));
-		if (time_info->tm_year == date.year -1900 && time_info->tm_mon == date.month - 1)
-			day_gap = time_info->tm_mday - date.day;
-		else {
-			time_info->tm_year = date.year - 1900;
-			time_info->tm_mon = date.month - 1;
-		}
-		time_info->tm_mday = date.day;
-		mktime(time_info);
-
-		if (day_gap == 0)
-			strftime(buffer, BROWSER_MAX_DATE_LEN, "Today - %a, %b %d, %Y", time_info);
-		else if (day_gap == 1)
-			strftime(buffer, 40, "Yesterday - %a, %b %d, %Y", time_info);
-		else
-			strftime(buffer, 40, "%a, %b %d, %Y", time_info);
-		return strdup(buffer);
-	}
+	if (!strncmp(part, "elm.text", strlen("elm.text")))
+		return strdup((const char *)data);
+
 	return NULL;
 }
 
@@ -198,33 +164,31 @@ Evas_Object *Add_To_Most_Visited_Sites_View::_create_history_genlist(void)
 	m_history_group_title_class.func.del = NULL;
 
 	m_history_list.clear();
-	m_history_date_label_list.clear();
+	m_date_labels.clear();
 
-	Eina_Bool ret = m_data_manager->get_history_db()->get_history_list(m_history_list);
+	std::vector<Browser_History_DB::history_day_group> groups;
+	Eina_Bool ret = m_data_manager->get_history_db()->get_history_list(m_history_list, &groups);
 	if (!ret) {
 		BROWSER_LOGE("get_history_list failed");
 		return NULL;
 	}
 
-	unsigned int history_count = m_history_list.size();
-
-	Date date;
-	Elm_Object_Item *it = NULL;
-	for(int i = 0 ; i < history_count; i++) {
-		sscanf(m_history_list[i]->date.c_str(), "%d-%d-%d", &date.year, &date.month, &date.day);
-		m_history_list[i]->user_data = (void *)this;
-		if (m_last_date != date) {
-			m_last_date = date;
-			char *labe_item = strdup(m_history_list[i]->date.c_str());
-			m_history_date_label_list.push_back(labe_item);
+	for(int i = 0 ; i < groups.size() ; i++) {
+		const char *label = m_date_labels.add(groups[i].day, "Today - %a, %b %d, %Y",
+							"Yesterday - %a, %b %d, %Y", "%a, %b %d, %Y");
+		Elm_Object_Item *it = NULL;
+		if (label) {
 			it = elm_genlist_item_append(genlist, &m_history_group_title_class,
-						labe_item, NULL, ELM_GENLIST_ITEM_GROUP, NULL, NULL);
-
+						label, NULL, ELM_GENLIST_ITEM_GROUP, NULL, NULL);
 			elm_genlist_item_select_mode_set(it, ELM_OBJECT_SELECT_MODE_DISPLAY_ONLY);
 		}
-		elm_genlist_item_append(genlist, &m_history_genlist_item_class,
-					m_history_list[i], it, ELM_GENLIST_ITEM_NONE,
-					__history_item_clicked_cb, this);
+
+		for(int j = groups[i].first_index ; j < groups[i].first_index + groups[i].count ; j++) {
+			m_history_list[j]->user_data = (void *)this;
+			elm_genlist_item_append(genlist, &m_history_genlist_item_class,
+						m_history_list[j], it, ELM_GENLIST_ITEM_NONE,
+						__history_item_clicked_cb, this);
+		}
 	}
 
 	return genlist;
@@ -266,7 +230,7 @@ Eina_Bool Add_To_Most_Visited_Sites_View::_save_button_clicked(void)
 		full_url = std::string(BROWSER_HTTP_SCHEME) + std::string(url);
 
 	if (m_most_visited_sites->m_selected_item->url && strlen(m_most_visited_sites->m_selected_item->url)) {
-		if (!strcmp(full_url.c_str(), m_most_visited_sites->m_selected_item->url)) {
+		if (br_url_key(full_url.c_str()) == br_url_key(m_most_visited_sites->m_selected_item->url)) {
 			/* If the url is not changed in case of modify speed dial item. */
 			if (elm_naviframe_bottom_item_get(m_navi_bar)
 			    != elm_naviframe_top_item_get(m_navi_bar))
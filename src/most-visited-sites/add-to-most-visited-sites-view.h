@@ -57,9 +57,8 @@ private:
 	Evas_Object *m_history_genlist;
 	Evas_Object *m_cancel_button;
 	Evas_Object *m_save_button;
-	vector<char *> m_history_date_label_list;
+	Date_Label_Arena m_date_labels;
 	vector<Browser_History_DB::history_item *> m_history_list;
-	Date m_last_date;
 
 	Elm_Genlist_Item_Class m_history_genlist_item_class;
 	Elm_Genlist_Item_Class m_history_group_title_class;
@@ -20,6 +20,7 @@
 #include "browser-data-manager.h"
 #include "most-visited-sites.h"
 #include "most-visited-sites-db.h"
+#include "browser-url-key.h"
 #include "browser-view.h"
 #include "browser-common-view.h"
 
@@ -46,6 +47,7 @@ Most_Visited_Sites::Most_Visited_Sites(Evas_Object *navi_bar, Browser_View *brow
 	,m_edit_mode(EINA_FALSE)
 	,m_done_button(NULL)
 	,m_is_item_clicked(EINA_FALSE)
+	,m_reload_job_id(0)
 //	,m_gengrid_item_class(NULL)
 {
 	BROWSER_LOGD("[%s]", __func__);
@@ -55,6 +57,9 @@ Most_Visited_Sites::Most_Visited_Sites(Evas_Object *navi_bar, Browser_View *brow
 Most_Visited_Sites::~Most_Visited_Sites(void)
 {
 	BROWSER_LOGD("[%s]", __func__);
+	if (m_reload_job_id && Browser_DB_Executor::has_instance())
+		Browser_DB_Executor::get_instance()->cancel(m_reload_job_id);
+
 	if (m_main_layout)
 		evas_object_del(m_main_layout);
 
@@ -110,8 +115,7 @@ Evas_Object *Most_Visited_Sites::__get_most_visited_sites_item_layout(most_visit
 				do {
 					most_visited_sites_item* p_item = (most_visited_sites_item*)elm_object_item_data_get(it);
 					if (p_item && p_item->tack) {
-						if (p_item->url && item->url && (strlen(p_item->url) == strlen(item->url))
-						    && !strncmp(p_item->url, item->url, strlen(p_item->url))) {
+						if (p_item->url && item->url && br_url_key(p_item->url) == br_url_key(item->url)) {
 							if (p_item->history_id) {
 								screen_shot_file_path.clear();
 								screen_shot_file_path = std::string(BROWSER_SCREEN_SHOT_DIR)
@@ -196,8 +200,9 @@ void Most_Visited_Sites::__bookmark_button_clicked_cb(void *data, Evas_Object *o
 		most_visited_sites->m_browser_view->show_notify_popup(BR_STRING_REMOVED_TO_BOOKMARKS, 3, EINA_TRUE);
 	} else {
 		edje_object_signal_emit(elm_layout_edje_get(item->layout), "bookmark_icon,on,signal", "");
-		if (item->title && item->url)
-			bookmark_db->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID, item->title, item->url);
+		if (item->title && item->url
+		    && bookmark_db->save_bookmark(BROWSER_BOOKMARK_MAIN_FOLDER_ID, item->title, item->url))
+			most_visited_sites->m_browser_view->save_bookmark_favicon(item->url);
 		most_visited_sites->m_browser_view->show_notify_popup(BR_STRING_ADDED_TO_BOOKMARKS, 3, EINA_TRUE);
 	}
 
@@ -536,8 +541,7 @@ Eina_Bool Most_Visited_Sites::_delete_selected_item(void)
 		do {
 			most_visited_sites_item* p_item = (most_visited_sites_item *)elm_object_item_data_get(it);
 			if (p_item->tack) {    // only search in tacked items. (mysites items)
-				if (m_selected_item->url && p_item->url && (strlen(m_selected_item->url) == strlen(p_item->url))
-				    && !strcmp(m_selected_item->url, p_item->url)) {
+				if (m_selected_item->url && p_item->url && br_url_key(m_selected_item->url) == br_url_key(p_item->url)) {
 					is_ranked = EINA_FALSE;
 					break;
 				}
@@ -763,6 +767,14 @@ Eina_Bool Most_Visited_Sites::_reload_items(void)
 	}
 	m_item_list.clear();
 
+	/* Read on the DB executor, the items are appended by __items_loaded_cb. */
+	if (m_reload_job_id)
+		Browser_DB_Executor::get_instance()->cancel(m_reload_job_id);
+	m_reload_job_id = m_most_visited_sites_db->get_most_visited_sites_async(__items_loaded_cb, this);
+	if (m_reload_job_id)
+		return EINA_TRUE;
+
+	BROWSER_LOGE("get_most_visited_sites_async failed, read the items here");
 	if (!m_most_visited_sites_db->get_most_visited_sites_list(m_entry_list)) {
 		BROWSER_LOGE("get_most_visited_sites_list failed");
 		return EINA_FALSE;
@@ -775,6 +787,30 @@ Eina_Bool Most_Visited_Sites::_reload_items(void)
 		return EINA_FALSE;
 	}
 
+	return _append_items();
+}
+
+void Most_Visited_Sites::__items_loaded_cb(Eina_Bool result,
+				std::vector<Most_Visited_Sites_DB::most_visited_sites_entry> &entry_list,
+				std::vector<Most_Visited_Sites_DB::most_visited_sites_entry> &most_visited_list,
+				void *user_data)
+{
+	BROWSER_LOGD("[%s]", __func__);
+	Most_Visited_Sites *most_visited_sites = (Most_Visited_Sites *)user_data;
+	most_visited_sites->m_reload_job_id = 0;
+	if (!result) {
+		BROWSER_LOGE("get_most_visited_sites_async failed");
+		return;
+	}
+
+	most_visited_sites->m_entry_list.swap(entry_list);
+	most_visited_sites->m_most_visited_list.swap(most_visited_list);
+	if (!most_visited_sites->_append_items())
+		BROWSER_LOGE("_append_items failed");
+}
+
+Eina_Bool Most_Visited_Sites::_append_items(void)
+{
 	std::vector<Most_Visited_Sites_DB::most_visited_sites_entry>::iterator most_visited_sites_iterator;
 	std::vector<Most_Visited_Sites_DB::most_visited_sites_entry>::iterator most_visited_iterator;
 
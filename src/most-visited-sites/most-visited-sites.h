@@ -94,11 +94,18 @@ private:
 	static Eina_Bool __gengrid_icon_get_idler_cb(void *data);
 	static Eina_Bool __load_url_idler_cb(void *data);
 
+	/* DB executor callback functions */
+	static void __items_loaded_cb(Eina_Bool result,
+				std::vector<Most_Visited_Sites_DB::most_visited_sites_entry> &entry_list,
+				std::vector<Most_Visited_Sites_DB::most_visited_sites_entry> &most_visited_list,
+				void *user_data);
+
 	Evas_Object *__get_most_visited_sites_item_layout(most_visited_sites_item *item);
 	Eina_Bool _show_item_context_popup(void);
 	Eina_Bool _delete_selected_item(void);
 	Eina_Bool _empty_item_clicked(most_visited_sites_item *item);
 	Eina_Bool _reload_items(void);
+	Eina_Bool _append_items(void);
 	Eina_Bool _item_moved(void);
 	void _set_edit_mode(Eina_Bool edit_mode);
 
@@ -128,6 +135,8 @@ private:
 	Eina_Bool m_edit_mode;
 
 	Eina_Bool m_is_item_clicked;
+	/* The items being read on the DB executor, 0 if none. */
+	int m_reload_job_id;
 };
 
 #endif /* BROWSER_SPEED_DIAL_H */